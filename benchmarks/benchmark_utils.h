@@ -0,0 +1,46 @@
+#ifndef STOCHASTIC_MODELS_BENCHMARKS_BENCHMARK_UTILS_H
+#define STOCHASTIC_MODELS_BENCHMARKS_BENCHMARK_UTILS_H
+#include <chrono>
+
+/**
+ * @file
+ * @brief Timing helpers shared by the benchmark executables.
+ */
+
+/**
+ * @brief Prevents the compiler from discarding benchmarked results.
+ *
+ */
+inline volatile double sink = 0.0;
+
+/**
+ * @brief Times fn over repeats and returns the mean seconds per call.
+ *
+ * @param repeats Number of times fn is called.
+ * @param fn Callable returning the benchmarked value.
+ * @return double Mean seconds per call.
+ */
+template <typename Fn>
+double secondsPerCall(const unsigned int repeats, Fn&& fn) {
+  const auto start = std::chrono::steady_clock::now();
+  for (unsigned int i{0}; i < repeats; ++i) {
+    sink = sink + fn();
+  }
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / repeats;
+}
+
+/**
+ * @brief Ornstein-Uhlenbeck parameters of one benchmarked regime; benchmarks
+ * needing more inputs per regime derive from it.
+ *
+ */
+struct Regime {
+  const char* name;
+  double mu;
+  double alpha;
+  double sigma;
+};
+
+#endif
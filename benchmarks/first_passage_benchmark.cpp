@@ -0,0 +1,72 @@
+#include "benchmark_utils.h"
+#include "stochastic_models/entrypoints/ou_model.h"
+#include "stochastic_models/hitting_times/first_passage_monte_carlo.h"
+#include "stochastic_models/sde/ornstein_uhlenbeck.h"
+
+#include <cstddef>
+#include <iostream>
+/**
+ * @file
+ * @brief Compares the time and result of the quadrature hitting probability
+ * with the Monte Carlo first-passage estimator across parameter regimes.
+ */
+
+/**
+ * @brief Parameters of one benchmarked regime beyond the model's.
+ *
+ */
+struct PassageRegime : Regime {
+  double x;
+  double first;
+  double second;
+  double dt;
+};
+
+int main() {
+  const PassageRegime regimes[] = {
+      {"fast reversion, narrow band", 0.0, 2.0, 1.0, 0.2, 0.6, -0.3, 1e-3},
+      {"slow reversion, wide band", 0.0, 0.1, 0.2, 0.0, 1.0, -0.5, 1e-2},
+      {"daily spread", 0.998, 0.0045, 0.0038, 1.02, 1.04, 1.0, 1.0},
+  };
+  const std::size_t n_paths = 20000;
+
+  for (const PassageRegime& regime : regimes) {
+    double quadrature{0.0};
+    const double quadrature_seconds = secondsPerCall(100, [&]() {
+      quadrature = hittingTimeDensityOrnsteinUhlenbeck(
+          regime.x,
+          regime.mu,
+          regime.alpha,
+          regime.sigma,
+          regime.first,
+          regime.second
+      );
+      return quadrature;
+    });
+
+    const OrnsteinUhlenbeckModel model(regime.mu, regime.alpha, regime.sigma);
+    FirstPassageOptions options;
+    options.dt = regime.dt;
+    options.horizon = 1e6 * regime.dt;
+    FirstPassageEstimate estimate{};
+    const double monte_carlo_seconds = secondsPerCall(3, [&]() {
+      estimate = estimateFirstPassage(
+          model,
+          regime.x,
+          regime.first,
+          regime.second,
+          n_paths,
+          1,
+          options
+      );
+      return estimate.probability;
+    });
+
+    std::cout << regime.name << "\n  quadrature:  " << quadrature << " in "
+              << quadrature_seconds * 1e6 << " us\n  monte carlo: "
+              << estimate.probability << " +/- " << estimate.standard_error
+              << " (expected exit time " << estimate.expected_time << ") in "
+              << monte_carlo_seconds * 1e6 << " us" << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,76 @@
+#include "benchmark_utils.h"
+#include "stochastic_models/distributions/gaussian.h"
+#include "stochastic_models/distributions/random.h"
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+/**
+ * @file
+ * @brief Compares normal draws per second of the previous per-call
+ * std::normal_distribution sampler with the Philox scalar and bulk samplers.
+ */
+
+/**
+ * @brief Times fn over repeats and prints the throughput in draws per second.
+ *
+ * @param name Label printed with the result.
+ * @param draws Number of draws produced by one call of fn.
+ * @param repeats Number of times fn is called.
+ * @param fn Callable producing draws.
+ */
+template <typename Fn>
+void report(
+    const char* name,
+    const std::size_t draws,
+    const unsigned int repeats,
+    Fn&& fn
+) {
+  const auto start = std::chrono::steady_clock::now();
+  for (unsigned int i{0}; i < repeats; ++i) {
+    fn();
+  }
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  const double rate = static_cast<double>(draws) * repeats / elapsed.count();
+  std::cout << name << ": " << rate / 1e6 << " million draws/sec" << std::endl;
+}
+
+int main() {
+  const std::size_t size = 1 << 20;
+  const unsigned int repeats = 20;
+  std::vector<double> buffer(size);
+
+  // The sampler used before the Philox engine: a fresh engine per call and
+  // one push_back per draw.
+  report("std::normal_distribution (per-call engine)", size, repeats, [&]() {
+    std::normal_distribution<> norm(0.0, 1.0);
+    std::mt19937 norm_gen(std::random_device{}());
+    std::vector<double> sample{};
+    for (std::size_t i{0}; i < size; i++) {
+      sample.push_back(norm(norm_gen));
+    }
+    sink = sink + sample.back();
+  });
+
+  PhiloxEngine scalar_engine(1);
+  report("PhiloxEngine::normal (scalar)", size, repeats, [&]() {
+    for (double& value : buffer) {
+      value = scalar_engine.normal();
+    }
+    sink = sink + buffer.back();
+  });
+
+  const GaussianDistribution distribution(0.0, 1.0, 1);
+  report("GaussianDistribution::sample", size, repeats, [&]() {
+    const std::vector<double> sample = distribution.sample(size);
+    sink = sink + sample.back();
+  });
+  report("GaussianDistribution::fill", size, repeats, [&]() {
+    distribution.fill(buffer);
+    sink = sink + buffer.back();
+  });
+  return 0;
+}
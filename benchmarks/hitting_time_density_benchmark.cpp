@@ -0,0 +1,70 @@
+#include "benchmark_utils.h"
+#include "stochastic_models/hitting_times/hitting_time_density.h"
+#include "stochastic_models/hitting_times/hitting_time_ornstein_uhlenbeck.h"
+
+#include <cmath>
+#include <exception>
+#include <iostream>
+/**
+ * @file
+ * @brief Compares the time and result of the closed-form hitting-time density
+ * with its quadrature across parameter regimes, including one where the
+ * integrand of the quadrature overflows.
+ */
+
+/**
+ * @brief Parameters of one benchmarked regime beyond the model's.
+ *
+ */
+struct BandRegime : Regime {
+  double x;
+  double first;
+  double second;
+};
+
+int main() {
+  const BandRegime regimes[] = {
+      {"fast reversion, narrow band", 0.0, 2.0, 1.0, 0.2, 0.6, -0.3},
+      {"slow reversion, wide band", 0.0, 0.1, 0.2, 0.0, 1.0, -0.5},
+      {"daily spread", 0.998, 0.0045, 0.0038, 1.02, 1.04, 1.0},
+      {"large alpha / sigma^2", 0.0, 50.0, 0.01, 0.0999, 0.1, 0.05},
+  };
+
+  for (const BandRegime& regime : regimes) {
+    const HittingTimeOrnsteinUhlenbeck kernel(
+        regime.mu, regime.alpha, regime.sigma
+    );
+    double closed_form{0.0};
+    const double closed_form_seconds = secondsPerCall(100000, [&]() {
+      closed_form = hittingTimeDensityClosedForm(
+          regime.x, kernel, regime.first, regime.second
+      );
+      return closed_form;
+    });
+
+    std::cout << regime.name << "\n  closed form: " << closed_form << " in "
+              << closed_form_seconds * 1e9 << " ns" << std::endl;
+
+    try {
+      double quadrature{0.0};
+      const double quadrature_seconds = secondsPerCall(1000, [&]() {
+        double x = regime.x;
+        double first = regime.first;
+        double second = regime.second;
+        quadrature = hittingTimeDensity(
+            x,
+            integrateHittingTimeDensity,
+            const_cast<HittingTimeOrnsteinUhlenbeck*>(&kernel),
+            first,
+            second
+        );
+        return quadrature;
+      });
+      std::cout << "  quadrature:  " << quadrature << " in "
+                << quadrature_seconds * 1e9 << " ns" << std::endl;
+    } catch (const std::exception& exc) {
+      std::cout << "  quadrature:  failed (" << exc.what() << ")" << std::endl;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,78 @@
+#include "benchmark_utils.h"
+#include "stochastic_models/hitting_times/hitting_time_ornstein_uhlenbeck.h"
+#include "stochastic_models/numeric_utils/integration_batch.h"
+#include "stochastic_models/trading/optimal_mean_reversion.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+/**
+ * @file
+ * @brief Compares evaluating the optimal trading transform F(x;r) over a grid
+ * of x one point at a time with evaluating the whole grid with
+ * integrateBatch.
+ */
+
+int main() {
+  const double mu = 0.5388;
+  const double alpha = 16.6677;
+  const double sigma = 0.1599;
+  const double r = 0.05;
+  const double c = 0.05;
+  const HittingTimeOrnsteinUhlenbeck kernel(mu, alpha, sigma);
+  const double deviation = sigma / std::sqrt(2 * alpha);
+  const std::size_t points = 4096;
+
+  std::vector<double> xs(points), drifts(points);
+  for (std::size_t i{0}; i < points; ++i) {
+    xs[i] = mu - 4 * deviation + 8 * deviation * i / (points - 1.0);
+    drifts[i] = kernel.optimalTradingDrift(xs[i]);
+  }
+
+  // One fixed-order quadrature per point, without the memo cache.
+  OptimalMeanReversion optimizer(TransformQuadrature::FixedOrder);
+  optimizer.setTransformCache(nullptr);
+  std::vector<double> expected(points);
+  const double pointwise_seconds = secondsPerCall(10, [&]() {
+    for (std::size_t i{0}; i < points; ++i) {
+      expected[i] = optimizer.F(&kernel, xs[i], r, c);
+    }
+    return expected.back();
+  });
+
+  // F(x;r) is the transform of u^(nu - 1) exp(drift u - u^2 / 2), so every
+  // point shares a Gauss-Jacobi rule truncated past the peak of the largest
+  // drift. The rule has the 48 nodes of the pointwise fixed-order rule.
+  const double nu = kernel.optimalTradingExponent(r);
+  const double largest = drifts.back();
+  const double upper =
+      0.5 * (largest + std::sqrt(largest * largest + 4 * nu)) + std::sqrt(80.0);
+  const GaussJacobiRule rule(48, nu - 1.0);
+  std::vector<double> batch(points);
+  const double batch_seconds = secondsPerCall(10, [&]() {
+    integrateBatch(
+        [](const double drift, const double u) {
+          return std::exp(drift * u - 0.5 * u * u);
+        },
+        drifts,
+        batch,
+        rule,
+        0.0,
+        upper
+    );
+    return batch.back();
+  });
+
+  double error{0.0};
+  for (std::size_t i{0}; i < points; ++i) {
+    error = std::max(error, std::abs(batch[i] / expected[i] - 1.0));
+  }
+  std::cout << "pointwise: " << points << " values of F in "
+            << pointwise_seconds * 1e6 << " us" << std::endl;
+  std::cout << "batch: " << points << " values of F in "
+            << batch_seconds * 1e6 << " us, largest relative difference "
+            << error << std::endl;
+  return 0;
+}
@@ -0,0 +1,68 @@
+#include "benchmark_utils.h"
+#include "counting_allocator.h"
+#include "stochastic_models/trading/trading_levels.h"
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+/**
+ * @file
+ * @brief Counts the heap allocations and times the solves of the optimal
+ * trading levels on an existing OrnsteinUhlenbeckTradingLevels.
+ */
+
+/**
+ * @brief Calls fn repeatedly after a first call that warms the thread's
+ * solvers, rule and caches, and prints the allocations and time per call.
+ *
+ * @param name The name of the benchmarked call.
+ * @param repeats Number of times fn is called.
+ * @param fn Callable returning the benchmarked value.
+ */
+template <typename Fn>
+void report(const char* name, const unsigned int repeats, Fn&& fn) {
+  sink = sink + fn();
+  const std::size_t before = allocations.load();
+  const auto start = std::chrono::steady_clock::now();
+  for (unsigned int i{0}; i < repeats; ++i) {
+    sink = sink + fn();
+  }
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  std::cout << name << ": "
+            << static_cast<double>(allocations.load() - before) / repeats
+            << " allocations and " << elapsed.count() / repeats * 1e6
+            << " us per call" << std::endl;
+}
+
+int main() {
+  const double stop_loss = 0.05;
+  const double r = 0.05;
+  const double c = 0.02;
+  const unsigned int repeats = 200;
+
+  std::size_t before = allocations.load();
+  const OrnsteinUhlenbeckTradingLevels levels(0.3, 8.0, 0.3);
+  std::cout << "construction: " << allocations.load() - before
+            << " allocations" << std::endl;
+
+  report("optimalExit with stop loss", repeats, [&]() {
+    return levels.optimalExit(stop_loss, r, c);
+  });
+  const double b_star = levels.optimalExit(stop_loss, r, c);
+  report("optimalEntry with stop loss", repeats, [&]() {
+    return levels.optimalEntry(b_star, stop_loss, r, c);
+  });
+  const double d_star = levels.optimalEntry(b_star, stop_loss, r, c);
+  report("optimalEntryLower with stop loss", repeats, [&]() {
+    return levels.optimalEntryLower(d_star, b_star, stop_loss, r, c);
+  });
+  report("optimalExit", repeats, [&]() { return levels.optimalExit(r, c); });
+  report("solveTradingLevels with stop loss", repeats, [&]() {
+    return levels.solveTradingLevels(stop_loss, r, c).a_star;
+  });
+  report("solveTradingLevels", repeats, [&]() {
+    return levels.solveTradingLevels(r, c).d_star;
+  });
+  return 0;
+}
@@ -0,0 +1,47 @@
+#include "benchmark_utils.h"
+#include "stochastic_models/entrypoints/optimal_trading_levels.h"
+#include "stochastic_models/trading/trading_levels.h"
+
+#include <cmath>
+#include <iostream>
+/**
+ * @file
+ * @brief Compares solving the optimal trading levels b*, d* and a* with the
+ * three staged entrypoints against the fused solveTradingLevels.
+ */
+
+int main() {
+  const double mu = 0.3;
+  const double alpha = 8.0;
+  const double sigma = 0.3;
+  const double stop_loss = 0.05;
+  const double r = 0.05;
+  const double c = 0.02;
+  const unsigned int repeats = 200;
+
+  // Every stage constructs its own trading levels instance.
+  double b_star{0.0}, d_star{0.0}, a_star{0.0};
+  const double staged_seconds = secondsPerCall(repeats, [&]() {
+    b_star = optimalExitLevel(mu, alpha, sigma, stop_loss, r, c);
+    d_star = optimalEntryLevel(b_star, mu, alpha, sigma, stop_loss, r, c);
+    a_star = optimalEntryLevelLower(
+        d_star, b_star, mu, alpha, sigma, stop_loss, r, c
+    );
+    return a_star;
+  });
+
+  TradingLevelsSolution levels{};
+  const double fused_seconds = secondsPerCall(repeats, [&]() {
+    const OrnsteinUhlenbeckTradingLevels trading_levels(mu, alpha, sigma);
+    levels = trading_levels.solveTradingLevels(stop_loss, r, c);
+    return levels.a_star;
+  });
+
+  std::cout << "staged: b* = " << b_star << ", d* = " << d_star
+            << ", a* = " << a_star << " in " << staged_seconds * 1e6 << " us"
+            << std::endl;
+  std::cout << "fused:  b* = " << levels.b_star << ", d* = " << levels.d_star
+            << ", a* = " << levels.a_star << " in " << fused_seconds * 1e6
+            << " us, speed-up " << staged_seconds / fused_seconds << std::endl;
+  return 0;
+}
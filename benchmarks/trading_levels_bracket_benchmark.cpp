@@ -0,0 +1,174 @@
+#include "benchmark_utils.h"
+#include "stochastic_models/numeric_utils/solvers.h"
+#include "stochastic_models/trading/trading_levels.h"
+
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+/**
+ * @file
+ * @brief Compares solving b*, d* and a* over the full solver bounds with
+ * solving them over the brackets placed by the closed-form approximation of
+ * the transforms, counting the quadratures of the exact transforms.
+ */
+
+/**
+ * @brief Parameters of one benchmarked regime beyond the model's.
+ *
+ */
+struct LevelsRegime : Regime {
+  double stop_loss;
+  double r;
+  double c;
+};
+
+/**
+ * @brief Solves a root function over the full bounds and over its bracket,
+ * and prints the work and time of each.
+ *
+ * The transform cache of the exact optimizer is cleared before every solve,
+ * as for the first solve of new parameters, so its misses count the
+ * quadratures of the exact transforms while the solver's repeated evaluations
+ * at the bracket ends are answered from it.
+ *
+ * @param level The name of the level.
+ * @param fn Callable taking x and returning the exact root function at x.
+ * @param bracket Callable returning the RootBracket of the level.
+ * @param cache The transform cache of the exact optimizer.
+ * @param lower The lower solver bound.
+ * @param upper The upper solver bound.
+ */
+template <typename Fn, typename Bracket>
+void compareLevel(
+    const char* level,
+    Fn& fn,
+    Bracket& bracket,
+    TransformCache* cache,
+    const double lower,
+    const double upper
+) {
+  const unsigned int repeats = 200;
+
+  SolverResult full{};
+  const double full_seconds = secondsPerCall(repeats, [&]() {
+    cache->clear();
+    full = solve(fn, lower, upper);
+    return full.root;
+  });
+  const std::size_t full_quadratures = cache->misses();
+
+  RootBracket range{};
+  SolverResult bracketed{};
+  const double bracketed_seconds = secondsPerCall(repeats, [&]() {
+    cache->clear();
+    range = bracket();
+    bracketed = solve(fn, range.lower, range.upper);
+    return bracketed.root;
+  });
+  const std::size_t bracketed_quadratures = cache->misses();
+
+  std::cout << "  " << level << " = " << full.root << "\n    full bounds: "
+            << full.iterations << " iterations, " << full_quadratures
+            << " quadratures in " << full_seconds * 1e6 << " us"
+            << "\n    bracketed:   " << bracketed.iterations
+            << " iterations, " << bracketed_quadratures << " quadratures in "
+            << bracketed_seconds * 1e6 << " us, width "
+            << range.upper - range.lower << ", difference "
+            << std::abs(bracketed.root - full.root) << std::endl;
+}
+
+int main() {
+  const LevelsRegime regimes[] = {
+      {"fast reversion", 0.5388, 16.6677, 0.1599, 0.4, 0.05, 0.05},
+      {"moderate reversion", 0.3, 8.0, 0.3, 0.05, 0.05, 0.02},
+      {"slow reversion", 0.0, 1.0, 0.3, -0.3, 0.05, 0.02},
+  };
+  const TransformQuadrature quadratures[] = {
+      TransformQuadrature::FixedOrder, TransformQuadrature::Adaptive
+  };
+  const char* quadrature_names[] = {"fixed-order", "adaptive"};
+
+  for (const LevelsRegime& regime : regimes) {
+    const OrnsteinUhlenbeckTradingLevels trading_levels(
+        regime.mu, regime.alpha, regime.sigma
+    );
+    const OptimalMeanReversion* approximation =
+        trading_levels.getApproximation();
+    const HittingTimeOrnsteinUhlenbeck* kernel =
+        trading_levels.getHittingTimeKernel();
+    const double deviation = 1.0 / kernel->optimalTradingScale();
+    const double stop_loss = regime.stop_loss;
+    const double r = regime.r;
+    const double c = regime.c;
+    const double exit_lower = trading_levels.optimalExitLowerBound(r, c);
+    const double exit_upper = trading_levels.optimalExitUpperBound();
+    const TradingLevelsSolution levels =
+        trading_levels.solveTradingLevels(stop_loss, r, c);
+    const double b_star = levels.b_star;
+    const double d_star = levels.d_star;
+    const ValueFunctionCoefficients approximate_coefficients =
+        approximation->valueFunction(kernel, b_star, stop_loss, r, c);
+
+    // The brackets are rebuilt here as in the OrnsteinUhlenbeckTradingLevels
+    // bracket methods, but from value function coefficients computed once as
+    // in solveTradingLevels.
+    auto approximateBracket = [&](auto& approximate,
+                                  auto& exact,
+                                  const double lower,
+                                  const double upper) {
+      SolverOptions options;
+      options.epsabs = 1e-2 * deviation;
+      options.epsrel = 0.0;
+      const double guess = solve(approximate, lower, upper, options).root;
+      return expandBracket(exact, guess, 0.1 * deviation, lower, upper);
+    };
+    auto approximate_b = [&](const double x) {
+      return approximation->b(x, kernel, stop_loss, r, c);
+    };
+    auto approximate_d = [&](const double x) {
+      return approximation->d(
+          x, kernel, approximate_coefficients, b_star, stop_loss, r, c
+      );
+    };
+    auto approximate_a = [&](const double x) {
+      return approximation->a(
+          x, kernel, approximate_coefficients, b_star, stop_loss, r, c
+      );
+    };
+
+    for (std::size_t i{0}; i < 2; ++i) {
+      const OptimalMeanReversion optimizer(quadratures[i]);
+      TransformCache* cache = optimizer.getTransformCache();
+      const ValueFunctionCoefficients coefficients =
+          optimizer.valueFunction(kernel, b_star, stop_loss, r, c);
+      std::cout << regime.name << ", " << quadrature_names[i]
+                << " quadrature" << std::endl;
+
+      auto b = [&](const double x) {
+        return optimizer.b(x, kernel, stop_loss, r, c);
+      };
+      auto exit_bracket = [&]() {
+        return approximateBracket(approximate_b, b, exit_lower, exit_upper);
+      };
+      compareLevel("b*", b, exit_bracket, cache, exit_lower, exit_upper);
+
+      auto d = [&](const double x) {
+        return optimizer.d(x, kernel, coefficients, b_star, stop_loss, r, c);
+      };
+      auto entry_bracket = [&]() {
+        return approximateBracket(approximate_d, d, stop_loss, b_star);
+      };
+      compareLevel("d*", d, entry_bracket, cache, stop_loss, b_star);
+
+      auto a = [&](const double x) {
+        return optimizer.a(x, kernel, coefficients, b_star, stop_loss, r, c);
+      };
+      auto entry_lower_bracket = [&]() {
+        return approximateBracket(approximate_a, a, stop_loss, d_star);
+      };
+      compareLevel("a*", a, entry_lower_bracket, cache, stop_loss, d_star);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,85 @@
+#include "benchmark_utils.h"
+#include "stochastic_models/trading/trading_levels.h"
+#include "stochastic_models/trading/trading_levels_tracker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+/**
+ * @file
+ * @brief Compares re-solving the trading levels from scratch on every tick of
+ * slowly drifting Ornstein-Uhlenbeck parameters with warm-starting them from
+ * the previous tick.
+ */
+
+/**
+ * @brief Times solving the levels from scratch and with the tracker over a
+ * sequence of ticks, and prints both.
+ *
+ * @param name The name of the sequence.
+ * @param mu The long term mean of each tick.
+ * @param alpha The mean reversion speed of each tick.
+ * @param sigma The volatility of each tick.
+ */
+static void compare(
+    const char* name,
+    const std::vector<double>& mu,
+    const std::vector<double>& alpha,
+    const std::vector<double>& sigma
+) {
+  const double stop_loss = 0.05;
+  const double r = 0.05;
+  const double c = 0.02;
+  const std::size_t ticks = mu.size();
+
+  std::vector<double> full_b_star(ticks);
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i{0}; i < ticks; ++i) {
+    const OrnsteinUhlenbeckTradingLevels levels(mu[i], alpha[i], sigma[i]);
+    full_b_star[i] = levels.solveTradingLevels(stop_loss, r, c).b_star;
+  }
+  const std::chrono::duration<double> full =
+      std::chrono::steady_clock::now() - start;
+
+  double largest_difference{0.0};
+  OrnsteinUhlenbeckTradingLevelsTracker tracker(stop_loss, r, c);
+  start = std::chrono::steady_clock::now();
+  for (std::size_t i{0}; i < ticks; ++i) {
+    const double b_star = tracker.update(mu[i], alpha[i], sigma[i]).b_star;
+    largest_difference =
+        std::max(largest_difference, std::abs(b_star - full_b_star[i]));
+    sink = sink + b_star;
+  }
+  const std::chrono::duration<double> tracked =
+      std::chrono::steady_clock::now() - start;
+
+  std::cout << name << "\n  full solve: " << full.count() / ticks * 1e6
+            << " us per tick" << std::endl;
+  std::cout << "  tracker:    " << tracked.count() / ticks * 1e6
+            << " us per tick, " << tracker.warmStarts() << " warm starts, "
+            << tracker.fullSolves() << " full solves, largest b* difference "
+            << largest_difference << std::endl;
+}
+
+int main() {
+  const std::size_t ticks = 500;
+
+  // Parameters wandering as an online estimator would move them.
+  std::vector<double> mu(ticks), alpha(ticks), sigma(ticks);
+  for (std::size_t i{0}; i < ticks; ++i) {
+    const double t = static_cast<double>(i) / ticks;
+    mu[i] = 0.3 + 0.01 * std::sin(6.0 * t);
+    alpha[i] = 8.0 + 0.5 * std::cos(4.0 * t);
+    sigma[i] = 0.3 + 0.005 * std::sin(9.0 * t);
+  }
+  // A change of alpha changes the exponent r / alpha of the transforms and
+  // with it their Gauss-Jacobi rule, which is rebuilt by both solves.
+  compare("mu, alpha and sigma drifting", mu, alpha, sigma);
+  compare(
+      "mu and sigma drifting", mu, std::vector<double>(ticks, 8.0), sigma
+  );
+  return 0;
+}
@@ -0,0 +1,72 @@
+#include "benchmark_utils.h"
+#include "stochastic_models/hitting_times/hitting_time_ornstein_uhlenbeck.h"
+#include "stochastic_models/trading/optimal_mean_reversion.h"
+#include "stochastic_models/trading/trading_levels.h"
+
+#include <cmath>
+#include <iostream>
+#include <memory>
+/**
+ * @file
+ * @brief Compares the cost of the adaptive and fixed-order quadratures of the
+ * optimal trading transforms F(x;r) and G(x;r), and of the trading levels
+ * built on them with the number of transforms answered by the cache, and the
+ * cost of building and interpolating a Chebyshev table of the transforms.
+ */
+
+int main() {
+  const double mu = 0.5388;
+  const double alpha = 16.6677;
+  const double sigma = 0.1599;
+  const double r = 0.05;
+  const double c = 0.05;
+  const HittingTimeOrnsteinUhlenbeck kernel(mu, alpha, sigma);
+  const double deviation = sigma / std::sqrt(2 * alpha);
+
+  const TransformQuadrature backends[] = {
+      TransformQuadrature::Adaptive, TransformQuadrature::FixedOrder
+  };
+  const char* names[] = {"adaptive", "fixed order"};
+  for (int i{0}; i < 2; ++i) {
+    const OptimalMeanReversion optimizer(backends[i]);
+    double x = mu - 4 * deviation;
+    const double seconds = secondsPerCall(10000, [&]() {
+      x = x < mu + 4 * deviation ? x + 0.01 * deviation : mu - 4 * deviation;
+      return optimizer.F(&kernel, x, r, c) + optimizer.G(&kernel, x, r, c);
+    });
+    std::cout << names[i] << ": F + G in " << seconds * 1e6 << " us"
+              << std::endl;
+  }
+
+  // A table over the solver bounds answers F and G by interpolation.
+  std::shared_ptr<const TransformTable> table;
+  const double build_seconds = secondsPerCall(1, [&]() {
+    table = std::make_shared<const TransformTable>(
+        &kernel, r, mu - 4 * deviation, mu + 4 * deviation
+    );
+    return table->getTolerance();
+  });
+  OptimalMeanReversion tabulated;
+  tabulated.setTransformTable(table);
+  double x = mu - 4 * deviation;
+  const double table_seconds = secondsPerCall(10000, [&]() {
+    x = x < mu + 4 * deviation ? x + 0.01 * deviation : mu - 4 * deviation;
+    return tabulated.F(&kernel, x, r, c) + tabulated.G(&kernel, x, r, c);
+  });
+  std::cout << "table: built in " << build_seconds * 1e6 << " us with "
+            << table->getPanels().size() << " panels, F + G in "
+            << table_seconds * 1e6 << " us" << std::endl;
+
+  // The trading levels use the default fixed-order quadrature.
+  const OrnsteinUhlenbeckTradingLevels levels(mu, alpha, sigma);
+  double b_star{0.0};
+  const double seconds = secondsPerCall(100, [&]() {
+    b_star = levels.optimalExit(r, c);
+    return levels.optimalEntry(b_star, r, c);
+  });
+  const TransformCache* cache = levels.getOptimizer()->getTransformCache();
+  std::cout << "optimal exit and entry in " << seconds * 1e6 << " us ("
+            << cache->hits() << " cache hits, " << cache->misses()
+            << " misses)" << std::endl;
+  return 0;
+}
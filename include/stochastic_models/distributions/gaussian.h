@@ -1,6 +1,10 @@
 #ifndef STOCHASTIC_MODELS_DISTRIBUTIONS_GAUSSIAN_H
 #define STOCHASTIC_MODELS_DISTRIBUTIONS_GAUSSIAN_H
 #include "stochastic_models/distributions/core.h"
+#include "stochastic_models/distributions/random.h"
+
+#include <cstdint>
+#include <span>
 /**
  * @file
  * @brief Gaussian (normal) distribution concrete implementation.
@@ -18,6 +22,8 @@ private:
   const double mu;
   // Gaussian distribution standard deviation value.
   const double sigma;
+  // Counter-based engine backing sample; advanced on every draw.
+  mutable PhiloxEngine engine;
 
   /**
    * Uses Error Function to produce the CDF of the Gaussian
@@ -48,6 +54,20 @@ public:
    * @param sigma Standard deviation (must be > 0).
    */
   GaussianDistribution(const double mu, const double sigma);
+  /**
+   * @brief Construct a seeded GaussianDistribution whose samples are
+   * reproducible.
+   * @param mu Mean.
+   * @param sigma Standard deviation (must be > 0).
+   * @param seed Seed of the random stream backing sample.
+   * @param stream Id of the random stream backing sample.
+   */
+  GaussianDistribution(
+      const double mu,
+      const double sigma,
+      const std::uint64_t seed,
+      const std::uint64_t stream = 0
+  );
 
   /**
    * Returns distribution mean.
@@ -77,10 +97,52 @@ public:
    * Draws a random sample from normal distribution. Parameterized by
    * mu and sigma private attributes.
    *
+   * Draws continue the distribution's own random stream, so consecutive calls
+   * return different values and a seeded distribution is reproducible. The
+   * stream is not synchronised; use the engine overload to sample from
+   * several threads.
+   *
    * @param size how many samples to draw. Defaults to 1.
    * @returns Random values drawn from normal distribution.
    */
   std::vector<double> sample(const std::size_t& size = 1) const override;
+  /**
+   * Draws a random sample from normal distribution using the provided random
+   * stream instead of the distribution's own.
+   *
+   * @param size how many samples to draw.
+   * @param engine Random stream to draw from; advanced by the call.
+   * @returns Random values drawn from normal distribution.
+   */
+  std::vector<double>
+  sample(const std::size_t& size, PhiloxEngine& engine) const;
+  /**
+   * Fills a buffer with draws from the normal distribution using the
+   * distribution's own random stream. Unlike sample no memory is allocated
+   * and draws are generated in vectorized blocks.
+   *
+   * @param out Buffer to fill.
+   */
+  void fill(std::span<double> out) const;
+  /**
+   * Fills a buffer with draws from the normal distribution using the provided
+   * random stream.
+   *
+   * @param out Buffer to fill.
+   * @param engine Random stream to draw from; advanced by the call.
+   */
+  void fill(std::span<double> out, PhiloxEngine& engine) const;
+  /**
+   * @brief Reset the distribution's own random stream.
+   * @param seed Seed of the random stream.
+   * @param stream Id of the random stream.
+   */
+  void seed(const std::uint64_t seed, const std::uint64_t stream = 0);
+  /**
+   * @brief Return the seed of the distribution's own random stream.
+   * @return const std::uint64_t Seed.
+   */
+  const std::uint64_t getSeed() const;
   ~GaussianDistribution() override;
 };
 #endif // STOCHASTIC_MODELS_DISTRIBUTIONS_GAUSSIAN_H
@@ -0,0 +1,133 @@
+#ifndef STOCHASTIC_MODELS_DISTRIBUTIONS_QUASI_RANDOM_H
+#define STOCHASTIC_MODELS_DISTRIBUTIONS_QUASI_RANDOM_H
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * @file
+ * @brief Low-discrepancy sequences and path constructions used for
+ * quasi-Monte Carlo simulation.
+ */
+
+/**
+ * @brief Inverse of the standard normal cumulative distribution function.
+ *
+ * Uses Acklam's rational approximation refined by one Halley step, which is
+ * accurate to close to double precision over (0, 1).
+ *
+ * @param u Probability in (0, 1).
+ * @return const double The standard normal quantile of u.
+ */
+const double inverseStandardNormalCdf(const double u);
+
+/**
+ * @brief Sobol low-discrepancy sequence in up to max_dimensions dimensions.
+ *
+ * Direction numbers are the Joe–Kuo (new-joe-kuo-6.21201) values. Points are
+ * computed directly from their index via the Gray code, so any sub-range of
+ * the sequence can be generated independently (for example by different
+ * threads). An optional random digital shift, derived from a seed, turns the
+ * sequence into a randomized QMC estimator whose error can be estimated from
+ * independent seeds.
+ */
+class SobolSequence {
+public:
+  /**
+   * @brief Maximum number of supported dimensions.
+   */
+  static constexpr std::size_t max_dimensions = 21;
+
+  /**
+   * @brief Construct an unshifted sequence.
+   * @param dimensions Number of dimensions of each point.
+   * @throws std::invalid_argument if dimensions is 0 or above max_dimensions.
+   */
+  explicit SobolSequence(const std::size_t dimensions);
+  /**
+   * @brief Construct a sequence with a random digital shift.
+   * @param dimensions Number of dimensions of each point.
+   * @param seed Seed of the digital shift.
+   * @throws std::invalid_argument if dimensions is 0 or above max_dimensions.
+   */
+  SobolSequence(const std::size_t dimensions, const std::uint64_t seed);
+  /**
+   * @brief Return the number of dimensions of each point.
+   * @return const std::size_t Number of dimensions.
+   */
+  const std::size_t getDimensions() const;
+  /**
+   * @brief Write point index of the sequence as uniforms in (0, 1).
+   * @param index Index of the point.
+   * @param out Buffer of getDimensions() values.
+   */
+  void uniforms(const std::uint64_t index, std::span<double> out) const;
+  /**
+   * @brief Write point index of the sequence mapped to standard normals.
+   * @param index Index of the point.
+   * @param out Buffer of getDimensions() values.
+   */
+  void normals(const std::uint64_t index, std::span<double> out) const;
+
+private:
+  // Number of dimensions of each point.
+  std::size_t dimensions;
+  // Direction numbers per dimension and bit, scaled to 32 bits.
+  std::vector<std::array<std::uint32_t, 32>> directions;
+  // Digital shift XORed into each dimension.
+  std::vector<std::uint32_t> shift;
+};
+
+/**
+ * @brief Brownian bridge construction of a Brownian path on the unit grid
+ * t = 1, ..., n.
+ *
+ * The first standard normal fixes the terminal value, the second the
+ * midpoint and so on, so the leading normals carry most of the path
+ * variance. Feeding the leading coordinates from a low-discrepancy sequence
+ * therefore concentrates its uniformity where it matters most.
+ */
+class BrownianBridge {
+public:
+  /**
+   * @brief Precompute the construction order and weights for n steps.
+   * @param steps Number of steps of the path.
+   */
+  explicit BrownianBridge(const std::size_t steps);
+  /**
+   * @brief Return the number of steps of the path.
+   * @return const std::size_t Number of steps.
+   */
+  const std::size_t getSteps() const;
+  /**
+   * @brief Map standard normals to standard normal path increments.
+   *
+   * The increments are W(i + 1) - W(i) of the constructed path, which are
+   * independent standard normals when the inputs are.
+   *
+   * @param normals Standard normals in order of importance.
+   * @param increments Output buffer for the path increments.
+   */
+  void transform(
+      std::span<const double> normals, std::span<double> increments
+  ) const;
+
+private:
+  // Number of steps of the path.
+  std::size_t steps;
+  // Index of the point fixed by each normal.
+  std::vector<std::size_t> bridge_index;
+  // Index of the left neighbour (one based, zero for the origin).
+  std::vector<std::size_t> left_index;
+  // Index of the right neighbour.
+  std::vector<std::size_t> right_index;
+  // Weight of the left neighbour in the conditional mean.
+  std::vector<double> left_weight;
+  // Weight of the right neighbour in the conditional mean.
+  std::vector<double> right_weight;
+  // Conditional standard deviation of the point fixed by each normal.
+  std::vector<double> std_dev;
+};
+#endif // STOCHASTIC_MODELS_DISTRIBUTIONS_QUASI_RANDOM_H
@@ -0,0 +1,138 @@
+#ifndef STOCHASTIC_MODELS_DISTRIBUTIONS_RANDOM_H
+#define STOCHASTIC_MODELS_DISTRIBUTIONS_RANDOM_H
+#include <array>
+#include <cstdint>
+#include <span>
+
+/**
+ * @file
+ * @brief Counter-based random number generation used for reproducible,
+ * parallel sampling.
+ */
+
+/**
+ * @brief Philox4x32-10 counter-based random number engine.
+ *
+ * Every output block is a pure function of a 128-bit counter and a 64-bit
+ * key, so the engine needs no state beyond its position. The key holds the
+ * seed, the upper half of the counter holds a stream id and the lower half
+ * counts blocks within the stream. Independent streams (for example one per
+ * thread or per simulated path) are obtained by changing the stream id and
+ * any stream can be advanced in constant time with discard.
+ *
+ * Satisfies std::uniform_random_bit_generator so it can also be used with the
+ * standard library distributions. An engine must not be shared between
+ * threads without synchronisation; give each thread its own stream instead.
+ */
+class PhiloxEngine {
+public:
+  using result_type = std::uint32_t;
+  using counter_type = std::array<std::uint32_t, 4>;
+  using key_type = std::array<std::uint32_t, 2>;
+
+  /**
+   * @brief Default seed used when none is provided.
+   */
+  static constexpr std::uint64_t default_seed = 0x9E3779B97F4A7C15ULL;
+
+  /**
+   * @brief Construct an engine positioned at the start of a stream.
+   * @param seed Seed (key) of the engine.
+   * @param stream Id of the stream to generate.
+   */
+  explicit PhiloxEngine(
+      const std::uint64_t seed = default_seed, const std::uint64_t stream = 0
+  );
+  /**
+   * @brief Reset the engine to the start of a stream.
+   * @param seed Seed (key) of the engine.
+   * @param stream Id of the stream to generate.
+   */
+  void seed(const std::uint64_t seed, const std::uint64_t stream = 0);
+  /**
+   * @brief Return an engine with the same seed positioned at the start of
+   * another stream.
+   * @param stream Id of the stream to generate.
+   * @return PhiloxEngine Engine generating the requested stream.
+   */
+  PhiloxEngine split(const std::uint64_t stream) const;
+  /**
+   * @brief Return the next 32-bit output of the stream.
+   * @return result_type Uniformly distributed 32-bit value.
+   */
+  result_type operator()();
+  /**
+   * @brief Skip ahead n 32-bit outputs in constant time.
+   * @param n Number of outputs to skip.
+   */
+  void discard(const unsigned long long n);
+  /**
+   * @brief Draw a uniform value with 53 bits of precision.
+   * @return double Uniform value in [0, 1).
+   */
+  double uniform();
+  /**
+   * @brief Draw a standard normal value using the Box–Muller transform.
+   *
+   * Each transform consumes four 32-bit outputs and yields two values; the
+   * second is returned by the following call.
+   *
+   * @return double Standard normal value.
+   */
+  double normal();
+  /**
+   * @brief Fill a buffer with standard normal values.
+   *
+   * Bulk counterpart of normal. Uniforms are generated a block of counters at
+   * a time and transformed with a branch-free Box–Muller kernel (polynomial
+   * logarithm and sine/cosine) that the compiler vectorizes. A final partial
+   * block is transformed in bulk as well when it holds at least 64 values;
+   * only a shorter remainder falls back to the scalar normal. Any
+   * unused outputs of a partially consumed block are skipped, so the values
+   * differ from repeated calls to normal but are equally reproducible.
+   *
+   * @param out Buffer to fill.
+   */
+  void fillNormal(std::span<double> out);
+  /**
+   * @brief Return the seed the engine was constructed with.
+   * @return const std::uint64_t Seed.
+   */
+  const std::uint64_t getSeed() const;
+  /**
+   * @brief Return the id of the stream being generated.
+   * @return const std::uint64_t Stream id.
+   */
+  const std::uint64_t getStream() const;
+  /**
+   * @brief Apply the Philox4x32-10 bijection to a counter.
+   * @param counter Counter to encrypt.
+   * @param key Key to encrypt the counter with.
+   * @return counter_type Four uniformly distributed 32-bit values.
+   */
+  static counter_type generateBlock(counter_type counter, key_type key);
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return 0xFFFFFFFFU; }
+
+private:
+  // Key derived from the seed.
+  key_type key;
+  // Counter of the next block; words 2 and 3 hold the stream id.
+  counter_type counter;
+  // Most recently generated block.
+  counter_type buffer;
+  // Position of the next unused value in buffer (4 when exhausted).
+  unsigned int index;
+  // Second value of the last Box–Muller transform.
+  double cached_normal;
+  // Whether cached_normal holds an unused value.
+  bool has_cached_normal;
+
+  /**
+   * @brief Generate the block at the current counter and advance it.
+   * @return counter_type Generated block.
+   */
+  counter_type nextBlock();
+};
+#endif // STOCHASTIC_MODELS_DISTRIBUTIONS_RANDOM_H
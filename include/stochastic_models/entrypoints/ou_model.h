@@ -1,5 +1,6 @@
 #ifndef STOCHASTIC_MODELS_ENTRYPOINTS_OU_MODEL_H
 #define STOCHASTIC_MODELS_ENTRYPOINTS_OU_MODEL_H
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <unordered_map>
@@ -14,7 +15,8 @@
  * @param sigma The series volatility.
  * @param start The value to start the simulation at.
  * @param size The number of values to simulate.
- * @param t The time period to simulate over.
+ * @param t The time increment of a single step, which may be fractional
+ * (e.g. for intraday steps).
  * @return std::vector<double> A simulated Ornstein-Uhlenbeck process series.
  */
 const std::vector<double> simulateOrnsteinUhlenbeck(
@@ -23,7 +25,7 @@ const std::vector<double> simulateOrnsteinUhlenbeck(
     const double& sigma,
     const double start,
     const unsigned int& size,
-    const unsigned int& t
+    const double& t
 );
 
 /**
@@ -47,6 +49,40 @@ const double hittingTimeDensityOrnsteinUhlenbeck(
     double first,
     double second
 );
+/**
+ * @brief Estimates the probability of hitting the level first before second
+ * by simulating paths, together with the distribution of the time to hit
+ * either level. Complements hittingTimeDensityOrnsteinUhlenbeck, which is
+ * usually faster for a single probability but provides no timing.
+ *
+ * @param x The starting point of the paths.
+ * @param mu The series mean.
+ * @param alpha The series mean reversion speed.
+ * @param sigma The series volatility.
+ * @param first The first level that is hit.
+ * @param second The level first is assumed to be hit before.
+ * @param n_paths The number of simulated paths.
+ * @param dt The time step of the simulated paths.
+ * @param horizon The time after which a path is abandoned as unresolved.
+ * @param seed Seed for the random streams of the simulation.
+ * @return const std::unordered_map<std::string, const double> The
+ * "probability", its "standard_error", the "expected_time" and
+ * "median_time" of the exit through either level and the fraction of
+ * "unresolved" paths.
+ */
+const std::unordered_map<std::string, const double>
+hittingTimeMonteCarloOrnsteinUhlenbeck(
+    const double x,
+    const double mu,
+    const double alpha,
+    const double sigma,
+    const double first,
+    const double second,
+    const std::size_t n_paths,
+    const double dt,
+    const double horizon,
+    const uint64_t seed
+);
 /**
  * @brief Calculate the maximum likelihood estimates of the
  * Ornstein-Uhlenbeck model parameters using the series in vec.
@@ -67,4 +67,13 @@ public:
       : std::logic_error{msg} {}
 };
 
+/**
+ * @brief Malformed or incomplete JSON supplied for a trading transform table.
+ */
+class TransformTableParseError final : public std::runtime_error {
+public:
+  TransformTableParseError(const std::string& msg)
+      : std::runtime_error{msg} {}
+};
+
 #endif // STOCHASTIC_MODELS_EXCEPTIONS_ERRORS_H
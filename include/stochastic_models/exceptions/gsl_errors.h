@@ -2,16 +2,15 @@
 #define STOCHASTIC_MODELS_EXCEPTIONS_GSL_ERRORS_H
 
 /**
- * @brief Custom error handler for GSL errors. Does not call abort() after
- * reporting the error.
+ * @brief Turns off the GSL error handler for the whole process, exactly once.
  *
- * @param reason The reason for the error.
- * @param file The file in which the error occurred.
- * @param line The line number at which the error occurred.
- * @param gsl_errno The GSL error number.
+ * GSL's default handler aborts the program, and swapping handlers around
+ * each call races with other threads since the handler is process-global
+ * state. Instead every GSL wrapper calls this before its first GSL call and
+ * then maps the returned status codes to exceptions with
+ * check_function_status. Repeated and concurrent calls are cheap and safe.
+ * Note that this replaces any handler installed by the host application.
  */
-void custom_gsl_exception_handler(
-    const char* reason, const char* file, int line, int gsl_errno
-);
+void disableGslErrorHandler();
 
 #endif // STOCHASTIC_MODELS_EXCEPTIONS_GSL_ERRORS_H
@@ -0,0 +1,94 @@
+#ifndef STOCHASTIC_MODELS_HITTING_TIMES_FIRST_PASSAGE_MONTE_CARLO_H
+#define STOCHASTIC_MODELS_HITTING_TIMES_FIRST_PASSAGE_MONTE_CARLO_H
+#include "stochastic_models/sde/ornstein_uhlenbeck.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file
+ * @brief Monte Carlo estimation of Ornstein-Uhlenbeck first-passage
+ * probabilities and times, complementing the quadrature in
+ * hitting_time_density.h.
+ */
+
+/**
+ * @brief Controls the discretization of the first-passage simulation.
+ *
+ */
+struct FirstPassageOptions {
+  // Time step of the simulated paths.
+  double dt = 1e-3;
+  // Paths not absorbed within this time are reported as unresolved.
+  double horizon = 100.0;
+  // Number of values generated per path between absorption checks.
+  std::size_t chunk_size = 256;
+  // Whether to detect crossings between grid points with the Brownian bridge
+  // crossing probability, which removes most of the bias of monitoring the
+  // levels only at the grid points.
+  bool bridge_correction = true;
+};
+
+/**
+ * @brief Monte Carlo estimate of the first passage of a process starting
+ * between two levels.
+ *
+ */
+struct FirstPassageEstimate {
+  // Fraction of paths hitting the first level before the second.
+  double probability;
+  // Standard error of probability.
+  double standard_error;
+  // Mean exit time through either level of the resolved paths.
+  double expected_time;
+  // Number of paths not absorbed within the horizon.
+  std::size_t unresolved;
+  // Sorted exit times of the resolved paths.
+  std::vector<double> exit_times;
+
+  /**
+   * @brief Returns a quantile of the exit time of the resolved paths,
+   * interpolating linearly between order statistics.
+   *
+   * @param p The probability of the quantile in [0, 1].
+   * @return const double The exit time quantile.
+   * @throws std::invalid_argument if p lies outside [0, 1] or no path was
+   * resolved.
+   */
+  const double quantile(const double p) const;
+};
+
+/**
+ * @brief Estimates the probability of hitting first before second, and the
+ * distribution of the exit time through either level, by simulating
+ * Ornstein-Uhlenbeck paths from x.
+ *
+ * Every path is generated as a stream of chunk_size values using the exact
+ * transition and stops as soon as it is absorbed, so cost is proportional to
+ * the exit times rather than the horizon. Paths are spread over the
+ * available hardware threads and path p draws its noise from stream p of
+ * seed, so the estimate depends only on the seed. Unresolved paths count as
+ * not hitting first.
+ *
+ * @param model The Ornstein-Uhlenbeck model to simulate.
+ * @param x The starting point, strictly between the levels.
+ * @param first The level whose hitting probability is estimated.
+ * @param second The competing level.
+ * @param n_paths The number of simulated paths.
+ * @param seed Seed for the random streams of the simulation.
+ * @param options Discretization of the simulation.
+ * @return const FirstPassageEstimate The estimate.
+ * @throws std::invalid_argument if x is not strictly between the levels, or
+ * n_paths, dt, horizon or chunk_size is not positive.
+ */
+const FirstPassageEstimate estimateFirstPassage(
+    const OrnsteinUhlenbeckModel& model,
+    const double x,
+    const double first,
+    const double second,
+    const std::size_t n_paths,
+    const std::uint64_t seed,
+    const FirstPassageOptions& options = {}
+);
+#endif // STOCHASTIC_MODELS_HITTING_TIMES_FIRST_PASSAGE_MONTE_CARLO_H
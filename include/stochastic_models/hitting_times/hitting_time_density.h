@@ -1,5 +1,6 @@
 #ifndef STOCHASTIC_MODELS_HITTING_TIMES_HITTING_TIME_DENSITY_H
 #define STOCHASTIC_MODELS_HITTING_TIMES_HITTING_TIME_DENSITY_H
+#include "stochastic_models/hitting_times/hitting_time_ornstein_uhlenbeck.h"
 #include "stochastic_models/numeric_utils/types.h"
 
 /**
@@ -31,4 +32,46 @@ double integrateHittingTimeDensity(double x, void* model);
 const double hittingTimeDensity(
     double& x, ModelFunc fn, void* model, double& first, double& second
 );
+/**
+ * @brief Compute the normalized hitting-time density of an O-U kernel in
+ * closed form.
+ *
+ * With z(x) = sqrt(alpha / sigma^2) (x - mu), S(x) integrates to
+ * E(z) = exp(z^2) D(z) up to a constant, where D is Dawson's function, so
+ * the density is (E(z(x)) - E(z(b))) / (E(z(a)) - E(z(b))). Every E is
+ * scaled by exp(-m^2), m the largest |z|, so the terms cannot overflow
+ * however large alpha / sigma^2 is.
+ *
+ * @param x Point at which to evaluate.
+ * @param kernel The O-U hitting time kernel.
+ * @param first Left boundary value.
+ * @param second Right boundary value.
+ * @return const double Evaluated hitting-time density, or NaN when the closed
+ * form does not apply (alpha not positive) or would lose more than half of its
+ * digits to cancellation.
+ */
+const double hittingTimeDensityClosedForm(
+    const double x,
+    const HittingTimeOrnsteinUhlenbeck& kernel,
+    const double first,
+    const double second
+);
+/**
+ * @brief Compute the normalized hitting-time density of an O-U kernel,
+ * evaluating it in closed form with hittingTimeDensityClosedForm and falling
+ * back to the quadrature of hittingTimeDensity where the closed form does not
+ * apply.
+ *
+ * @param x Point at which to evaluate.
+ * @param kernel The O-U hitting time kernel.
+ * @param first Left boundary value.
+ * @param second Right boundary value.
+ * @return const double Evaluated hitting-time density.
+ */
+const double hittingTimeDensity(
+    const double x,
+    const HittingTimeOrnsteinUhlenbeck& kernel,
+    const double first,
+    const double second
+);
 #endif // STOCHASTIC_MODELS_HITTING_TIMES_HITTING_TIME_DENSITY_H
@@ -38,6 +38,14 @@ public:
    * x.
    */
   const double hittingTimeDensityCore(const double& x) const;
+  /**
+   * @brief Argument sqrt(alpha / sigma^2) (x - mu) whose square is, up to a
+   * constant, the exponent of the hitting time density core S(x).
+   *
+   * @param x The point at which to evaluate the argument.
+   * @return const double The argument sqrt(alpha / sigma^2) (x - mu).
+   */
+  const double hittingTimeDensityArgument(const double& x) const;
   /**
    * @brief Kernel function F(x,u,r) used in optimal trading integrals.
    * @param x The point x at which to evaluate the first hitting time density
@@ -62,6 +70,39 @@ public:
    */
   const double
   optimalTradingGCore(const double& x, const double& u, const double& r) const;
+  /**
+   * @brief Exponent nu = r / alpha of the power u^(nu - 1) in the F(x,u,r)
+   * and G(x,u,r) kernels.
+   *
+   * @param r The value r indicating the discount rate.
+   * @return const double The exponent r / alpha.
+   */
+  const double optimalTradingExponent(const double& r) const;
+  /**
+   * @brief Scale sqrt(2 alpha / sigma^2) applied to x - mu in the exponent of
+   * the F(x,u,r) and G(x,u,r) kernels.
+   *
+   * @return const double The scale sqrt(2 alpha / sigma^2).
+   */
+  const double optimalTradingScale() const;
+  /**
+   * @brief Coefficient sqrt(2 alpha / sigma^2) (x - mu) of u in the exponent
+   * of the F(x,u,r) kernel. The G(x,u,r) kernel uses its negation.
+   *
+   * @param x The point x at which the kernels are evaluated.
+   * @return const double The coefficient of u in the F(x,u,r) exponent.
+   */
+  const double optimalTradingDrift(const double& x) const;
+  /**
+   * @brief Discount rate r + alpha whose kernels carry one more power of u
+   * than those at r. Differentiating F(x;r) in x brings down a factor
+   * optimalTradingScale() u, so F'(x;r) is the scale times F(x;r + alpha),
+   * and likewise for G with the opposite sign.
+   *
+   * @param r The value r indicating the discount rate.
+   * @return const double The discount rate r + alpha.
+   */
+  const double optimalTradingDerivativeRate(const double& r) const;
   /**
    * @brief Computes the L*(r,c) optimal trading helper function.
    *
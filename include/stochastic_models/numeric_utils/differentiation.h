@@ -2,6 +2,8 @@
 #define STOCHASTIC_MODELS_NUMERIC_UTILS_DIFFERENTIATION_H
 #include "stochastic_models/numeric_utils/types.h"
 
+#include <type_traits>
+
 /**
  * @file
  * @brief Numeric differentiation helpers.
@@ -20,4 +22,20 @@
  */
 const double
 adaptiveCentralDifferentiation(ModelFunc fn, void* model, double& x);
+/**
+ * @brief Compute the derivative of a callable at x using
+ * adaptiveCentralDifferentiation.
+ *
+ * @param fn Callable taking x and returning f(x). It may capture its context
+ * by reference, as it is only adapted to a gsl_function inside the call.
+ * @param x Point at which to compute derivative.
+ * @return const double Approximated derivative value f'(x).
+ */
+template <typename Fn>
+  requires std::is_invocable_r_v<double, Fn&, double>
+const double differentiate(Fn&& fn, double x) {
+  return adaptiveCentralDifferentiation(
+      callableModelFunc<std::remove_reference_t<Fn>>, callablePointer(fn), x
+  );
+}
 #endif // STOCHASTIC_MODELS_NUMERIC_UTILS_DIFFERENTIATION_H
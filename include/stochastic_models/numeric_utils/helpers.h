@@ -5,6 +5,7 @@
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_integration.h>
 #include <gsl/gsl_roots.h>
+#include <span>
 #include <vector>
 
 /**
@@ -25,10 +26,10 @@
  * @p ignore_codes.
  *
  * @param status Status code returned by a GSL routine (GSL_SUCCESS == 0).
- * @param ignore_codes Vector of GSL error codes that should be ignored.
+ * @param ignore_codes GSL error codes that should be ignored.
  */
 void check_function_status(
-    const int& status, const std::vector<int> ignore_codes
+    const int& status, std::span<const int> ignore_codes
 );
 
 /**
@@ -2,7 +2,10 @@
 #define STOCHASTIC_MODELS_NUMERIC_UTILS_INTEGRATION_H
 #include "stochastic_models/numeric_utils/types.h"
 
+#include <cstddef>
 #include <gsl/gsl_integration.h>
+#include <type_traits>
+#include <vector>
 
 /**
  * @file
@@ -10,25 +13,133 @@
  */
 
 /**
- * @brief RAII wrapper for a GSL integration workspace.
+ * @brief Pool of reusable GSL integration workspaces.
  *
- * This helper owns a gsl_integration_workspace pointer and ensures the
- * GSL workspace instance is correctly freed when the object is destroyed.
+ * Integrations lease a workspace for their duration and hand it back when
+ * the lease is destroyed, so repeated integrations reuse the same memory and
+ * nested integrations (an integrand that itself integrates) lease a second
+ * workspace instead of clobbering the first. Workspaces are only allocated
+ * when every pooled workspace is leased and are freed with the pool.
+ *
+ * A pool is not synchronised. By default each thread integrates with its own
+ * pool from threadIntegrationWorkspacePool; a caller-owned pool must not be
+ * used from several threads at once.
  */
-class IntegrationState {
+class IntegrationWorkspacePool {
 public:
-  gsl_integration_workspace* workspace;
   /**
-   * @brief Construct the RAII wrapper around an existing workspace reference.
+   * @brief Maximum number of subintervals of every pooled workspace.
+   */
+  static constexpr std::size_t workspace_size = 1000;
+
+  /**
+   * @brief RAII handle on a workspace leased from a pool.
+   */
+  class Lease {
+  public:
+    Lease(IntegrationWorkspacePool& pool, gsl_integration_workspace* w);
+    Lease(Lease&& other) noexcept;
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+    Lease& operator=(Lease&&) = delete;
+    /**
+     * @brief Return the leased workspace.
+     * @return gsl_integration_workspace* The workspace.
+     */
+    gsl_integration_workspace* get() const;
+    /**
+     * @brief Hand the workspace back to its pool.
+     */
+    ~Lease();
+
+  private:
+    // Pool the workspace is returned to.
+    IntegrationWorkspacePool* pool;
+    // The leased workspace.
+    gsl_integration_workspace* workspace;
+  };
+
+  IntegrationWorkspacePool() = default;
+  IntegrationWorkspacePool(const IntegrationWorkspacePool&) = delete;
+  IntegrationWorkspacePool& operator=(const IntegrationWorkspacePool&) = delete;
+  /**
+   * @brief Free every pooled workspace. All leases must have been released.
+   */
+  ~IntegrationWorkspacePool();
+  /**
+   * @brief Lease a workspace, allocating one only if none is free.
+   * @return Lease Handle returning the workspace when destroyed.
+   * @throws std::bad_alloc if GSL cannot allocate a new workspace.
+   */
+  Lease acquire();
+  /**
+   * @brief Return the number of workspaces allocated by the pool.
+   * @return const std::size_t Number of allocated workspaces.
+   */
+  const std::size_t allocated() const;
+
+private:
+  // Workspaces not currently leased.
+  std::vector<gsl_integration_workspace*> available;
+  // Number of workspaces allocated by the pool.
+  std::size_t total{0};
+};
+
+/**
+ * @brief Return the workspace pool of the calling thread, used by default by
+ * the integration routines.
+ *
+ * @return IntegrationWorkspacePool& The thread's pool.
+ */
+IntegrationWorkspacePool& threadIntegrationWorkspacePool();
+
+/**
+ * @brief Gauss-Jacobi quadrature rule on [0, 1] for the weight x^beta.
+ *
+ * The nodes and weights are computed once by GSL on construction, so
+ * integrating a smooth function against x^beta afterwards costs one
+ * evaluation per node. Integrals over [0, U] follow by scaling the nodes by U
+ * and the weights by U^(beta + 1).
+ */
+class GaussJacobiRule {
+public:
+  /**
+   * @brief Compute the rule.
    *
-   * The constructor takes a reference to a GSL workspace that is managed by
-   * this wrapper. The semantics mirror those in the implementation file.
+   * @param n The number of nodes.
+   * @param beta The exponent of the weight, greater than -1.
+   * @throws std::invalid_argument if n is zero or beta is not greater than -1.
    */
-  IntegrationState(gsl_integration_workspace& w);
+  GaussJacobiRule(const std::size_t n, const double beta);
+  GaussJacobiRule(const GaussJacobiRule&) = delete;
+  GaussJacobiRule& operator=(const GaussJacobiRule&) = delete;
+  ~GaussJacobiRule();
   /**
-   * @brief Free the underlying GSL workspace if present.
+   * @brief Return the number of nodes.
+   * @return const std::size_t The number of nodes.
    */
-  ~IntegrationState();
+  const std::size_t size() const;
+  /**
+   * @brief Return the exponent of the weight.
+   * @return const double The exponent beta.
+   */
+  const double getBeta() const;
+  /**
+   * @brief Return the nodes in [0, 1].
+   * @return const double* Pointer to size() nodes.
+   */
+  const double* nodes() const;
+  /**
+   * @brief Return the weights matching nodes().
+   * @return const double* Pointer to size() weights.
+   */
+  const double* weights() const;
+
+private:
+  // GSL workspace holding the nodes and weights.
+  gsl_integration_fixed_workspace* workspace;
+  // Exponent of the weight.
+  double beta;
 };
 
 /**
@@ -40,10 +151,16 @@ public:
  * @param lower Lower bound of integration (passed by reference to allow
  *              adaptive routines to modify it in some callers).
  * @param upper Upper bound of integration.
+ * @param pool Pool to lease the integration workspace from.
  * @return const double Value of the integral over [lower, upper].
  */
-const double
-adaptiveIntegration(ModelFunc fn, void* model, double& lower, double& upper);
+const double adaptiveIntegration(
+    ModelFunc fn,
+    void* model,
+    double& lower,
+    double& upper,
+    IntegrationWorkspacePool& pool = threadIntegrationWorkspacePool()
+);
 /**
  * @brief Integrates the function f over a semi-infinite interval [lower, +inf).
  *
@@ -51,8 +168,65 @@ adaptiveIntegration(ModelFunc fn, void* model, double& lower, double& upper);
  * @param model Opaque pointer passed to the function; used to carry model
  *              parameters or context.
  * @param lower Lower bound of the semi-infinite integral.
+ * @param pool Pool to lease the integration workspace from.
+ * @return const double Value of the integral over [lower, +inf).
+ */
+const double semiInfiniteIntegrationUpper(
+    ModelFunc fn,
+    void* model,
+    double& lower,
+    IntegrationWorkspacePool& pool = threadIntegrationWorkspacePool()
+);
+/**
+ * @brief Integrates a callable over [lower, upper] with adaptiveIntegration.
+ *
+ * The callable is only adapted to a gsl_function inside the call, so it may
+ * capture its context by reference instead of it being copied into a heap
+ * allocated params struct.
+ *
+ * @param fn Callable taking x and returning f(x).
+ * @param lower Lower bound of integration.
+ * @param upper Upper bound of integration.
+ * @param pool Pool to lease the integration workspace from.
+ * @return const double Value of the integral over [lower, upper].
+ */
+template <typename Fn>
+  requires std::is_invocable_r_v<double, Fn&, double>
+const double integrate(
+    Fn&& fn,
+    double lower,
+    double upper,
+    IntegrationWorkspacePool& pool = threadIntegrationWorkspacePool()
+) {
+  return adaptiveIntegration(
+      callableModelFunc<std::remove_reference_t<Fn>>,
+      callablePointer(fn),
+      lower,
+      upper,
+      pool
+  );
+}
+/**
+ * @brief Integrates a callable over [lower, +inf) with
+ * semiInfiniteIntegrationUpper.
+ *
+ * @param fn Callable taking x and returning f(x).
+ * @param lower Lower bound of the semi-infinite integral.
+ * @param pool Pool to lease the integration workspace from.
  * @return const double Value of the integral over [lower, +inf).
  */
-const double
-semiInfiniteIntegrationUpper(ModelFunc fn, void* model, double& lower);
+template <typename Fn>
+  requires std::is_invocable_r_v<double, Fn&, double>
+const double integrateUpper(
+    Fn&& fn,
+    double lower,
+    IntegrationWorkspacePool& pool = threadIntegrationWorkspacePool()
+) {
+  return semiInfiniteIntegrationUpper(
+      callableModelFunc<std::remove_reference_t<Fn>>,
+      callablePointer(fn),
+      lower,
+      pool
+  );
+}
 #endif // STOCHASTIC_MODELS_NUMERIC_UTILS_INTEGRATION_H
@@ -0,0 +1,105 @@
+#ifndef STOCHASTIC_MODELS_NUMERIC_UTILS_INTEGRATION_BATCH_H
+#define STOCHASTIC_MODELS_NUMERIC_UTILS_INTEGRATION_BATCH_H
+#include "stochastic_models/numeric_utils/integration.h"
+#include "stochastic_models/numeric_utils/parallel.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @file
+ * @brief Threaded fixed-order integration of families of integrals sharing a
+ * rule, kept apart from integration.h so that its includers do not pull in
+ * the threading helpers.
+ */
+
+/**
+ * @brief Number of parameter values integrated together by integrateBatch.
+ * Their running sums stay in a small stack array while each scaled node and
+ * weight is loaded once for all of them.
+ *
+ */
+inline constexpr std::size_t integration_batch_lanes = 16;
+/**
+ * @brief Smallest number of parameter values integrateBatch hands to a single
+ * worker thread.
+ *
+ */
+inline constexpr std::size_t integration_batch_block = 256;
+
+/**
+ * @brief Integrates a family of functions f(x, u) over u in [lower, upper]
+ * with a shared fixed-order rule, one integral per parameter value x.
+ *
+ * out[i] approximates the integral of (u - lower)^beta fn(xs[i], u) over
+ * [lower, upper], where beta is the exponent of the rule, so a GaussJacobiRule
+ * with beta = 0 gives Gauss-Legendre quadrature. The nodes and weights are
+ * scaled once for the whole batch and the integrand is evaluated node by node
+ * across integration_batch_lanes parameter values at a time. The sweep is
+ * plain scalar code: it only vectorizes if the compiler can inline and
+ * vectorize fn, which calls to std::exp and similar functions prevent without
+ * a vector math library. Batches larger than integration_batch_block are
+ * spread over threads with parallelFor.
+ *
+ * @param fn Callable taking x and u and returning f(x, u). It is called
+ * concurrently from several threads for large batches.
+ * @param xs The parameter values.
+ * @param out Receives the integrals, one per parameter value.
+ * @param rule The fixed-order rule shared by every integral.
+ * @param lower Lower bound of integration.
+ * @param upper Upper bound of integration.
+ * @throws std::invalid_argument if out and xs differ in size.
+ */
+template <typename Fn>
+  requires std::is_invocable_r_v<double, Fn&, double, double>
+void integrateBatch(
+    Fn&& fn,
+    std::span<const double> xs,
+    std::span<double> out,
+    const GaussJacobiRule& rule,
+    const double lower,
+    const double upper
+) {
+  if (out.size() != xs.size()) {
+    throw std::invalid_argument(
+        "Batch integration needs one output per parameter value."
+    );
+  }
+  const double width = upper - lower;
+  const double weight_scale = std::pow(width, rule.getBeta() + 1.0);
+  std::vector<double> nodes(rule.size()), weights(rule.size());
+  for (std::size_t j{0}; j < rule.size(); ++j) {
+    nodes[j] = lower + width * rule.nodes()[j];
+    weights[j] = weight_scale * rule.weights()[j];
+  }
+
+  parallelFor(
+      xs.size(),
+      integration_batch_block,
+      [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t first = begin; first < end;
+             first += integration_batch_lanes) {
+          const std::size_t lanes =
+              std::min(integration_batch_lanes, end - first);
+          std::array<double, integration_batch_lanes> sums{};
+          for (std::size_t j{0}; j < nodes.size(); ++j) {
+            const double u = nodes[j];
+            const double w = weights[j];
+            for (std::size_t k{0}; k < lanes; ++k) {
+              sums[k] += w * fn(xs[first + k], u);
+            }
+          }
+          for (std::size_t k{0}; k < lanes; ++k) {
+            out[first + k] = sums[k];
+          }
+        }
+      }
+  );
+}
+#endif // STOCHASTIC_MODELS_NUMERIC_UTILS_INTEGRATION_BATCH_H
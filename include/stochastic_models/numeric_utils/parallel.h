@@ -0,0 +1,190 @@
+#ifndef STOCHASTIC_MODELS_NUMERIC_UTILS_PARALLEL_H
+#define STOCHASTIC_MODELS_NUMERIC_UTILS_PARALLEL_H
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file
+ * @brief Minimal fork-join helpers used to spread independent work (such as
+ * simulated paths) across the available hardware threads.
+ */
+
+/**
+ * @brief Returns the number of worker threads the parallel helpers will use.
+ *
+ * Falls back to a single worker when the hardware concurrency cannot be
+ * determined.
+ *
+ * @return const unsigned int Number of worker threads (>= 1).
+ */
+const unsigned int hardwareWorkers();
+
+/**
+ * @brief Splits the index range [0, n) into contiguous blocks and invokes
+ * fn(begin, end) for every block, running the blocks concurrently.
+ *
+ * Blocks are never smaller than min_block indices so that short ranges are
+ * processed on the calling thread without spawning workers. The first
+ * exception thrown by any block is re-thrown on the calling thread once all
+ * workers have joined.
+ *
+ * @param n Number of indices to process.
+ * @param min_block Smallest number of indices handed to a single worker.
+ * @param fn Callable invoked as fn(std::size_t begin, std::size_t end).
+ */
+template <typename Fn>
+void parallelFor(const std::size_t n, const std::size_t min_block, Fn&& fn) {
+  if (n == 0) {
+    return;
+  }
+  const std::size_t block = std::max<std::size_t>(min_block, 1);
+  const std::size_t max_workers = (n + block - 1) / block;
+  const std::size_t workers =
+      std::min<std::size_t>(hardwareWorkers(), max_workers);
+
+  if (workers <= 1) {
+    fn(std::size_t{0}, n);
+    return;
+  }
+
+  // Round the per-worker share up to a whole number of blocks so that block
+  // boundaries (and anything keyed on them) do not depend on the number of
+  // workers.
+  const std::size_t blocks_per_worker = (max_workers + workers - 1) / workers;
+  const std::size_t share = blocks_per_worker * block;
+
+  std::exception_ptr error = nullptr;
+  std::mutex error_mutex;
+  {
+    std::vector<std::jthread> threads;
+    threads.reserve(workers - 1);
+    for (std::size_t begin = share; begin < n; begin += share) {
+      const std::size_t end = std::min(n, begin + share);
+      threads.emplace_back([&fn, &error, &error_mutex, begin, end]() {
+        try {
+          fn(begin, end);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(error_mutex);
+          if (!error) {
+            error = std::current_exception();
+          }
+        }
+      });
+    }
+    // The calling thread processes the first share itself.
+    try {
+      fn(std::size_t{0}, std::min(n, share));
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+/**
+ * @brief Index ranges shared between workers that steal from each other once
+ * their own range is exhausted.
+ *
+ * [0, n) starts split evenly between the workers. A worker claims indices
+ * from the front of its own range; when it is empty the worker takes the back
+ * half of the first non-empty range of another worker. Each range is packed
+ * into a single atomic word, so claims and steals are lock-free and every
+ * index is handed out exactly once.
+ */
+class WorkStealingRanges {
+public:
+  /**
+   * @brief Split [0, n) between workers.
+   *
+   * @param n Number of indices to hand out.
+   * @param workers Number of workers, at least one.
+   * @throws std::invalid_argument if workers is zero or n does not fit in 32
+   * bits.
+   */
+  WorkStealingRanges(const std::size_t n, const std::size_t workers);
+  WorkStealingRanges(const WorkStealingRanges&) = delete;
+  WorkStealingRanges& operator=(const WorkStealingRanges&) = delete;
+  /**
+   * @brief Claim the next index for a worker, stealing if its range is empty.
+   *
+   * @param worker The worker claiming the index.
+   * @param index Set to the claimed index.
+   * @return const bool Whether an index was claimed; false once every index
+   * has been handed out.
+   */
+  const bool next(const std::size_t worker, std::size_t& index);
+
+private:
+  /**
+   * @brief The range of one worker, on its own cache line so that claims by
+   * different workers do not contend.
+   */
+  struct alignas(64) Range {
+    // Begin in the low and end in the high 32 bits.
+    std::atomic<std::uint64_t> bounds;
+  };
+
+  // One range per worker.
+  std::vector<Range> ranges;
+};
+
+/**
+ * @brief Invokes fn(i) for every index in [0, n), balancing the indices over
+ * the available hardware threads with WorkStealingRanges.
+ *
+ * Suited to independent items of uneven cost, where the fixed blocks of
+ * parallelFor would leave workers idle. The first exception thrown by any
+ * call is re-thrown on the calling thread once all workers have joined; the
+ * remaining indices are still processed.
+ *
+ * @param n Number of indices to process.
+ * @param fn Callable invoked as fn(std::size_t index).
+ */
+template <typename Fn>
+void parallelForStealing(const std::size_t n, Fn&& fn) {
+  if (n == 0) {
+    return;
+  }
+  const std::size_t workers = std::min<std::size_t>(hardwareWorkers(), n);
+  WorkStealingRanges ranges(n, workers);
+
+  std::exception_ptr error = nullptr;
+  std::mutex error_mutex;
+  auto work = [&fn, &ranges, &error, &error_mutex](const std::size_t worker) {
+    std::size_t index{0};
+    while (ranges.next(worker, index)) {
+      try {
+        fn(index);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }
+  };
+  {
+    std::vector<std::jthread> threads;
+    threads.reserve(workers - 1);
+    for (std::size_t worker{1}; worker < workers; ++worker) {
+      threads.emplace_back(work, worker);
+    }
+    // The calling thread is the first worker.
+    work(0);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+#endif // STOCHASTIC_MODELS_NUMERIC_UTILS_PARALLEL_H
@@ -1,8 +1,13 @@
 #ifndef STOCHASTIC_MODELS_NUMERIC_UTILS_SOLVERS_H
 #define STOCHASTIC_MODELS_NUMERIC_UTILS_SOLVERS_H
+#include "stochastic_models/exceptions/errors.h"
 #include "stochastic_models/numeric_utils/types.h"
 
+#include <algorithm>
+#include <cmath>
 #include <gsl/gsl_roots.h>
+#include <stdexcept>
+#include <type_traits>
 
 /**
  * @file
@@ -10,7 +15,8 @@
  */
 
 /**
- * @brief RAII wrapper for a GSL root solver (Brent method).
+ * @brief RAII wrapper for a GSL bracketing root solver, using the Brent
+ * method unless another type is given.
  *
  * Owns solver memory and ensures proper cleanup on destruction.
  */
@@ -19,19 +25,288 @@ public:
   gsl_root_fsolver* fsolver;
   const gsl_root_fsolver_type* fsolver_type;
   BrentSolverState();
+  explicit BrentSolverState(const gsl_root_fsolver_type* type);
   ~BrentSolverState();
 };
 
 /**
- * @brief Uses the Brent method to find a root of fn in [lower, upper].
+ * @brief Root-finding method used by solveRoot.
+ *
+ */
+enum class RootMethod {
+  // GSL Brent-Dekker method, using function values only.
+  Brent,
+  // GSL bisection, using function values only.
+  Bisection,
+  // Newton's method, needing the derivative. Steps leaving the bracket or
+  // failing to halve it fall back to bisection.
+  Newton,
+  // Newton's method with Aitken acceleration of the last three iterates, as
+  // in GSL's Steffenson solver, safeguarded like Newton.
+  Steffenson
+};
+
+/**
+ * @brief Controls the method, tolerance and iteration budget of solveRoot.
+ *
+ */
+struct SolverOptions {
+  // Method used to find the root.
+  RootMethod method = RootMethod::Brent;
+  // Absolute tolerance on the bracket width, or the last step of the
+  // derivative methods.
+  double epsabs = 0.0;
+  // Relative tolerance on the bracket width, or the last step of the
+  // derivative methods.
+  double epsrel = 1e-4;
+  // Maximum number of iterations.
+  int max_iterations = 100;
+};
+
+/**
+ * @brief Root found by solveRoot with the work spent finding it.
+ *
+ */
+struct SolverResult {
+  // Approximated root.
+  double root;
+  // Final bracket around the root.
+  double lower;
+  double upper;
+  // Number of iterations performed.
+  int iterations;
+  // Whether the tolerance was met within the iteration budget.
+  bool converged;
+};
+
+/**
+ * @brief Interval over which a function changes sign, as found by
+ * expandBracket.
+ *
+ */
+struct RootBracket {
+  // Lower end of the interval.
+  double lower;
+  // Upper end of the interval.
+  double upper;
+};
+
+/**
+ * @brief Finds a root of fn in [lower, upper] with a bracketing method.
+ *
+ * @param fn Function pointer to the scalar function whose root is sought.
+ * @param model Opaque model/context pointer passed to fn.
+ * @param lower Lower bound of the bracketing interval.
+ * @param upper Upper bound of the bracketing interval.
+ * @param options Method, tolerances and iteration budget. The method must
+ * be Brent or Bisection as fn provides no derivative.
+ * @return const SolverResult The root, final bracket and iteration count.
+ * @throws std::invalid_argument if lower >= upper or the method needs a
+ * derivative.
+ * @throws NoSolutionError if fn does not change sign over the interval or is
+ * not finite at an iterate.
+ */
+const SolverResult solveRoot(
+    ModelFunc fn,
+    void* model,
+    const double lower,
+    const double upper,
+    const SolverOptions& options = SolverOptions()
+);
+/**
+ * @brief Finds a root of a function in [lower, upper] given its value and
+ * derivative, with any method. The bracketing methods ignore the
+ * derivative.
+ *
+ * @param fdf Function pointer evaluating the function and its derivative.
+ * @param model Opaque model/context pointer passed to fdf.
+ * @param lower Lower bound of the bracketing interval.
+ * @param upper Upper bound of the bracketing interval.
+ * @param options Method, tolerances and iteration budget.
+ * @return const SolverResult The root, final bracket and iteration count.
+ * @throws std::invalid_argument if lower >= upper.
+ * @throws NoSolutionError if the function does not change sign over the
+ * interval or is not finite at an iterate.
+ */
+const SolverResult solveRoot(
+    ModelFuncFdf fdf,
+    void* model,
+    const double lower,
+    const double upper,
+    const SolverOptions& options = SolverOptions()
+);
+
+/**
+ * @brief Finds a root of fn in [lower, upper] like solveRoot, but iterates
+ * even when fn does not change sign over the interval, and returns only the
+ * root.
  *
  * @param fn Function pointer to the scalar function whose root is sought.
  * @param model Opaque model/context pointer passed to fn. Contains model
  * instance that is being used.
- * @param lower Lower bound of the bracketing interval (may be updated).
- * @param upper Upper bound of the bracketing interval (may be updated).
+ * @param lower Lower bound of the bracketing interval, set to the final
+ * bracket's lower end.
+ * @param upper Upper bound of the bracketing interval, set to the final
+ * bracket's upper end.
+ * @param options Method, tolerances and iteration budget. The method must
+ * be Brent or Bisection as fn provides no derivative.
  * @return const double Approximated root value.
+ * @throws std::invalid_argument if lower >= upper or the method needs a
+ * derivative.
+ * @throws NoSolutionError if fn is not finite at an iterate or the tolerance
+ * is not met within the iteration budget.
+ */
+const double brentSolver(
+    ModelFunc fn,
+    void* model,
+    double& lower,
+    double& upper,
+    const SolverOptions& options = SolverOptions()
+);
+/**
+ * @brief Finds a root of a callable in [lower, upper] with solveRoot.
+ *
+ * The callable is only adapted to a gsl_function inside the call, so it may
+ * capture its context by reference instead of it being copied into a heap
+ * allocated params struct.
+ *
+ * @param fn Callable taking x and returning f(x).
+ * @param lower Lower bound of the bracketing interval.
+ * @param upper Upper bound of the bracketing interval.
+ * @param options Method, tolerances and iteration budget. The method must
+ * be Brent or Bisection as fn provides no derivative.
+ * @return const SolverResult The root, final bracket and iteration count.
+ */
+template <typename Fn>
+  requires std::is_invocable_r_v<double, Fn&, double>
+const SolverResult solve(
+    Fn&& fn,
+    const double lower,
+    const double upper,
+    const SolverOptions& options = SolverOptions()
+) {
+  return solveRoot(
+      callableModelFunc<std::remove_reference_t<Fn>>,
+      callablePointer(fn),
+      lower,
+      upper,
+      options
+  );
+}
+/**
+ * @brief Finds a root of a callable in [lower, upper] given its value and
+ * derivative, with any method.
+ *
+ * @param fdf Callable taking x, f and df that sets f and df to the function
+ * value and derivative at x.
+ * @param lower Lower bound of the bracketing interval.
+ * @param upper Upper bound of the bracketing interval.
+ * @param options Method, tolerances and iteration budget.
+ * @return const SolverResult The root, final bracket and iteration count.
+ */
+template <typename Fn>
+  requires std::is_invocable_v<Fn&, double, double&, double&>
+const SolverResult solve(
+    Fn&& fdf,
+    const double lower,
+    const double upper,
+    const SolverOptions& options = SolverOptions()
+) {
+  return solveRoot(
+      callableModelFuncFdf<std::remove_reference_t<Fn>>,
+      callablePointer(fdf),
+      lower,
+      upper,
+      options
+  );
+}
+/**
+ * @brief Finds an interval around a guess over which a callable changes sign,
+ * searching no further than [lower, upper].
+ *
+ * Starts from [guess - step, guess + step] and extends the end at which |fn|
+ * is smaller by a step that grows by the given factor each time, as that end
+ * is more likely to be nearer a root. Only the last extension is returned once
+ * it changes sign, so a good guess gives a bracket of about the initial step.
+ *
+ * @param fn Callable taking x and returning f(x).
+ * @param guess The point around which to search, clamped to [lower, upper].
+ * @param step The half width of the first interval.
+ * @param lower The lowest point searched.
+ * @param upper The highest point searched, which may be infinite.
+ * @param growth The factor by which each extension exceeds the last.
+ * @return const RootBracket An interval whose ends have opposite signs or one
+ * of which is a root.
+ * @throws std::invalid_argument if lower >= upper, step is not positive or
+ * growth is not greater than one.
+ * @throws NoSolutionError if fn is not finite at a point searched or does not
+ * change sign over [lower, upper].
  */
-const double
-brentSolver(ModelFunc fn, void* model, double& lower, double& upper);
+template <typename Fn>
+  requires std::is_invocable_r_v<double, Fn&, double>
+const RootBracket expandBracket(
+    Fn&& fn,
+    const double guess,
+    const double step,
+    const double lower,
+    const double upper,
+    const double growth = 2.0
+) {
+  if (!(lower < upper)) {
+    throw std::invalid_argument("Bracket limits must satisfy lower < upper.");
+  }
+  if (!(step > 0.0) || !(growth > 1.0)) {
+    throw std::invalid_argument(
+        "Bracket step must be positive and growth greater than one."
+    );
+  }
+  auto evaluate = [&](const double x) {
+    const double value = fn(x);
+    if (!std::isfinite(value)) {
+      throw NoSolutionError(
+          "Root finding solver failed due to no solution at a single point."
+      );
+    }
+    return value;
+  };
+  auto changesSign = [](const double first, const double second) {
+    return first == 0.0 || second == 0.0 || (first > 0.0) != (second > 0.0);
+  };
+
+  const double centre = std::clamp(guess, lower, upper);
+  // Ends of the interval searched so far and the function values at them.
+  double searched_lower = std::max(centre - step, lower);
+  double searched_upper = std::min(centre + step, upper);
+  double f_lower = evaluate(searched_lower);
+  double f_upper = evaluate(searched_upper);
+  if (changesSign(f_lower, f_upper)) {
+    return RootBracket{searched_lower, searched_upper};
+  }
+
+  for (double width = growth * step;; width *= growth) {
+    const bool lower_exhausted = searched_lower <= lower;
+    const bool upper_exhausted = searched_upper >= upper;
+    if (lower_exhausted && upper_exhausted) {
+      throw NoSolutionError("Function does not change sign over the interval.");
+    }
+    if (upper_exhausted ||
+        (!lower_exhausted && std::abs(f_lower) < std::abs(f_upper))) {
+      const double next = std::max(searched_lower - width, lower);
+      const double f_next = evaluate(next);
+      if (changesSign(f_next, f_lower)) {
+        return RootBracket{next, searched_lower};
+      }
+      searched_lower = next;
+      f_lower = f_next;
+    } else {
+      const double next = std::min(searched_upper + width, upper);
+      const double f_next = evaluate(next);
+      if (changesSign(f_upper, f_next)) {
+        return RootBracket{searched_upper, next};
+      }
+      searched_upper = next;
+      f_upper = f_next;
+    }
+  }
+}
 #endif // STOCHASTIC_MODELS_NUMERIC_UTILS_SOLVERS_H
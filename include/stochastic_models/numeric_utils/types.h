@@ -1,5 +1,7 @@
 #ifndef STOCHASTIC_MODELS_NUMERIC_UTILS_TYPES_H
 #define STOCHASTIC_MODELS_NUMERIC_UTILS_TYPES_H
+#include <memory>
+
 /**
  * @brief Function pointer type used by the numeric integration helpers.
  *
@@ -11,4 +13,50 @@
  * utilities.
  */
 typedef double (*ModelFunc)(double x, void* model);
+/**
+ * @brief Function pointer type that evaluates a function and its derivative
+ * together, following the fdf member of GSL's gsl_function_fdf.
+ *
+ * Evaluating both at once lets functions whose value and derivative share
+ * work, such as the optimal trading transforms, compute them in one pass.
+ */
+typedef void (*ModelFuncFdf)(double x, void* model, double* f, double* df);
+/**
+ * @brief ModelFunc evaluating a callable of type Fn passed as the opaque
+ * pointer.
+ *
+ * Instantiated once per callable type, so the call through GSL's function
+ * pointer lands in code where the body of the callable can be inlined.
+ *
+ * @param x The point at which to evaluate the callable.
+ * @param callable Pointer to the callable, as returned by callablePointer.
+ * @return double The value of the callable at x.
+ */
+template <typename Fn> double callableModelFunc(double x, void* callable) {
+  return (*static_cast<Fn*>(callable))(x);
+}
+/**
+ * @brief ModelFuncFdf evaluating a callable of type Fn, which writes the
+ * function value and derivative through its second and third arguments.
+ *
+ * @param x The point at which to evaluate the callable.
+ * @param callable Pointer to the callable, as returned by callablePointer.
+ * @param f Set to the function value at x.
+ * @param df Set to the derivative at x.
+ */
+template <typename Fn>
+void callableModelFuncFdf(double x, void* callable, double* f, double* df) {
+  (*static_cast<Fn*>(callable))(x, *f, *df);
+}
+/**
+ * @brief Returns the opaque pointer under which callableModelFunc and
+ * callableModelFuncFdf expect a callable. The callable is borrowed and must
+ * outlive every use of the pointer.
+ *
+ * @param fn The callable.
+ * @return void* Pointer to fn.
+ */
+template <typename Fn> void* callablePointer(Fn& fn) {
+  return const_cast<void*>(static_cast<const void*>(std::addressof(fn)));
+}
 #endif // STOCHASTIC_MODELS_NUMERIC_UTILS_TYPES_H
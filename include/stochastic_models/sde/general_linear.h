@@ -1,11 +1,19 @@
 #ifndef STOCHASTIC_MODELS_SDE_GENERAL_LINEAR_H
 #define STOCHASTIC_MODELS_SDE_GENERAL_LINEAR_H
-#include "stochastic_models/sde/stochastic_model.h"
+#include "stochastic_models/sde/path_stream.h"
+#include "stochastic_models/sde/stepping_kernel.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
 /**
  * @brief General Linear Model class that handles fitting, evaluating, and
  * simulating specifically the General Linear SDE model specification.
  */
-class GeneralLinearModel : public StochasticModel::StochasticModel {
+class GeneralLinearModel
+    : public SteppedStochasticModel<GeneralLinearModel> {
 private:
   /**
    * @brief The mean (mu parameter) of the General Linear model.
@@ -63,23 +71,81 @@ public:
    *
    * @param start The value to start the simulation at.
    * @param size The number of values to simulate.
+   * @param t The time increment of a single step, which may be fractional.
    * @return std::vector<double> A simulated model series.
    */
   std::vector<double> Simulate(
-      const double start, const unsigned int& size, const unsigned int& t
+      const double start, const unsigned int& size, const double& t
   ) const override;
   /**
-   * @brief Uses the Euler–Maruyama method for the approximate numerical
-   * solution of the general linear SDE process.
+   * @brief Simulates n_paths independent paths of n_steps values each (the
+   * first value of every path is start) into one contiguous step-major
+   * buffer: the value of path p at step s is stored at s * n_paths + p.
    *
-   * @param x The current value of the series.
-   * @param noise The random Gaussian noise to add to the series.
-   * @param t The time increment of a single step.
-   * @return const double The next value in the series.
+   * @param start The value to start every path at.
+   * @param n_paths The number of paths to simulate.
+   * @param n_steps The number of values per path (including start).
+   * @param dt The time increment of a single step.
+   * @param seed Seed for the random streams of the simulation.
+   * @return std::vector<double> Step-major buffer of n_steps * n_paths values.
    */
-  const double coreEquation(
-      const double& x, const double& noise, const unsigned int& t
-  ) const override;
+  std::vector<double> SimulatePaths(
+      const double start,
+      const std::size_t n_paths,
+      const std::size_t n_steps,
+      const double dt,
+      const std::uint64_t seed = std::random_device{}()
+  ) const;
+  /**
+   * @brief Simulates paths into a caller-provided step-major buffer. See the
+   * allocating overload for the layout.
+   *
+   * @param paths Output buffer of at least n_steps * n_paths values.
+   * @param start The value to start every path at.
+   * @param n_paths The number of paths to simulate.
+   * @param n_steps The number of values per path (including start).
+   * @param dt The time increment of a single step.
+   * @param seed Seed for the random streams of the simulation.
+   * @throws std::invalid_argument if the buffer is too small.
+   */
+  void SimulatePaths(
+      std::span<double> paths,
+      const double start,
+      const std::size_t n_paths,
+      const std::size_t n_steps,
+      const double dt,
+      const std::uint64_t seed
+  ) const;
+  /**
+   * @brief Returns a pull-based stream producing one simulated path in
+   * chunks of chunk_size values, using O(chunk_size) memory.
+   *
+   * @param start The value to start the path at.
+   * @param n_steps The number of values in the path (including start).
+   * @param dt The time increment of a single step.
+   * @param chunk_size The maximum number of values per chunk.
+   * @param seed Seed of the random stream.
+   * @param stream Id of the random stream; use distinct ids for independent
+   * paths.
+   * @return PathStream<GeneralLinearStepConstants> The path stream.
+   */
+  PathStream<GeneralLinearStepConstants> SimulateStream(
+      const double start,
+      const std::size_t n_steps,
+      const double dt,
+      const std::size_t chunk_size,
+      const std::uint64_t seed,
+      const std::uint64_t stream = 0
+  ) const;
+  /**
+   * @brief Returns the Euler–Maruyama stepping kernel for the approximate
+   * numerical solution of the general linear SDE process, as applied by
+   * coreEquation.
+   *
+   * @param dt The time increment of a single step.
+   * @return const GeneralLinearStepConstants The stepping kernel.
+   */
+  const GeneralLinearStepConstants coreKernel(const double dt) const;
   ~GeneralLinearModel() override;
 };
 #endif // STOCHASTIC_MODELS_SDE_GENERAL_LINEAR_H
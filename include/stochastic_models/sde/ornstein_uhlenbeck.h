@@ -1,12 +1,60 @@
 #ifndef STOCHASTIC_MODELS_SDE_ORNSTEIN_UHLENBECK_H
 #define STOCHASTIC_MODELS_SDE_ORNSTEIN_UHLENBECK_H
-#include "stochastic_models/sde/stochastic_model.h"
+#include "stochastic_models/sde/path_stream.h"
+#include "stochastic_models/sde/stepping_kernel.h"
+#include "stochastic_models/sde/variance_reduction.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+/**
+ * @brief Discretization used to advance an Ornstein-Uhlenbeck path by a time
+ * step dt.
+ *
+ */
+enum class DiscretizationScheme {
+  /**
+   * @brief The approximation implemented by coreEquation, with noise scaled by
+   * sigma * sqrt(dt).
+   */
+  EulerMaruyama,
+  /**
+   * @brief Samples the exact Gaussian transition of the process, with noise
+   * scaled by sigma * sqrt((1 - e^{-2 alpha dt}) / (2 alpha)).
+   */
+  Exact
+};
+/**
+ * @brief Controls how aggressively OrnsteinUhlenbeckModel::SimulateAdaptive
+ * coarsens its time steps.
+ *
+ */
+struct AdaptiveSimulationOptions {
+  // A step is only taken if the nearest level lies at least this many
+  // conditional standard deviations beyond the expected move of the step.
+  double distance_multiple = 4.0;
+  // The coarsest step is dt * 2^max_coarsening.
+  unsigned int max_coarsening = 6;
+};
+/**
+ * @brief A series sampled on a non-uniform time grid.
+ *
+ */
+struct TimedSeries {
+  // Times of the samples, starting at zero.
+  std::vector<double> times;
+  // Values of the series at the sample times.
+  std::vector<double> values;
+};
 /**
  * @brief Handles fitting, evaluating, and simulating specifically the
  * Ornstein-Uhlenbeck model specification.
  */
-class OrnsteinUhlenbeckModel : public StochasticModel::StochasticModel {
+class OrnsteinUhlenbeckModel
+    : public SteppedStochasticModel<OrnsteinUhlenbeckModel> {
 private:
   /**
    * @brief The mean of the Ornstein-Uhlenbeck model.
@@ -32,6 +80,8 @@ public:
   OrnsteinUhlenbeckModel(const OrnsteinUhlenbeckModel& other);
   /**
    * @brief Return a heap-allocated copy of the model (virtual constructor).
+   * Copying the model by value does not allocate and is preferred where the
+   * concrete type is known.
    * @return const OrnsteinUhlenbeckModel* Pointer to the new instance.
    */
   const OrnsteinUhlenbeckModel* clone() const override;
@@ -47,6 +97,23 @@ public:
    * @return const double The model unconditional variance.
    */
   const double getUnconditionalVariance() const override;
+  /**
+   * @brief Returns the mean of the process after time t given the value x at
+   * time zero, e.g. as the known mean of a control variate.
+   *
+   * @param x The value of the process at time zero.
+   * @param t The elapsed time.
+   * @return const double The conditional mean.
+   */
+  const double getConditionalMean(const double x, const double t) const;
+  /**
+   * @brief Returns the variance of the process after time t given its value
+   * at time zero, which approaches getUnconditionalVariance as t grows.
+   *
+   * @param t The elapsed time.
+   * @return const double The conditional variance.
+   */
+  const double getConditionalVariance(const double t) const;
   /**
    * @brief Produces a simulation using the parameters mu, alpha, and sigma of
    * size provided in the method arguments. Uses coreEquation to produce the
@@ -54,23 +121,160 @@ public:
    *
    * @param start The value to start the simulation at.
    * @param size The number of values to simulate.
+   * @param t The time increment of a single step, which may be fractional.
    * @return std::vector<double> A simulated model series.
    */
   std::vector<double> Simulate(
-      const double start, const unsigned int& size, const unsigned int& t
+      const double start, const unsigned int& size, const double& t
   ) const override;
   /**
-   * @brief Uses the Euler–Maruyama method for the approximate numerical
-   * solution of the Ornstein-Uhlenbeck process.
+   * @brief Produces a simulation of size values advanced by dt per step
+   * using the requested discretization scheme.
    *
-   * @param x The current value of the series.
-   * @param noise The random Gaussian noise to add to the series.
-   * @param t The time increment of a single step.
-   * @return const double The next value in the series.
+   * @param start The value to start the simulation at.
+   * @param size The number of values to simulate.
+   * @param dt The time increment of a single step.
+   * @param scheme The discretization used for each step.
+   * @return std::vector<double> A simulated model series.
    */
-  const double coreEquation(
-      const double& x, const double& noise, const unsigned int& t
-  ) const override;
+  std::vector<double> Simulate(
+      const double start,
+      const unsigned int& size,
+      const double dt,
+      const DiscretizationScheme scheme
+  ) const;
+  /**
+   * @brief Returns a pull-based stream producing one simulated path in
+   * chunks of chunk_size values, using O(chunk_size) memory.
+   *
+   * @param start The value to start the path at.
+   * @param n_steps The number of values in the path (including start).
+   * @param dt The time increment of a single step.
+   * @param chunk_size The maximum number of values per chunk.
+   * @param seed Seed of the random stream.
+   * @param stream Id of the random stream; use distinct ids for independent
+   * paths.
+   * @param scheme The discretization used for each step.
+   * @return PathStream<OrnsteinUhlenbeckStepConstants> The path stream.
+   */
+  PathStream<OrnsteinUhlenbeckStepConstants> SimulateStream(
+      const double start,
+      const std::size_t n_steps,
+      const double dt,
+      const std::size_t chunk_size,
+      const std::uint64_t seed,
+      const std::uint64_t stream = 0,
+      const DiscretizationScheme scheme = DiscretizationScheme::Exact
+  ) const;
+  /**
+   * @brief Simulates the process over a horizon on a multi-resolution time
+   * grid, taking fine steps of dt near the levels of interest and doubling
+   * the step (up to dt * 2^max_coarsening) while the process is far from all
+   * of them.
+   *
+   * Every step samples the exact transition, so the values at the returned
+   * times have the correct joint distribution whatever the step. A coarse
+   * step of length h is only taken when the distance to the nearest level
+   * exceeds the expected move over h plus distance_multiple conditional
+   * standard deviations, which keeps the chance of stepping over a level
+   * within a coarse step small. Without levels every step is as coarse as
+   * allowed. Step boundaries always fall on multiples of dt and the last
+   * sample is at the horizon rounded to a multiple of dt.
+   *
+   * @param start The value to start the simulation at.
+   * @param horizon The total time to simulate.
+   * @param dt The finest time step.
+   * @param levels The levels near which the finest step is used.
+   * @param options Controls the coarsening of the steps.
+   * @return TimedSeries The sample times and values.
+   * @throws std::invalid_argument if dt is not positive.
+   */
+  TimedSeries SimulateAdaptive(
+      const double start,
+      const double horizon,
+      const double dt,
+      std::span<const double> levels,
+      const AdaptiveSimulationOptions& options = {}
+  ) const;
+  /**
+   * @brief Returns the constants of the step recurrence for a time step.
+   *
+   * For the exact scheme the variance factor is evaluated with expm1 so it
+   * stays accurate for small alpha * dt, and tends to sigma * sqrt(dt) as
+   * alpha tends to zero.
+   *
+   * @param dt The time increment of a single step.
+   * @param scheme The discretization used for each step.
+   * @return const OrnsteinUhlenbeckStepConstants The step constants.
+   */
+  const OrnsteinUhlenbeckStepConstants
+  stepConstants(const double dt, const DiscretizationScheme scheme) const;
+  /**
+   * @brief Simulates n_paths independent paths of n_steps values each (the
+   * first value of every path is start) into one contiguous buffer.
+   *
+   * The buffer is step-major: the value of path p at step s is stored at
+   * index s * n_paths + p, so every step is a contiguous row across all paths.
+   * Paths are processed in fixed-size blocks spread over the available
+   * hardware threads and the step recurrence, whose constants are computed
+   * once by stepConstants, is applied to a whole row of a block at a time.
+   * Results depend only on the seed, not on the number of threads used.
+   *
+   * Antithetic and quasi-Monte Carlo noise (see VarianceReduction) reduce the
+   * number of paths needed for a given accuracy of estimates such as hitting
+   * probabilities; both keep the marginal law of every path exact.
+   *
+   * @param start The value to start every path at.
+   * @param n_paths The number of paths to simulate.
+   * @param n_steps The number of values per path (including start).
+   * @param dt The time increment of a single step.
+   * @param seed Seed for the random streams of the simulation.
+   * @param scheme The discretization used for each step.
+   * @param reduction How the noise of the paths is generated.
+   * @return std::vector<double> Step-major buffer of n_steps * n_paths values.
+   */
+  std::vector<double> SimulatePaths(
+      const double start,
+      const std::size_t n_paths,
+      const std::size_t n_steps,
+      const double dt,
+      const std::uint64_t seed = std::random_device{}(),
+      const DiscretizationScheme scheme = DiscretizationScheme::Exact,
+      const VarianceReduction reduction = VarianceReduction::None
+  ) const;
+  /**
+   * @brief Simulates paths into a caller-provided step-major buffer. See the
+   * allocating overload for the layout.
+   *
+   * @param paths Output buffer of at least n_steps * n_paths values.
+   * @param start The value to start every path at.
+   * @param n_paths The number of paths to simulate.
+   * @param n_steps The number of values per path (including start).
+   * @param dt The time increment of a single step.
+   * @param seed Seed for the random streams of the simulation.
+   * @param scheme The discretization used for each step.
+   * @param reduction How the noise of the paths is generated.
+   * @throws std::invalid_argument if the buffer is too small.
+   */
+  void SimulatePaths(
+      std::span<double> paths,
+      const double start,
+      const std::size_t n_paths,
+      const std::size_t n_steps,
+      const double dt,
+      const std::uint64_t seed,
+      const DiscretizationScheme scheme = DiscretizationScheme::Exact,
+      const VarianceReduction reduction = VarianceReduction::None
+  ) const;
+  /**
+   * @brief Returns the Euler–Maruyama stepping kernel for the approximate
+   * numerical solution of the Ornstein-Uhlenbeck process, as applied by
+   * coreEquation.
+   *
+   * @param dt The time increment of a single step.
+   * @return const OrnsteinUhlenbeckStepConstants The stepping kernel.
+   */
+  const OrnsteinUhlenbeckStepConstants coreKernel(const double dt) const;
 
   ~OrnsteinUhlenbeckModel() override;
 };
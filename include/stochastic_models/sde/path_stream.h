@@ -0,0 +1,162 @@
+#ifndef STOCHASTIC_MODELS_SDE_PATH_STREAM_H
+#define STOCHASTIC_MODELS_SDE_PATH_STREAM_H
+#include "stochastic_models/distributions/random.h"
+#include "stochastic_models/sde/stepping_kernel.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @file
+ * @brief Pull-based generator producing a simulated path chunk by chunk.
+ */
+
+/**
+ * @brief Generates a single simulated path in fixed-size chunks without ever
+ * materializing the whole path.
+ *
+ * Each call to next advances the path by up to chunk_size values and returns
+ * a view of them; the view stays valid until the following call. Memory use
+ * is O(chunk_size) regardless of the path length, so consumers can reduce
+ * the path on the fly (first-passage detection, P&L, likelihood, ...).
+ *
+ * The stream is also an input range of chunks:
+ * @code
+ * for (std::span<const double> chunk : model.SimulateStream(...)) { ... }
+ * @endcode
+ *
+ * The noise is drawn from stream `stream` of a PhiloxEngine seeded with seed
+ * in internal blocks of fixed size, so the path is identical for every chunk
+ * size and independent paths are obtained from distinct stream ids.
+ *
+ * @tparam Kernel The stepping kernel of the model.
+ */
+template <SteppingKernel Kernel>
+class PathStream {
+private:
+  // Number of standard normals drawn from the engine at a time.
+  static constexpr std::size_t noise_block = 256;
+
+  // Stepping kernel of the model for the stream's time step.
+  Kernel kernel;
+  // Random stream providing the noise.
+  PhiloxEngine engine;
+  // Buffer holding the most recent chunk.
+  std::vector<double> chunk;
+  // Buffered standard normal noise.
+  std::array<double, noise_block> noise;
+  // Position of the next unused value in noise.
+  std::size_t next_noise;
+  // Last value of the path produced so far.
+  double last;
+  // Number of values produced so far.
+  std::size_t produced;
+  // Total number of values in the path (including the start).
+  std::size_t n_steps;
+
+public:
+  /**
+   * @brief Construct a stream positioned before the first value.
+   *
+   * @param kernel The stepping kernel of the model.
+   * @param start The value to start the path at (the first value produced).
+   * @param n_steps The number of values in the path (including start).
+   * @param chunk_size The maximum number of values returned per chunk.
+   * @param seed Seed of the random stream.
+   * @param stream Id of the random stream.
+   * @throws std::invalid_argument if chunk_size is zero.
+   */
+  PathStream(
+      const Kernel& kernel,
+      const double start,
+      const std::size_t n_steps,
+      const std::size_t chunk_size,
+      const std::uint64_t seed,
+      const std::uint64_t stream = 0
+  )
+      : kernel(kernel), engine(seed, stream), chunk(chunk_size), noise{},
+        next_noise(noise_block), last(start), produced(0), n_steps(n_steps) {
+    if (chunk_size == 0) {
+      throw std::invalid_argument("Chunk size must be positive.");
+    }
+  }
+  /**
+   * @brief Produce the next chunk of the path.
+   *
+   * @return std::span<const double> The next values of the path; empty once
+   * all n_steps values have been produced.
+   */
+  std::span<const double> next() {
+    const std::size_t count = std::min(chunk.size(), n_steps - produced);
+    std::size_t i{0};
+    if (count > 0 && produced == 0) {
+      chunk[i++] = last;
+    }
+    for (; i < count; ++i) {
+      if (next_noise == noise_block) {
+        engine.fillNormal(noise);
+        next_noise = 0;
+      }
+      last = kernel(last, noise[next_noise++]);
+      chunk[i] = last;
+    }
+    produced += count;
+    return std::span<const double>(chunk.data(), count);
+  }
+  /**
+   * @brief Returns whether every value of the path has been produced.
+   * @return const bool True once the stream is exhausted.
+   */
+  const bool done() const { return produced == n_steps; }
+  /**
+   * @brief Returns the number of values produced so far.
+   * @return const std::size_t Index of the first value of the next chunk.
+   */
+  const std::size_t position() const { return produced; }
+
+  /**
+   * @brief Input iterator over the chunks of a PathStream.
+   */
+  class iterator {
+  private:
+    // The stream being iterated.
+    PathStream* owner;
+    // The current chunk.
+    std::span<const double> current;
+
+  public:
+    using iterator_concept = std::input_iterator_tag;
+    using value_type = std::span<const double>;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() : owner(nullptr), current() {}
+    explicit iterator(PathStream& stream)
+        : owner(&stream), current(stream.next()) {}
+    const value_type& operator*() const { return current; }
+    iterator& operator++() {
+      current = owner->next();
+      return *this;
+    }
+    void operator++(int) { ++*this; }
+    friend bool operator==(const iterator& it, std::default_sentinel_t) {
+      return it.current.empty();
+    }
+  };
+  /**
+   * @brief Returns an iterator at the next chunk of the stream.
+   * @return iterator Iterator producing the remaining chunks.
+   */
+  iterator begin() { return iterator(*this); }
+  /**
+   * @brief Returns the sentinel marking an exhausted stream.
+   * @return std::default_sentinel_t The end sentinel.
+   */
+  std::default_sentinel_t end() const { return std::default_sentinel; }
+};
+#endif // STOCHASTIC_MODELS_SDE_PATH_STREAM_H
@@ -0,0 +1,285 @@
+#ifndef STOCHASTIC_MODELS_SDE_STEPPING_KERNEL_H
+#define STOCHASTIC_MODELS_SDE_STEPPING_KERNEL_H
+#include "stochastic_models/distributions/quasi_random.h"
+#include "stochastic_models/distributions/random.h"
+#include "stochastic_models/numeric_utils/parallel.h"
+#include "stochastic_models/sde/stochastic_model.h"
+#include "stochastic_models/sde/variance_reduction.h"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @file
+ * @brief Compile-time stepping kernels for discretized SDE models.
+ *
+ * A stepping kernel is a small value type holding the per-step constants of
+ * a model for a fixed time step and mapping (x, z) to the next value for a
+ * standard normal z. Simulation loops are templated on the kernel so the step
+ * is inlined and vectorized rather than dispatched through the virtual
+ * StochasticModel::coreEquation for every value.
+ */
+
+/**
+ * @brief A callable advancing a model value by one step given standard normal
+ * noise.
+ */
+template <typename Kernel>
+concept SteppingKernel = std::copyable<Kernel> &&
+                         requires(const Kernel& kernel, double x, double z) {
+                           { kernel(x, z) } -> std::convertible_to<double>;
+                         };
+
+/**
+ * @brief Constants of the Ornstein-Uhlenbeck step recurrence
+ * x' = delta * x + drift + scale * z for a standard normal z. They depend
+ * only on the model parameters, dt and the discretization scheme, so are
+ * computed once per simulation.
+ *
+ */
+struct OrnsteinUhlenbeckStepConstants {
+  // Conditional mean factor e^{-alpha dt}.
+  double delta;
+  // Conditional mean offset mu * (1 - e^{-alpha dt}).
+  double drift;
+  // Standard deviation applied to the standard normal noise.
+  double scale;
+
+  /**
+   * @brief Advance x by one step.
+   * @param x The current value of the series.
+   * @param z Standard normal noise.
+   * @return double The next value in the series.
+   */
+  double operator()(const double x, const double z) const {
+    return delta * x + (drift + scale * z);
+  }
+};
+/**
+ * @brief Constants of the General Linear step recurrence
+ * x' = growth * x + scale * z for a standard normal z.
+ *
+ */
+struct GeneralLinearStepConstants {
+  // Growth factor e^{mu dt}.
+  double growth;
+  // Standard deviation applied to the standard normal noise.
+  double scale;
+
+  /**
+   * @brief Advance x by one step.
+   * @param x The current value of the series.
+   * @param z Standard normal noise.
+   * @return double The next value in the series.
+   */
+  double operator()(const double x, const double z) const {
+    return growth * x + scale * z;
+  }
+};
+
+/**
+ * @brief Number of paths advanced together by a single worker in
+ * simulatePathsWithKernel. Each block owns its own random stream so results
+ * do not depend on the thread count.
+ *
+ */
+inline constexpr std::size_t simulation_path_block = 256;
+
+/**
+ * @brief Simulates a single path in place.
+ *
+ * On entry values[0] holds the start value and values[1..] hold standard
+ * normal noise; on return values holds the simulated path.
+ *
+ * @param kernel The stepping kernel.
+ * @param values The noise buffer to overwrite with the path.
+ */
+template <SteppingKernel Kernel>
+void simulatePathWithKernel(const Kernel& kernel, std::span<double> values) {
+  for (std::size_t i{1}; i < values.size(); ++i) {
+    values[i] = kernel(values[i - 1], values[i]);
+  }
+}
+/**
+ * @brief Simulates n_paths paths of n_steps values each into a step-major
+ * buffer (path p at step s is stored at s * n_paths + p).
+ *
+ * Paths are processed in blocks of simulation_path_block spread over the
+ * available hardware threads. Block b draws its noise from stream b of a
+ * PhiloxEngine seeded with seed, and the kernel is applied to a whole row of
+ * a block at a time.
+ *
+ * With VarianceReduction::Antithetic the second half of every block is
+ * driven by the negated noise of the first half. With
+ * VarianceReduction::QuasiMonteCarlo path p takes point p of a Sobol
+ * sequence, digitally shifted by the last stream of the seed, as the leading
+ * Brownian bridge coordinates over its n_steps - 1 increments; coordinates
+ * beyond SobolSequence::max_dimensions come from the block's stream.
+ *
+ * @param kernel The stepping kernel.
+ * @param paths Output buffer of at least n_steps * n_paths values.
+ * @param start The value to start every path at.
+ * @param n_paths The number of paths to simulate.
+ * @param n_steps The number of values per path (including start).
+ * @param seed Seed for the random streams of the simulation.
+ * @param reduction How the noise of the paths is generated.
+ * @throws std::invalid_argument if the buffer is too small.
+ */
+template <SteppingKernel Kernel>
+void simulatePathsWithKernel(
+    const Kernel& kernel,
+    std::span<double> paths,
+    const double start,
+    const std::size_t n_paths,
+    const std::size_t n_steps,
+    const std::uint64_t seed,
+    const VarianceReduction reduction = VarianceReduction::None
+) {
+  if (paths.size() < n_paths * n_steps) {
+    throw std::invalid_argument(
+        "Output buffer is too small for the requested number of paths and "
+        "steps."
+    );
+  }
+  if (n_paths == 0 || n_steps == 0) {
+    return;
+  }
+  double* const out = paths.data();
+
+  std::fill_n(out, n_paths, start);
+  if (reduction == VarianceReduction::QuasiMonteCarlo) {
+    if (n_steps == 1) {
+      return;
+    }
+    const std::size_t increments = n_steps - 1;
+    const std::size_t quasi_dimensions =
+        std::min(increments, SobolSequence::max_dimensions);
+    const SobolSequence sobol(quasi_dimensions, seed);
+    const BrownianBridge bridge(increments);
+    parallelFor(
+        n_paths,
+        simulation_path_block,
+        [&](const std::size_t first, const std::size_t last) {
+          std::vector<double> normals(increments);
+          std::vector<double> noise(increments);
+          for (std::size_t begin = first; begin < last;
+               begin += simulation_path_block) {
+            const std::size_t width =
+                std::min(simulation_path_block, last - begin);
+            PhiloxEngine engine(seed, begin / simulation_path_block);
+
+            // Write each path's increments into its column, then step the
+            // block row by row as in the pseudo-random case.
+            for (std::size_t i = 0; i < width; ++i) {
+              sobol.normals(
+                  begin + i, std::span<double>(normals.data(), quasi_dimensions)
+              );
+              engine.fillNormal(
+                  std::span<double>(normals).subspan(quasi_dimensions)
+              );
+              bridge.transform(normals, noise);
+              for (std::size_t step = 1; step < n_steps; ++step) {
+                out[step * n_paths + begin + i] = noise[step - 1];
+              }
+            }
+            for (std::size_t step = 1; step < n_steps; ++step) {
+              const double* previous = out + (step - 1) * n_paths + begin;
+              double* current = out + step * n_paths + begin;
+              for (std::size_t i = 0; i < width; ++i) {
+                current[i] = kernel(previous[i], current[i]);
+              }
+            }
+          }
+        }
+    );
+    return;
+  }
+  parallelFor(
+      n_paths,
+      simulation_path_block,
+      [=](const std::size_t first, const std::size_t last) {
+        std::array<double, simulation_path_block> noise;
+        for (std::size_t begin = first; begin < last;
+             begin += simulation_path_block) {
+          const std::size_t width =
+              std::min(simulation_path_block, last - begin);
+          // Each block draws from its own stream of the seeded engine.
+          PhiloxEngine engine(seed, begin / simulation_path_block);
+          // Antithetic blocks draw half the noise and mirror it; a half block
+          // is still long enough for the bulk kernel of fillNormal.
+          const std::size_t drawn = reduction == VarianceReduction::Antithetic
+                                        ? (width + 1) / 2
+                                        : width;
+
+          for (std::size_t step = 1; step < n_steps; ++step) {
+            engine.fillNormal(std::span<double>(noise.data(), drawn));
+            for (std::size_t i = drawn; i < width; ++i) {
+              noise[i] = -noise[i - drawn];
+            }
+            const double* previous = out + (step - 1) * n_paths + begin;
+            double* current = out + step * n_paths + begin;
+            for (std::size_t i = 0; i < width; ++i) {
+              current[i] = kernel(previous[i], noise[i]);
+            }
+          }
+        }
+      }
+  );
+}
+
+/**
+ * @brief CRTP base connecting a model's compile-time stepping kernel to the
+ * runtime-polymorphic StochasticModel interface.
+ *
+ * Derived must provide coreKernel(dt), returning the SteppingKernel applied
+ * by coreEquation. The virtual coreEquation is implemented once here as a
+ * thin adapter over that kernel, while simulation loops in the derived class
+ * call the kernel directly.
+ *
+ * @tparam Derived The concrete model type.
+ */
+template <typename Derived>
+class SteppedStochasticModel : public StochasticModel {
+protected:
+  /**
+   * @brief Simulates n_steps steps from start with the model distribution
+   * providing the noise.
+   *
+   * @param kernel The stepping kernel.
+   * @param start The value to start the simulation at.
+   * @param n_steps The number of steps to take.
+   * @return std::vector<double> The n_steps + 1 simulated values.
+   */
+  template <SteppingKernel Kernel>
+  std::vector<double> simulateSteps(
+      const Kernel& kernel, const double start, const std::size_t n_steps
+  ) const {
+    std::vector<double> values(n_steps + 1);
+    values[0] = start;
+    dist.fill(std::span<double>(values).subspan(1));
+    simulatePathWithKernel(kernel, values);
+    return values;
+  }
+
+public:
+  /**
+   * @brief Applies the model's stepping kernel for time step t to x.
+   *
+   * @param x The current value of the series.
+   * @param noise The random Gaussian noise to add to the series.
+   * @param t The time increment of a single step.
+   * @return const double The next value in the series.
+   */
+  const double coreEquation(
+      const double& x, const double& noise, const double& t
+  ) const final {
+    return static_cast<const Derived&>(*this).coreKernel(t)(x, noise);
+  }
+};
+#endif // STOCHASTIC_MODELS_SDE_STEPPING_KERNEL_H
@@ -1,17 +1,44 @@
 #ifndef STOCHASTIC_MODELS_SDE_STOCHASTIC_MODEL_H
 #define STOCHASTIC_MODELS_SDE_STOCHASTIC_MODEL_H
 #include "stochastic_models/distributions/gaussian.h"
+
+#include <cstdint>
 /**
  * Stochastic Model base class that handles functionality for fitting,
  * analysing, and simulating statistical models. Should be treated as an
  * abstract class as most important functionality specific to a given model is
  * implemented in child classes.
+ *
+ * The noise distribution is held by value, so constructing or copying a
+ * model performs no heap allocation. A copy or clone keeps the seed of the
+ * original but draws from a random stream of its own, so copies used for
+ * separate simulations are independent. Call seed on a model or copy to
+ * reproduce its draws.
  */
 class StochasticModel {
 protected:
-  const GaussianDistribution* dist;
+  // Standard normal distribution providing the simulation noise.
+  GaussianDistribution dist;
 
 public:
+  StochasticModel() = default;
+  /**
+   * @brief Copy a model onto a random stream of its own.
+   *
+   * The copy keeps the seed of other and takes the next unused stream id,
+   * counting down from the largest, so it does not share the stream of other,
+   * of any other copy or of the small stream ids usually passed to seed.
+   *
+   * @param other The model to copy.
+   */
+  StochasticModel(const StochasticModel& other);
+  /**
+   * @brief Reset the random stream used by Simulate.
+   *
+   * @param seed Seed of the random stream.
+   * @param stream Id of the random stream.
+   */
+  void seed(const std::uint64_t seed, const std::uint64_t stream = 0);
   /**
    * @brief Construct a new StochasticModel object and return on heap memory
    * using the class' copy constructor in the caller instance
@@ -42,7 +69,7 @@ public:
    * @returns Random values drawn from coreEquation.
    */
   virtual std::vector<double> Simulate(
-      const double start, const unsigned int& size, const unsigned int& t
+      const double start, const unsigned int& size, const double& t
   ) const = 0;
 
   /**
@@ -55,7 +82,7 @@ public:
    * @returns Core equation evaluated at x.
    */
   virtual const double coreEquation(
-      const double& x, const double& noise, const unsigned int& t
+      const double& x, const double& noise, const double& t
   ) const = 0;
 
   virtual ~StochasticModel() = 0;
@@ -0,0 +1,66 @@
+#ifndef STOCHASTIC_MODELS_SDE_VARIANCE_REDUCTION_H
+#define STOCHASTIC_MODELS_SDE_VARIANCE_REDUCTION_H
+#include <span>
+
+/**
+ * @file
+ * @brief Variance reduction techniques for Monte Carlo estimates built on
+ * simulated paths.
+ */
+
+/**
+ * @brief How the noise driving a batch of simulated paths is generated.
+ *
+ */
+enum class VarianceReduction {
+  /**
+   * @brief Independent pseudo-random noise for every path.
+   */
+  None,
+  /**
+   * @brief Paths come in antithetic pairs driven by noise z and -z, which
+   * cancels the odd moments of the noise in every estimate.
+   */
+  Antithetic,
+  /**
+   * @brief The leading Brownian bridge coordinates of every path are taken
+   * from a randomly shifted Sobol sequence (padded with pseudo-random noise
+   * beyond its dimension limit).
+   */
+  QuasiMonteCarlo
+};
+
+/**
+ * @brief A Monte Carlo estimate adjusted with a control variate.
+ *
+ */
+struct ControlVariateEstimate {
+  // The adjusted estimate of the mean of the samples.
+  double value;
+  // The standard error of the adjusted estimate.
+  double standard_error;
+  // The fitted control coefficient.
+  double beta;
+};
+
+/**
+ * @brief Estimates the mean of samples using controls with a known mean.
+ *
+ * The estimate is mean(Y) - beta (mean(C) - control_mean) with the variance
+ * minimising coefficient beta = cov(Y, C) / var(C) fitted from the samples.
+ * For Ornstein-Uhlenbeck paths the terminal value with the conditional mean
+ * from OrnsteinUhlenbeckModel::getConditionalMean is a natural control.
+ *
+ * @param samples The sampled values Y.
+ * @param controls The control values C paired with the samples.
+ * @param control_mean The known expectation of the controls.
+ * @return const ControlVariateEstimate The adjusted estimate.
+ * @throws std::invalid_argument if the spans differ in size or hold fewer
+ * than two samples.
+ */
+const ControlVariateEstimate controlVariateEstimate(
+    std::span<const double> samples,
+    std::span<const double> controls,
+    const double control_mean
+);
+#endif // STOCHASTIC_MODELS_SDE_VARIANCE_REDUCTION_H
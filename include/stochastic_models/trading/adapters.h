@@ -0,0 +1,41 @@
+#ifndef STOCHASTIC_MODELS_TRADING_ADAPTERS_H
+#define STOCHASTIC_MODELS_TRADING_ADAPTERS_H
+
+#include "stochastic_models/trading/transform_table.h"
+
+#include <string>
+
+/**
+ * @file
+ * @brief JSON adapters used to serialize/deserialize optimal trading tables.
+ */
+
+/**
+ * @brief Handles serialization and deserialization to and from JSON for
+ * `TransformTable` objects, so tables can be built once and reused across
+ * processes.
+ */
+class TransformTableJsonAdapter {
+public:
+  /**
+   * @brief Serializes a TransformTable object to a JSON string.
+   *
+   * @param table The TransformTable object to serialize.
+   * @return std::string The JSON string representation of the TransformTable
+   * object.
+   */
+  const std::string serialize(const TransformTable& table) const;
+  /**
+   * @brief Deserialize a JSON string into a `TransformTable` instance.
+   *
+   * @param state JSON string containing the table fields.
+   * @return TransformTable Reconstructed table.
+   * @throws TransformTableParseError if the JSON is malformed or a field is
+   * missing.
+   * @throws std::invalid_argument if the fields do not form a valid table,
+   * including a non-finite or non-positive exponent or tolerance.
+   */
+  const TransformTable deserialize(const std::string& state) const;
+};
+
+#endif // STOCHASTIC_MODELS_TRADING_ADAPTERS_H
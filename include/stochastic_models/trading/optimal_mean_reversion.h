@@ -3,20 +3,31 @@
 #include "stochastic_models/hitting_times/hitting_time_ornstein_uhlenbeck.h"
 #include "stochastic_models/sde/stochastic_model.h"
 #include "stochastic_models/trading/optimal_trading.h"
+#include "stochastic_models/trading/transform_cache.h"
+#include "stochastic_models/trading/transform_table.h"
+
+#include <memory>
 
 /**
- * @brief Optimal mean reversion trading model parameters.
+ * @brief Optimal mean reversion trading model parameters, borrowing the
+ * kernel.
  * @param hitting_time_kernel The hitting time kernel instance to use in
- * numerical integration.
+ * numerical integration, which must outlive the view.
  * @param x The current value of the stochastic model.
  * @param r The discount rate to apply to the optimal trading problem.
  *
  */
-struct OptimalMeanReversionParams {
+struct OptimalMeanReversionView {
   const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel;
   const double& x;
   const double& r;
-
+};
+/**
+ * @brief The OptimalMeanReversionView owning its kernel, which is deleted
+ * with it, so it must be heap allocated, usually as a clone.
+ *
+ */
+struct OptimalMeanReversionParams : OptimalMeanReversionView {
   ~OptimalMeanReversionParams();
 };
 /**
@@ -80,12 +91,94 @@ double funcOptimalMeanReversionF(double x, void* params);
  */
 double funcOptimalMeanReversionG(double x, void* params);
 
+/**
+ * @brief Quadrature used by OptimalMeanReversion to evaluate the transforms
+ * F(x;r) and G(x;r).
+ *
+ */
+enum class TransformQuadrature {
+  // Adaptive GSL integration over [0, inf) on every evaluation.
+  Adaptive,
+  // Precomputed Gauss-Jacobi rule for the weight u^(r / alpha - 1) over a
+  // truncated range, falling back to Adaptive outside the range of exponents
+  // and drifts for which it has been validated.
+  FixedOrder,
+  // Leading order of the transforms as r / alpha tends to zero, in closed
+  // form. Only accurate enough to place the brackets of the trading level
+  // solvers.
+  Asymptotic
+};
+
+/**
+ * @brief Coefficients of the value function C F(x;r) + D G(x;r) of a long
+ * position between the stop loss and the exit level b*. Without a stop loss D
+ * is zero and C is (b* - c) / F(b*;r).
+ *
+ * The coefficients are fixed once b* is known, so solving for d* and a*
+ * computes them once instead of on every evaluation of d and a.
+ */
+struct ValueFunctionCoefficients {
+  // Coefficient C of F(x;r).
+  double C;
+  // Coefficient D of G(x;r).
+  double D;
+};
+
 /**
  * @brief Concrete class that implements the optimal trading strategy for a mean
  * reverting model.
+ *
+ * The root functions b, d and a and the value function differentiate F and G
+ * analytically through transforms rather than numerically. The transforms
+ * are memoised in a TransformCache, which copies of the optimizer share, and
+ * may be interpolated from a TransformTable instead of integrated.
  */
 class OptimalMeanReversion : public OptimalTrading {
 public:
+  /**
+   * @brief Construct a new OptimalMeanReversion object.
+   *
+   * @param quadrature The quadrature used to evaluate F(x;r) and G(x;r).
+   */
+  explicit OptimalMeanReversion(
+      const TransformQuadrature quadrature = TransformQuadrature::FixedOrder
+  );
+  /**
+   * @brief Return the quadrature used to evaluate F(x;r) and G(x;r).
+   *
+   * @return const TransformQuadrature The quadrature.
+   */
+  const TransformQuadrature getQuadrature() const;
+  /**
+   * @brief Return the cache memoising transforms, shared with every copy of
+   * this optimizer.
+   *
+   * @return TransformCache* The cache, or nullptr if caching is disabled.
+   */
+  TransformCache* getTransformCache() const;
+  /**
+   * @brief Replace the cache memoising transforms, for example to share one
+   * cache between optimizers or to change its capacity and quantum. Entries
+   * are keyed by quadrature, so optimizers using different quadratures may
+   * share a cache.
+   *
+   * @param cache The new cache, or nullptr to disable caching.
+   */
+  void setTransformCache(std::shared_ptr<TransformCache> cache);
+  /**
+   * @brief Return the table interpolating the transforms, shared with every
+   * copy of this optimizer.
+   *
+   * @return const TransformTable* The table, or nullptr if none is set.
+   */
+  const TransformTable* getTransformTable() const;
+  /**
+   * @brief Answer F, G and transforms from a table wherever it covers the
+   * exponent and drift, integrating them elsewhere.
+   *
+   * @param table The table, or nullptr to always integrate.
+   */
+  void setTransformTable(std::shared_ptr<const TransformTable> table);
   /**
    * @brief Construct a new OptimalMeanReversion object and return on heap
    * memory using the class' copy constructor in the caller instance
@@ -125,6 +218,26 @@ public:
     const double& x,
     const double& r,
     const double& c) const override;
+  /**
+   * @brief Calculates F(x;r), G(x;r) and their derivatives in x together.
+   *
+   * Differentiating under the integral sign brings down a factor
+   * sqrt(2 alpha / sigma^2) u, so with the fixed-order quadrature all four
+   * values come from a single sweep over the rule. The adaptive quadrature
+   * integrates the derivatives as the transforms at the discount rate
+   * r + alpha.
+   *
+   * @param hitting_time_kernel Pointer to the hitting time kernel instance to
+   * use in the transforms.
+   * @param x The current value x at which to evaluate the transforms.
+   * @param r The discount rate to apply to the optimal trading problem.
+   * @return const OptimalTradingTransforms F, F', G and G' at x.
+   */
+  const OptimalTradingTransforms transforms(
+      const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
+      const double& x,
+      const double& r
+  ) const;
   /**
    * @brief Calculates the value L* for the optimal trading strategy.
    *
@@ -261,6 +374,88 @@ public:
     const double& b_star,
     const double& r,
     const double& c) const override;
+  /**
+   * @brief Calculates the coefficients of the value function for the exit
+   * level b*.
+   *
+   * @param hitting_time_kernel Pointer to the hitting time kernel to use in
+   * the value function.
+   * @param b_star The optimal exit level.
+   * @param r The discount rate to apply to the optimal trading problem.
+   * @param c The cost of trading.
+   * @return const ValueFunctionCoefficients The coefficients C and D = 0.
+   */
+  const ValueFunctionCoefficients valueFunction(
+      const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
+      const double& b_star,
+      const double& r,
+      const double& c
+  ) const;
+  /**
+   * @brief Calculates the coefficients of the value function for the exit
+   * level b* and a stop loss level.
+   *
+   * @param hitting_time_kernel Pointer to the hitting time kernel to use in
+   * the value function.
+   * @param b_star The optimal exit level.
+   * @param stop_loss The stop loss level to use in the optimal trading.
+   * @param r The discount rate to apply to the optimal trading problem.
+   * @param c The cost of trading.
+   * @return const ValueFunctionCoefficients The coefficients C and D.
+   */
+  const ValueFunctionCoefficients valueFunction(
+      const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
+      const double& b_star,
+      const double& stop_loss,
+      const double& r,
+      const double& c
+  ) const;
+  /**
+   * @brief Calculates the value d with value function coefficients computed
+   * once by valueFunction.
+   *
+   * @param value The value at which to evaluate the optimal entry level.
+   * @param hitting_time_kernel Pointer to the hitting time kernel to use in
+   * the function d.
+   * @param coefficients The value function coefficients for b_star and
+   * stop_loss.
+   * @param b_star The optimal exit level.
+   * @param stop_loss The stop loss level, or -infinity without a stop loss.
+   * @param r The discount rate to apply to the optimal trading problem.
+   * @param c The cost of trading.
+   * @return const double The value d.
+   */
+  const double
+  d(const double& value,
+    const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
+    const ValueFunctionCoefficients& coefficients,
+    const double& b_star,
+    const double& stop_loss,
+    const double& r,
+    const double& c) const;
+  /**
+   * @brief Calculates the value a with value function coefficients computed
+   * once by valueFunction.
+   *
+   * @param value The value at which to evaluate the optimal entry level.
+   * @param hitting_time_kernel Pointer to the hitting time kernel to use in
+   * the function a.
+   * @param coefficients The value function coefficients for b_star and
+   * stop_loss.
+   * @param b_star The optimal exit level.
+   * @param stop_loss The stop loss level.
+   * @param r The discount rate to apply to the optimal trading problem.
+   * @param c The cost of trading.
+   * @return const double The value a.
+   */
+  const double
+  a(const double& value,
+    const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
+    const ValueFunctionCoefficients& coefficients,
+    const double& b_star,
+    const double& stop_loss,
+    const double& r,
+    const double& c) const;
   /**
    * @brief Calculates the instantaneous rate of change
    * of the function fn at point x using a mean reverting model instance
@@ -390,5 +585,13 @@ public:
     const double& stop_loss,
     const double& r,
     const double& c) const override;
+
+private:
+  // Quadrature used to evaluate F(x;r) and G(x;r).
+  TransformQuadrature quadrature;
+  // Memo cache of transforms, shared by copies of the optimizer.
+  std::shared_ptr<TransformCache> cache;
+  // Table interpolating the transforms, shared by copies of the optimizer.
+  std::shared_ptr<const TransformTable> table;
 };
 #endif // STOCHASTIC_MODELS_TRADING_OPTIMAL_MEAN_REVERSION_H
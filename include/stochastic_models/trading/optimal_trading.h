@@ -18,6 +18,12 @@ public:
    * @return const OptimalTrading* Pointer to the new instance.
    */
   virtual const OptimalTrading* clone() const = 0;
+  /**
+   * @brief Virtual so that the trading levels params can delete the clones
+   * they own through an OptimalTrading pointer.
+   *
+   */
+  virtual ~OptimalTrading() = default;
   /**
    * @brief Abstract method that calculates F(x;r) for the optimal
    * trading strategy.
@@ -186,7 +192,7 @@ public:
    * overloaded version requires a stop loss level to be provided.
    *
    * @param fn The function with which to calculate the instantaneous rate of
-   * change.
+   * change, called with a pointer to an EntryLevelStopLossView.
    * @param model The model to use in calculating the instantaneous rate of
    * change.
    * @param x The point at which to calculate the instantaneous rate of
@@ -215,7 +221,7 @@ public:
    * of the function fn at point x using the model pointed to by model.
    *
    * @param fn The function with which to calculate the instantaneous rate of
-   * change.
+   * change, called with a pointer to an EntryLevelView.
    * @param model The model to use in calculating the instantaneous rate of
    * change.
    * @param x The point at which to calculate the instantaneous rate of
@@ -242,7 +248,7 @@ public:
    * of the function fn at point x using the model pointed to by model.
    *
    * @param fn The function with which to calculate the instantaneous rate of
-   * change.
+   * change, called with a pointer to an ExitLevelView.
    * @param model The model to use in calculating the instantaneous rate of
    * change.
    * @param x The point at which to calculate the instantaneous rate of
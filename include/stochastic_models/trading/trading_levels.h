@@ -1,5 +1,6 @@
 #ifndef STOCHASTIC_MODELS_TRADING_TRADING_LEVELS_H
 #define STOCHASTIC_MODELS_TRADING_TRADING_LEVELS_H
+#include "stochastic_models/numeric_utils/solvers.h"
 #include "stochastic_models/trading/optimal_mean_reversion.h"
 #include "stochastic_models/trading/optimal_trading.h"
 #include "stochastic_models/trading/trading_levels_interface.h"
@@ -29,6 +30,12 @@ private:
    *              calculating trading strategy parameters
    */
   std::unique_ptr<OptimalMeanReversion> optimizer;
+  /**
+   * @brief Unique pointer to the optimizer evaluating the closed-form
+   *              approximation of the transforms, used to place the solver
+   *              brackets
+   */
+  std::unique_ptr<OptimalMeanReversion> approximation;
   /**
    * @brief Unique pointer to the stochastic model implementation representing
    *              the Ornstein-Uhlenbeck process
@@ -47,6 +54,7 @@ public:
   );
   const OptimalMeanReversion* getOptimizer() const;
   const OptimalMeanReversion* newOptimizer() const;
+  const OptimalMeanReversion* getApproximation() const;
   const StochasticModel* getModel() const;
   const StochasticModel* newModel() const;
   const HittingTimeOrnsteinUhlenbeck* getHittingTimeKernel() const;
@@ -88,16 +96,118 @@ public:
    * level.
    */
   const double optimalExitUpperBound() const;
+  /**
+   * @brief Calculates a bracket of the optimal exit level b* with a stop loss
+   * level.
+   *
+   * The root function is solved with the closed-form approximation of the
+   * transforms, and a bracket of the exact root function is sought around
+   * that guess within the exit level bounds. This costs a few evaluations of
+   * the exact root function and leaves a bracket a fraction of a stationary
+   * standard deviation wide.
+   *
+   * @param stop_loss The stop loss level.
+   * @param r The discount rate to apply to the optimal mean reversion trading
+   * problem.
+   * @param c The cost of trading.
+   * @return const RootBracket An interval over which the root function of b*
+   * changes sign.
+   * @throws NoSolutionError if the root function does not change sign within
+   * the exit level bounds.
+   */
+  const RootBracket optimalExitBracket(
+      const double& stop_loss, const double& r, const double& c
+  ) const;
+  /**
+   * @brief Calculates a bracket of the optimal exit level b*, as
+   * optimalExitBracket with a stop loss.
+   *
+   * @param r The discount rate to apply to the optimal mean reversion trading
+   * problem.
+   * @param c The cost of trading.
+   * @return const RootBracket An interval over which the root function of b*
+   * changes sign.
+   * @throws NoSolutionError if the root function does not change sign within
+   * the exit level bounds.
+   */
+  const RootBracket
+  optimalExitBracket(const double& r, const double& c) const;
+  /**
+   * @brief Calculates a bracket of the optimal entry level d* in
+   * [stop_loss, b*], as optimalExitBracket.
+   *
+   * @param b_star The optimal exit level b*.
+   * @param stop_loss The stop loss level.
+   * @param r The discount rate to apply to the optimal mean reversion trading
+   * problem.
+   * @param c The cost of trading.
+   * @return const RootBracket An interval over which the root function of d*
+   * changes sign.
+   * @throws NoSolutionError if the root function does not change sign over
+   * [stop_loss, b*].
+   */
+  const RootBracket optimalEntryBracket(
+      const double& b_star,
+      const double& stop_loss,
+      const double& r,
+      const double& c
+  ) const;
+  /**
+   * @brief Calculates a bracket of the optimal entry level d* in
+   * [optimalEntryLowerBound, b*], as optimalExitBracket.
+   *
+   * @param b_star The optimal exit level b*.
+   * @param r The discount rate to apply to the optimal mean reversion trading
+   * problem.
+   * @param c The cost of trading.
+   * @return const RootBracket An interval over which the root function of d*
+   * changes sign.
+   * @throws NoSolutionError if the root function does not change sign over
+   * [optimalEntryLowerBound, b*].
+   */
+  const RootBracket optimalEntryBracket(
+      const double& b_star, const double& r, const double& c
+  ) const;
+  /**
+   * @brief Calculates a bracket of the lower optimal entry level a* in
+   * [stop_loss, d*], as optimalExitBracket.
+   *
+   * @param d_star The upper optimal entry level d*.
+   * @param b_star The optimal exit level b*.
+   * @param stop_loss The stop loss level.
+   * @param r The discount rate to apply to the optimal mean reversion trading
+   * problem.
+   * @param c The cost of trading.
+   * @return const RootBracket An interval over which the root function of a*
+   * changes sign.
+   * @throws NoSolutionError if the root function does not change sign over
+   * [stop_loss, d*].
+   */
+  const RootBracket optimalEntryLowerBracket(
+      const double& d_star,
+      const double& b_star,
+      const double& stop_loss,
+      const double& r,
+      const double& c
+  ) const;
   /**
    * @brief Calculates the optimal exit level b*
    * for an optimal trading strategy with a stop loss level.
    *
+   * The root is sought over optimalExitBracket rather than over the exit level
+   * bounds. Where the root function has several roots there, the bracket holds
+   * one near the closed-form approximation, which need not be the root Brent's
+   * method would find over the full bounds.
+   *
    * @param stop_loss The stop loss level.
    * @param r The discount rate to apply to the optimal mean reversion trading
    * problem.
    * @param c The cost of trading.
    * @return const double The optimal trading exit level given a stop loss @f[
    b*.
+   * @throws NoSolutionError if the root function does not change sign within
+   * the exit level bounds. Solving over the full bounds used to return a value
+   * from the invalid bracket instead.
    */
   const double
   optimalExit(const double& stop_loss, const double& r, const double& c) const;
@@ -105,22 +215,38 @@ public:
    * @brief Calculates the optimal exit level b*
    * for an optimal trading strategy.
    *
+   * The root is sought over optimalExitBracket rather than over the exit level
+   * bounds. Where the root function has several roots there, the bracket holds
+   * one near the closed-form approximation, which need not be the root Brent's
+   * method would find over the full bounds.
+   *
    * @param r The discount rate to apply to the optimal mean reversion trading
    * problem.
    * @param c The cost of trading.
    * @return const double The optimal trading exit level b*.
+   * @throws NoSolutionError if the root function does not change sign within
+   * the exit level bounds. Solving over the full bounds used to return a value
+   * from the invalid bracket instead.
    */
   const double optimalExit(const double& r, const double& c) const;
   /**
    * @brief Calculates the optimal entry level d*
    * for an optimal trading strategy when a stop loss level is provided.
    *
+   * The root is sought over optimalEntryBracket rather than over [stop_loss,
+   * b*]. Where the root function has several roots there, the bracket holds one
+   * near the closed-form approximation, which need not be the root Brent's
+   * method would find over the full bounds.
+   *
    * @param b_star The optimal exit level b*.
    * @param stop_loss The stop loss level.
    * @param r The discount rate to apply to the optimal mean reversion trading
    * problem.
    * @param c The cost of trading.
    * @return const double The optimal trading entry level d*.
+   * @throws NoSolutionError if the root function does not change sign over
+   * [stop_loss, b*]. Solving over the full bounds used to return a value from
+   * the invalid bracket instead.
    */
   const double optimalEntry(
       const double& b_star,
@@ -150,6 +276,11 @@ public:
    * @brief Calculates the lower bound optimal entry level a*
    * for an optimal trading strategy when a stop loss level is provided.
    *
+   * The root is sought over optimalEntryLowerBracket rather than over
+   * [stop_loss, d*]. Where the root function has several roots there, the
+   * bracket holds one near the closed-form approximation, which need not be the
+   * root Brent's method would find over the full bounds.
+   *
    * @param d_star The upper optimal entry level d*.
    * @param b_star The optimal exit level b*.
    * @param stop_loss The stop loss level.
@@ -158,6 +289,9 @@ public:
    * @param c The cost of trading.
    * @return const double The lower bound optimal trading entry level a*
    *.
+   * @throws NoSolutionError if the root function does not change sign over
+   * [stop_loss, d*]. Solving over the full bounds used to return a value from
+   * the invalid bracket instead.
    */
   const double optimalEntryLower(
       const double& d_star,
@@ -170,14 +304,119 @@ public:
    * @brief Calculates the optimal entry level d*
    * for an optimal trading strategy.
    *
+   * The root is sought over optimalEntryBracket rather than over
+   * [optimalEntryLowerBound, b*]. Where the root function has several roots
+   * there, the bracket holds one near the closed-form approximation, which need
+   * not be the root Brent's method would find over the full bounds.
+   *
    * @param b_star The optimal exit level b*.
    * @param r The discount rate to apply to the optimal mean reversion trading
    * problem.
    * @param c The cost of trading.
    * @return const double The optimal trading entry level d*.
+   * @throws NoSolutionError if the root function does not change sign over
+   * [optimalEntryLowerBound, b*]. Solving over the full bounds used to return a
+   * value from the invalid bracket instead.
    */
   const double
   optimalEntry(const double& b_star, const double& r, const double& c) const;
+  /**
+   * @brief Calculates b*, d* and a* together for an optimal trading strategy
+   * when a stop loss level is provided.
+   *
+   * The solver bounds are computed once, the root functions are evaluated
+   * without copying the optimizer or kernel, and the value function
+   * coefficients, which depend on F and G at b* and the stop loss, are
+   * computed once for both entry levels. Each level is solved over the
+   * bracket placed by the closed-form approximation, as in
+   * optimalExitBracket. As for the staged solves, it may then be a different
+   * root from the one Brent's method would find over the full bounds.
+   *
+   * @param stop_loss The stop loss level.
+   * @param r The discount rate to apply to the optimal mean reversion trading
+   * problem.
+   * @param c The cost of trading.
+   * @return const TradingLevelsSolution The levels b*, d* and a*.
+   * @throws NoSolutionError if a root function does not change sign over the
+   * bounds of its level.
+   */
+  const TradingLevelsSolution solveTradingLevels(
+      const double& stop_loss, const double& r, const double& c
+  ) const;
+  /**
+   * @brief Calculates b* and d* together for an optimal trading strategy.
+   *
+   * Without a stop loss the entry region is unbounded below, so a* is NaN.
+   *
+   * @param r The discount rate to apply to the optimal mean reversion trading
+   * problem.
+   * @param c The cost of trading.
+   * @return const TradingLevelsSolution The levels b*, d* and a* = NaN.
+   * @throws NoSolutionError if a root function does not change sign over the
+   * bounds of its level.
+   */
+  const TradingLevelsSolution
+  solveTradingLevels(const double& r, const double& c) const;
 };
 
+/**
+ * @brief Calculates b*, d* and a* together with a stop loss, as
+ * OrnsteinUhlenbeckTradingLevels::solveTradingLevels, from an optimizer and
+ * kernel owned by the caller.
+ *
+ * Unlike the member function it writes nothing on failure, so callers solving
+ * many parameter sets can record failures themselves. It also needs no
+ * OrnsteinUhlenbeckModel, whose construction seeds its noise.
+ *
+ * @param optimizer The optimizer evaluating the exact root functions.
+ * @param approximation The optimizer placing the brackets, usually with
+ * TransformQuadrature::Asymptotic.
+ * @param hitting_time_kernel The kernel of the process.
+ * @param upper_bound The highest level searched, as upperSolverBound. The
+ * entry levels are sought above the stop loss.
+ * @param stop_loss The stop loss level.
+ * @param r The discount rate to apply to the optimal mean reversion trading
+ * problem.
+ * @param c The cost of trading.
+ * @return const TradingLevelsSolution The levels b*, d* and a*.
+ * @throws NoSolutionError if a root function does not change sign over the
+ * bounds of its level.
+ */
+const TradingLevelsSolution solveOrnsteinUhlenbeckTradingLevelsStopLoss(
+    const OptimalMeanReversion* optimizer,
+    const OptimalMeanReversion* approximation,
+    const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
+    const double upper_bound,
+    const double stop_loss,
+    const double r,
+    const double c
+);
+/**
+ * @brief Calculates b* and d* together without a stop loss, as
+ * OrnsteinUhlenbeckTradingLevels::solveTradingLevels, from an optimizer and
+ * kernel owned by the caller. Writes nothing on failure.
+ *
+ * @param optimizer The optimizer evaluating the exact root functions.
+ * @param approximation The optimizer placing the brackets, usually with
+ * TransformQuadrature::Asymptotic.
+ * @param hitting_time_kernel The kernel of the process.
+ * @param lower_bound The lowest level searched, as lowerSolverBound.
+ * @param upper_bound The highest level searched, as upperSolverBound.
+ * @param r The discount rate to apply to the optimal mean reversion trading
+ * problem.
+ * @param c The cost of trading.
+ * @return const TradingLevelsSolution The levels b*, d* and a* = NaN.
+ * @throws NoSolutionError if a root function does not change sign over the
+ * bounds of its level.
+ */
+const TradingLevelsSolution solveOrnsteinUhlenbeckTradingLevels(
+    const OptimalMeanReversion* optimizer,
+    const OptimalMeanReversion* approximation,
+    const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
+    const double lower_bound,
+    const double upper_bound,
+    const double r,
+    const double c
+);
+
 #endif // STOCHASTIC_MODELS_TRADING_TRADING_LEVELS_H
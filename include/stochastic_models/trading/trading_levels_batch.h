@@ -0,0 +1,84 @@
+#ifndef STOCHASTIC_MODELS_TRADING_TRADING_LEVELS_BATCH_H
+#define STOCHASTIC_MODELS_TRADING_TRADING_LEVELS_BATCH_H
+#include <cstddef>
+#include <span>
+#include <vector>
+
+/**
+ * @file
+ * @brief Solves the optimal trading levels of many parameter sets at once.
+ */
+
+/**
+ * @brief Outcome of solving the trading levels of one parameter set.
+ *
+ */
+enum class TradingLevelsStatus {
+  // b*, d* and, with a stop loss, a* were found.
+  Solved,
+  // A level has no root within the solver bounds.
+  NoSolution,
+  // The parameters are not finite, or alpha or sigma is not positive.
+  InvalidArgument,
+  // Any other failure, such as a failed integration.
+  Failed
+};
+
+/**
+ * @brief Parameter sets of a batch as a structure of arrays, one element per
+ * set.
+ *
+ * Every span must have the same length, except stop_loss, which is either
+ * empty for trading without a stop loss or of the same length.
+ */
+struct TradingLevelsBatchParams {
+  // Long term mean of each series.
+  std::span<const double> mu;
+  // Mean reversion speed of each series.
+  std::span<const double> alpha;
+  // Volatility of each series.
+  std::span<const double> sigma;
+  // Discount rate of each set.
+  std::span<const double> r;
+  // Cost of trading of each set.
+  std::span<const double> c;
+  // Stop loss level of each set, or empty for no stop loss.
+  std::span<const double> stop_loss;
+};
+
+/**
+ * @brief Trading levels of a batch as a structure of arrays, one element per
+ * parameter set. Levels of sets that were not solved are NaN.
+ *
+ */
+struct TradingLevelsBatchResult {
+  // Optimal exit level b*.
+  std::vector<double> b_star;
+  // Optimal entry level d*.
+  std::vector<double> d_star;
+  // Lower optimal entry level a*, NaN without a stop loss as the entry
+  // region is then unbounded below.
+  std::vector<double> a_star;
+  // Outcome of each set.
+  std::vector<TradingLevelsStatus> status;
+};
+
+/**
+ * @brief Solve b*, d* and a* of the Ornstein-Uhlenbeck trading levels for
+ * every parameter set of a batch.
+ *
+ * Each set is solved with solveOrnsteinUhlenbeckTradingLevels, or its stop
+ * loss variant, from a kernel and optimizers built for the set, which gives the
+ * levels of OrnsteinUhlenbeckTradingLevels::solveTradingLevels without its
+ * model or its logging of failures. The sets are independent and their cost varies with how quickly the
+ * solvers converge, so they are scheduled over the hardware threads with
+ * parallelForStealing. A set that cannot be solved records its status and
+ * NaN levels rather than aborting the batch.
+ *
+ * @param params The parameter sets.
+ * @return const TradingLevelsBatchResult The levels and status of each set.
+ * @throws std::invalid_argument if the spans of params differ in length.
+ */
+const TradingLevelsBatchResult
+solveTradingLevelsBatch(const TradingLevelsBatchParams& params);
+#endif // STOCHASTIC_MODELS_TRADING_TRADING_LEVELS_BATCH_H
@@ -172,6 +172,32 @@ public:
    */
   const double
   optimalEntry(const double& b_star, const double& r, const double& c) const;
+  /**
+   * @brief Calculates b*, d* and a* in turn for an optimal trading strategy
+   * when a stop loss level is provided.
+   *
+   * @param stop_loss The stop loss level.
+   * @param r The discount rate to apply to the optimal mean reversion trading
+   * problem.
+   * @param c The cost of trading.
+   * @return const TradingLevelsSolution The levels b*, d* and a*.
+   */
+  const TradingLevelsSolution solveTradingLevels(
+      const double& stop_loss, const double& r, const double& c
+  ) const;
+  /**
+   * @brief Calculates b*, d* and a* in turn for an optimal trading strategy.
+   *
+   * Unlike the Ornstein-Uhlenbeck levels, the entry region of the exponential
+   * model is bounded below without a stop loss, so a* is finite.
+   *
+   * @param r The discount rate to apply to the optimal mean reversion trading
+   * problem.
+   * @param c The cost of trading.
+   * @return const TradingLevelsSolution The levels b*, d* and a*.
+   */
+  const TradingLevelsSolution
+  solveTradingLevels(const double& r, const double& c) const;
 };
 
 #endif // STOCHASTIC_MODELS_TRADING_TRADING_LEVELS_EXPONENTIAL_H
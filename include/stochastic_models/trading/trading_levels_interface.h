@@ -4,6 +4,24 @@
 
 #include <memory>
 
+/**
+ * @brief The optimal exit level b* and the entry levels d* and a* of a
+ * trading strategy.
+ *
+ * a* is NaN exactly when the entry region [a*, d*] is unbounded below, so that
+ * there is no lower entry level. For the Ornstein-Uhlenbeck levels that is
+ * the case without a stop loss. The entry region of the exponential levels is
+ * a bounded interval even without a stop loss, so their a* is finite.
+ */
+struct TradingLevelsSolution {
+  // Optimal exit level b*.
+  double b_star;
+  // Upper optimal entry level d*.
+  double d_star;
+  // Lower optimal entry level a*, NaN if the entry region is unbounded below.
+  double a_star;
+};
+
 /**
  * @brief Class for calculating the optimal trading levels.
  *
@@ -153,6 +171,33 @@ public:
   virtual const double optimalEntry(
       const double& b_star, const double& r, const double& c
   ) const = 0;
+  /**
+   * @brief Calculates b*, d* and a* together for an optimal trading strategy
+   * when a stop loss level is provided, sharing the quantities the stages
+   * have in common.
+   *
+   * @param stop_loss The stop loss level.
+   * @param r The discount rate to apply to the optimal mean reversion trading
+   * problem.
+   * @param c The cost of trading.
+   * @return const TradingLevelsSolution The levels b*, d* and a*.
+   */
+  virtual const TradingLevelsSolution solveTradingLevels(
+      const double& stop_loss, const double& r, const double& c
+  ) const = 0;
+  /**
+   * @brief Calculates b*, d* and a* together for an optimal trading strategy,
+   * sharing the quantities the stages have in common.
+   *
+   * @param r The discount rate to apply to the optimal mean reversion trading
+   * problem.
+   * @param c The cost of trading.
+   * @return const TradingLevelsSolution The levels b*, d* and a*, with a* NaN
+   * if the entry region is unbounded below without a stop loss (see
+   * TradingLevelsSolution).
+   */
+  virtual const TradingLevelsSolution
+  solveTradingLevels(const double& r, const double& c) const = 0;
 };
 
 #endif // STOCHASTIC_MODELS_TRADING_TRADING_LEVELS_INTERFACE_H
@@ -2,9 +2,22 @@
 #define STOCHASTIC_MODELS_TRADING_TRADING_LEVELS_PARAMS_H
 #include "stochastic_models/trading/optimal_trading.h"
 
+/**
+ * @file
+ * @brief Contexts passed to GSL as void pointers when solving for the trading
+ * levels.
+ *
+ * Each context comes in two forms. The view borrows the optimizer and kernel
+ * of the caller, which must outlive it, so the library builds it on the stack
+ * for its own solves. The params struct derives from the view without adding
+ * members and owns them: its destructor deletes the optimizer and kernel, so
+ * it is built from clones. The root functions below take a pointer to either.
+ */
+
 /**
  * @brief Optimal mean reversion trading model parameters for finding the
- * optimal exit level when a stop loss is provided.
+ * optimal exit level when a stop loss is provided, borrowing the optimizer
+ * and kernel.
  * @param optimizer The optimal trading instance to use when calculating the
  * optimal exit level.
  * @param hitting_time_kernel The kernel to use when calculating the optimal
@@ -13,18 +26,24 @@
  * @param r The discount rate to apply to the optimal trading problem.
  * @param c The cost of trading.
  */
-struct ExitLevelStopLossParams {
+struct ExitLevelStopLossView {
   const OptimalTrading* optimizer;
   const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel;
   const double& stop_loss;
   const double& r;
   const double& c;
-
+};
+/**
+ * @brief The ExitLevelStopLossView owning its optimizer and kernel, which are
+ * deleted with it, so both must be heap allocated, usually as clones.
+ *
+ */
+struct ExitLevelStopLossParams : ExitLevelStopLossView {
   ~ExitLevelStopLossParams();
 };
 /**
  * @brief Optimal mean reversion trading model parameters for finding the
- * optimal exit level.
+ * optimal exit level, borrowing the optimizer and kernel.
  *
  * @param optimizer The optimal trading instance to use when calculating the
  * optimal exit level.
@@ -33,17 +52,24 @@ struct ExitLevelStopLossParams {
  * @param r The discount rate to apply to the optimal trading problem.
  * @param c The cost of trading.
  */
-struct ExitLevelParams {
+struct ExitLevelView {
   const OptimalTrading* optimizer;
   const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel;
   const double& r;
   const double& c;
-
+};
+/**
+ * @brief The ExitLevelView owning its optimizer and kernel, which are
+ * deleted with it, so both must be heap allocated, usually as clones.
+ *
+ */
+struct ExitLevelParams : ExitLevelView {
   ~ExitLevelParams();
 };
 /**
  * @brief Optimal mean reversion trading model parameters for finding the
- * optimal entry level when a stop loss is provided.
+ * optimal entry level when a stop loss is provided, borrowing the optimizer
+ * and kernel.
  *
  * @param optimizer The optimal trading instance to use when calculating optimal
  * optimal entry level.
@@ -54,19 +80,25 @@ struct ExitLevelParams {
  * @param r The discount rate to apply to the optimal trading problem.
  * @param c The cost of trading.
  */
-struct EntryLevelStopLossParams {
+struct EntryLevelStopLossView {
   const OptimalTrading* optimizer;
   const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel;
   const double& b_star;
   const double& stop_loss;
   const double& r;
   const double& c;
-
+};
+/**
+ * @brief The EntryLevelStopLossView owning its optimizer and kernel, which are
+ * deleted with it, so both must be heap allocated, usually as clones.
+ *
+ */
+struct EntryLevelStopLossParams : EntryLevelStopLossView {
   ~EntryLevelStopLossParams();
 };
 /**
  * @brief Optimal mean reversion trading model parameters for finding the
- * optimal entry level.
+ * optimal entry level, borrowing the optimizer and kernel.
  *
  * @param optimizer The optimal trading instance to use when calculating optimal
  * optimal entry level.
@@ -76,13 +108,19 @@ struct EntryLevelStopLossParams {
  * @param r The discount rate to apply to the optimal trading problem.
  * @param c The cost of trading.
  */
-struct EntryLevelParams {
+struct EntryLevelView {
   const OptimalTrading* optimizer;
   const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel;
   const double& b_star;
   const double& r;
   const double& c;
-
+};
+/**
+ * @brief The EntryLevelView owning its optimizer and kernel, which are
+ * deleted with it, so both must be heap allocated, usually as clones.
+ *
+ */
+struct EntryLevelParams : EntryLevelView {
   ~EntryLevelParams();
 };
 /**
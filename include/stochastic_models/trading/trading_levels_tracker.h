@@ -0,0 +1,181 @@
+#ifndef STOCHASTIC_MODELS_TRADING_TRADING_LEVELS_TRACKER_H
+#define STOCHASTIC_MODELS_TRADING_TRADING_LEVELS_TRACKER_H
+#include "stochastic_models/likelihood/ornstein_uhlenbeck_likelihood.h"
+#include "stochastic_models/trading/optimal_mean_reversion.h"
+#include "stochastic_models/trading/trading_levels_interface.h"
+
+#include <cstddef>
+
+/**
+ * @file
+ * @brief Re-solves the optimal trading levels as the Ornstein-Uhlenbeck
+ * parameters drift, starting from the previous levels.
+ */
+
+/**
+ * @brief Tracks b*, d* and a* of the Ornstein-Uhlenbeck trading levels across
+ * updates of mu, alpha and sigma, such as those of an OrnsteinUhlenbeckUpdater.
+ *
+ * The levels are stored in units of the stationary standard deviation
+ * sqrt(sigma^2 / (2 alpha)) from the mean. On an update each level is sought
+ * around its previous value mapped to the new parameters, in a bracket of
+ * initial_bracket_width standard deviations that grows up to the bracket
+ * width until it holds the root. While alpha is unchanged the bracket is
+ * centred on the previous level corrected by a Newton step, whose derivative
+ * follows from the second derivatives F''(x;r) = scale^2 F(x; r + 2 alpha) of
+ * the transforms. When the parameters change slightly between updates the
+ * first bracket holds the root and Brent's method converges in a few
+ * evaluations of the root function. If any level is not bracketed, or a
+ * quadrature or solver fails, all of them are solved again over the full
+ * solver bounds with OrnsteinUhlenbeckTradingLevels::solveTradingLevels, as is
+ * the first update.
+ */
+class OrnsteinUhlenbeckTradingLevelsTracker {
+public:
+  /**
+   * @brief Half width of the first warm-started bracket in stationary
+   * standard deviations.
+   */
+  static constexpr double initial_bracket_width = 1e-3;
+  /**
+   * @brief Default largest half width of the warm-started brackets in
+   * stationary standard deviations.
+   */
+  static constexpr double default_bracket_width = 0.5;
+
+  /**
+   * @brief Track the trading levels with a stop loss.
+   *
+   * @param stop_loss The stop loss level.
+   * @param r The discount rate to apply to the optimal mean reversion trading
+   * problem.
+   * @param c The cost of trading.
+   */
+  OrnsteinUhlenbeckTradingLevelsTracker(
+      const double stop_loss, const double r, const double c
+  );
+  /**
+   * @brief Track the trading levels without a stop loss, for which a* is NaN.
+   *
+   * @param r The discount rate to apply to the optimal mean reversion trading
+   * problem.
+   * @param c The cost of trading.
+   */
+  OrnsteinUhlenbeckTradingLevelsTracker(const double r, const double c);
+  /**
+   * @brief Re-solve the levels for new parameters.
+   *
+   * @param mu The long term mean.
+   * @param alpha The mean reversion speed.
+   * @param sigma The volatility.
+   * @return const TradingLevelsSolution The levels b*, d* and a*.
+   * @throws std::invalid_argument if alpha or sigma is not positive.
+   * @throws NoSolutionError or another exception of
+   * OrnsteinUhlenbeckTradingLevels::solveTradingLevels if the full solve
+   * fails, in which case the previous levels are kept.
+   */
+  const TradingLevelsSolution
+  update(const double mu, const double alpha, const double sigma);
+  /**
+   * @brief Re-solve the levels for new parameters, as returned by
+   * OrnsteinUhlenbeckUpdater::updateState.
+   *
+   * @param parameters The new mu, alpha and sigma.
+   * @return const TradingLevelsSolution The levels b*, d* and a*.
+   */
+  const TradingLevelsSolution
+  update(const OrnsteinUhlenbeckParameters& parameters);
+  /**
+   * @brief Forget the previous levels, so that the next update is a full
+   * solve.
+   */
+  void reset();
+  /**
+   * @brief Set the largest half width of the warm-started brackets.
+   *
+   * @param width The half width in stationary standard deviations.
+   * @throws std::invalid_argument if width is not positive.
+   */
+  void setBracketWidth(const double width);
+  /**
+   * @brief Return the largest half width of the warm-started brackets.
+   * @return const double The half width in stationary standard deviations.
+   */
+  const double getBracketWidth() const;
+  /**
+   * @brief Return whether an update has solved the levels.
+   * @return const bool Whether getLevels holds levels.
+   */
+  const bool hasLevels() const;
+  /**
+   * @brief Return the levels of the last successful update.
+   * @return const TradingLevelsSolution The levels b*, d* and a*.
+   */
+  const TradingLevelsSolution getLevels() const;
+  /**
+   * @brief Return the number of updates solved from the previous levels.
+   * @return const std::size_t The number of warm-started updates.
+   */
+  const std::size_t warmStarts() const;
+  /**
+   * @brief Return the number of updates solved over the full solver bounds.
+   * @return const std::size_t The number of full solves.
+   */
+  const std::size_t fullSolves() const;
+
+private:
+  /**
+   * @brief Solve the levels for new parameters from the previous levels.
+   *
+   * @param mu The long term mean.
+   * @param alpha The mean reversion speed.
+   * @param sigma The volatility.
+   * @param deviation The stationary standard deviation.
+   * @return const bool Whether every level was found, in which case levels
+   * holds them. A level that is not bracketed or a quadrature or solver
+   * error leaves the levels unchanged.
+   */
+  const bool warmStart(
+      const double mu,
+      const double alpha,
+      const double sigma,
+      const double deviation
+  );
+  /**
+   * @brief Store the levels in stationary standard deviations from the mean.
+   *
+   * @param mu The long term mean.
+   * @param alpha The mean reversion speed.
+   * @param deviation The stationary standard deviation.
+   */
+  void store(const double mu, const double alpha, const double deviation);
+
+  // Optimizer evaluating the warm-started root functions, whose transform
+  // cache is kept across updates.
+  OptimalMeanReversion optimizer;
+  // Stop loss level, -infinity without a stop loss.
+  double stop_loss;
+  // Whether the levels have a stop loss.
+  bool has_stop_loss;
+  // Discount rate.
+  double r;
+  // Cost of trading.
+  double c;
+  // Largest half width of the warm-started brackets in stationary standard
+  // deviations.
+  double bracket_width{default_bracket_width};
+  // Whether levels holds the solution of a previous update.
+  bool solved{false};
+  // Levels of the last successful update.
+  TradingLevelsSolution levels{0.0, 0.0, 0.0};
+  // Levels of the last successful update in stationary standard deviations
+  // from the mean.
+  TradingLevelsSolution standardized{0.0, 0.0, 0.0};
+  // Mean reversion speed of the last successful update.
+  double levels_alpha{0.0};
+  // Number of updates solved from the previous levels.
+  std::size_t warm_count{0};
+  // Number of updates solved over the full solver bounds.
+  std::size_t full_count{0};
+};
+#endif // STOCHASTIC_MODELS_TRADING_TRADING_LEVELS_TRACKER_H
@@ -0,0 +1,187 @@
+#ifndef STOCHASTIC_MODELS_TRADING_TRANSFORM_CACHE_H
+#define STOCHASTIC_MODELS_TRADING_TRANSFORM_CACHE_H
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * @file
+ * @brief Memo cache for the optimal trading transforms F(x;r) and G(x;r).
+ */
+
+/**
+ * @brief The transforms F(x;r) and G(x;r) and their derivatives in x at a
+ * single point.
+ *
+ */
+struct OptimalTradingTransforms {
+  // F(x;r).
+  double F;
+  // The derivative of F(x;r) in x.
+  double F_prime;
+  // G(x;r).
+  double G;
+  // The derivative of G(x;r) in x.
+  double G_prime;
+};
+
+// Defined in optimal_mean_reversion.h.
+enum class TransformQuadrature;
+
+/**
+ * @brief Identifies the transforms at a point for a set of kernel parameters.
+ *
+ * The transforms depend on (x, r, mu, alpha, sigma) only through the exponent
+ * r / alpha, the scale sqrt(2 alpha / sigma^2) and the drift
+ * sqrt(2 alpha / sigma^2) (x - mu), so these three form the key together with
+ * the quadrature that evaluated them, as optimizers using different
+ * quadratures may share a cache.
+ */
+struct TransformCacheKey {
+  // The exponent r / alpha.
+  double exponent;
+  // The scale sqrt(2 alpha / sigma^2).
+  double scale;
+  // The drift sqrt(2 alpha / sigma^2) (x - mu).
+  double drift;
+  // The quadrature that evaluated the transforms.
+  TransformQuadrature quadrature;
+};
+
+/**
+ * @brief Extrapolate transforms to first order in x.
+ *
+ * @param transforms The transforms at a point.
+ * @param dx The displacement in x from that point.
+ * @return const OptimalTradingTransforms F and G moved along F' and G', with
+ * the derivatives unchanged.
+ */
+const OptimalTradingTransforms extrapolateTransforms(
+    const OptimalTradingTransforms& transforms, const double dx
+);
+
+/**
+ * @brief Least recently used cache of OptimalTradingTransforms.
+ *
+ * The trading level solvers evaluate the transforms at the fixed levels b*
+ * and the stop loss on every iteration, and revisit nearby points while
+ * converging, so a handful of entries saves most of the quadrature. Hit and
+ * miss counters report how much.
+ *
+ * Keys match exactly by default. With a positive quantum the drift is
+ * rounded to a multiple of it, so points in the same cell of width quantum
+ * share an entry holding the transforms at the cell's quantized drift, which
+ * are extrapolated to the point to first order. As
+ * F''(x;r) = scale^2 F(x; r + 2 alpha), with scale = sqrt(2 alpha / sigma^2),
+ * a point at most quantum / 2 in drift from the cell's drift is answered with
+ * an error of at most F(y; r + 2 alpha) quantum^2 / 8 in F and
+ * scale F(y; r + 2 alpha) quantum / 2 in F', for the largest F over the
+ * points y between them, and likewise for G.
+ *
+ * The cache is synchronised, so copies of an optimizer sharing it may be used
+ * from several threads.
+ */
+class TransformCache {
+public:
+  /**
+   * @brief Construct an empty cache.
+   *
+   * @param capacity The maximum number of entries, zero disabling the cache.
+   * @param quantum The spacing of the quantized drift, or zero to match keys
+   * exactly.
+   * @throws std::invalid_argument if quantum is negative.
+   */
+  explicit TransformCache(
+      const std::size_t capacity = 16, const double quantum = 0.0
+  );
+  TransformCache(const TransformCache&) = delete;
+  TransformCache& operator=(const TransformCache&) = delete;
+  /**
+   * @brief Look up the transforms of a key, counting a hit or a miss.
+   *
+   * @param key The key of the transforms.
+   * @param transforms Set to the cached transforms on a hit.
+   * @return const bool Whether the key was cached.
+   */
+  const bool
+  find(const TransformCacheKey& key, OptimalTradingTransforms& transforms);
+  /**
+   * @brief Cache the transforms of a key, evicting the least recently used
+   * entry when full.
+   *
+   * @param key The key of the transforms.
+   * @param transforms The transforms to cache, evaluated at the drift
+   * quantizedDrift(key.drift).
+   */
+  void insert(
+      const TransformCacheKey& key, const OptimalTradingTransforms& transforms
+  );
+  /**
+   * @brief Return the drift at which the entry of a drift holds the
+   * transforms.
+   *
+   * @param drift The drift of a point.
+   * @return const double The nearest multiple of the quantum, or drift when
+   * keys match exactly.
+   */
+  const double quantizedDrift(const double drift) const;
+  /**
+   * @brief Remove every entry and reset the counters.
+   */
+  void clear();
+  /**
+   * @brief Return the number of lookups answered from the cache.
+   * @return const std::size_t The number of hits.
+   */
+  const std::size_t hits() const;
+  /**
+   * @brief Return the number of lookups that had to compute the transforms.
+   * @return const std::size_t The number of misses.
+   */
+  const std::size_t misses() const;
+  /**
+   * @brief Return the number of cached entries.
+   * @return const std::size_t The number of entries.
+   */
+  const std::size_t size() const;
+  /**
+   * @brief Return the maximum number of entries.
+   * @return const std::size_t The capacity.
+   */
+  const std::size_t getCapacity() const;
+  /**
+   * @brief Return the spacing of the quantized drift.
+   * @return const double The quantum, zero when keys match exactly.
+   */
+  const double getQuantum() const;
+
+private:
+  /**
+   * @brief A cached key and its transforms.
+   */
+  struct Entry {
+    // The key, with the drift quantized if quantum is positive.
+    TransformCacheKey key;
+    // The cached transforms.
+    OptimalTradingTransforms transforms;
+    // Value of clock when the entry was last used.
+    std::uint64_t last_used;
+  };
+
+  // Guards every member below.
+  mutable std::mutex mutex;
+  // Cached entries, searched linearly as the cache is small.
+  std::vector<Entry> entries;
+  // Maximum number of entries.
+  std::size_t capacity;
+  // Spacing of the quantized drift.
+  double quantum;
+  // Incremented on every use of an entry to order them by recency.
+  std::uint64_t clock{0};
+  // Number of lookups answered from the cache.
+  std::size_t hit_count{0};
+  // Number of lookups not answered from the cache.
+  std::size_t miss_count{0};
+};
+#endif // STOCHASTIC_MODELS_TRADING_TRANSFORM_CACHE_H
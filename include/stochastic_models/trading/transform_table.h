@@ -0,0 +1,158 @@
+#ifndef STOCHASTIC_MODELS_TRADING_TRANSFORM_TABLE_H
+#define STOCHASTIC_MODELS_TRADING_TRANSFORM_TABLE_H
+#include "stochastic_models/hitting_times/hitting_time_ornstein_uhlenbeck.h"
+#include "stochastic_models/trading/transform_cache.h"
+
+#include <cstddef>
+#include <vector>
+
+class OptimalMeanReversion;
+
+/**
+ * @file
+ * @brief Chebyshev tabulation of the optimal trading transforms F(x;r) and
+ * G(x;r) and their derivatives.
+ */
+
+/**
+ * @brief Chebyshev interpolants of the transforms over one panel of drifts.
+ *
+ */
+struct TransformTablePanel {
+  // Lower end of the drifts covered by the panel.
+  double drift_lower;
+  // Upper end of the drifts covered by the panel.
+  double drift_upper;
+  // Chebyshev coefficients of log F, of its derivative in the drift, of log G
+  // and of its derivative in the drift over the panel.
+  std::vector<double> log_f;
+  std::vector<double> log_f_prime;
+  std::vector<double> log_g;
+  std::vector<double> log_g_prime;
+};
+
+/**
+ * @brief Piecewise Chebyshev interpolants of log F and log G over a range of
+ * x for a fixed exponent r / alpha.
+ *
+ * The transforms depend on x only through the drift
+ * z = sqrt(2 alpha / sigma^2) (x - mu), so the table is built over a range of
+ * drifts and answers any kernel with the same exponent. Interpolating the
+ * logarithms, and for the derivatives the logarithmic derivatives F' / F and
+ * G' / G, keeps the error relative over the exponential range of F and G.
+ *
+ * The range is bisected into panels of fixed degree until the interpolants of
+ * F, F', G and G' agree with the quadrature to the requested relative
+ * tolerance at the points halfway between the Chebyshev nodes of every panel,
+ * so an interpolation costs a short series per transform.
+ */
+class TransformTable {
+public:
+  /**
+   * @brief Number of Chebyshev intervals of every panel.
+   */
+  static constexpr std::size_t panel_degree = 16;
+  /**
+   * @brief Largest number of times the range is bisected into panels.
+   */
+  static constexpr std::size_t max_depth = 12;
+
+  /**
+   * @brief Tabulate the transforms of a kernel at a discount rate over
+   * [lower, upper], for example [lowerSolverBound, upperSolverBound].
+   *
+   * @param hitting_time_kernel The kernel whose transforms are tabulated.
+   * @param r The discount rate to apply to the optimal trading problem.
+   * @param lower The lower end of the tabulated range of x.
+   * @param upper The upper end of the tabulated range of x.
+   * @param tolerance The relative error allowed in F, F', G and G'.
+   * @throws std::invalid_argument if lower >= upper, tolerance is not
+   * positive or a panel does not reach the tolerance within max_depth
+   * bisections.
+   */
+  TransformTable(
+      const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
+      const double r,
+      const double lower,
+      const double upper,
+      const double tolerance = 1e-10
+  );
+  /**
+   * @brief Restore a table from its panels, as when deserializing.
+   *
+   * @param exponent The exponent r / alpha of the tabulated transforms.
+   * @param tolerance The relative error the table was built to.
+   * @param panels Contiguous panels in increasing order of drift.
+   * @throws std::invalid_argument if the exponent or tolerance is not finite
+   * and positive, there are no panels, they are not contiguous and
+   * increasing, or a panel has empty or unequal coefficient vectors.
+   */
+  TransformTable(
+      const double exponent,
+      const double tolerance,
+      std::vector<TransformTablePanel> panels
+  );
+  /**
+   * @brief Return whether the table answers the transforms with the given
+   * exponent at the given drift.
+   *
+   * @param exponent The exponent r / alpha.
+   * @param drift The drift sqrt(2 alpha / sigma^2) (x - mu).
+   * @return const bool Whether the exponent matches and the drift is in range.
+   */
+  const bool covers(const double exponent, const double drift) const;
+  /**
+   * @brief Interpolate F, F', G and G' at a drift covered by the table.
+   *
+   * @param scale The scale sqrt(2 alpha / sigma^2) of the kernel, which
+   * converts derivatives in the drift into derivatives in x.
+   * @param drift The drift sqrt(2 alpha / sigma^2) (x - mu).
+   * @return const OptimalTradingTransforms F, F', G and G'.
+   */
+  const OptimalTradingTransforms
+  transforms(const double scale, const double drift) const;
+  /**
+   * @brief Return the exponent r / alpha of the tabulated transforms.
+   * @return const double The exponent.
+   */
+  const double getExponent() const;
+  /**
+   * @brief Return the relative error the table was built to.
+   * @return const double The tolerance.
+   */
+  const double getTolerance() const;
+  /**
+   * @brief Return the panels of the table in increasing order of drift.
+   * @return const std::vector<TransformTablePanel>& The panels.
+   */
+  const std::vector<TransformTablePanel>& getPanels() const;
+
+private:
+  /**
+   * @brief Fit a panel over the drifts of [lower, upper], bisecting it until
+   * the tolerance is reached, and append the resulting panels.
+   *
+   * @param optimizer The optimizer integrating the transforms.
+   * @param hitting_time_kernel The kernel whose transforms are tabulated.
+   * @param r The discount rate to apply to the optimal trading problem.
+   * @param lower The lower end of the range of x.
+   * @param upper The upper end of the range of x.
+   * @param depth The number of bisections leading to the panel.
+   */
+  void fitPanel(
+      const OptimalMeanReversion& optimizer,
+      const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
+      const double r,
+      const double lower,
+      const double upper,
+      const std::size_t depth
+  );
+
+  // Exponent r / alpha of the tabulated transforms.
+  double exponent;
+  // Relative error the table was built to.
+  double tolerance;
+  // Contiguous panels in increasing order of drift.
+  std::vector<TransformTablePanel> panels;
+};
+#endif // STOCHASTIC_MODELS_TRADING_TRANSFORM_TABLE_H
@@ -6,19 +6,22 @@
  */
 
 #include "stochastic_models/entrypoints/ou_model.h"
+#include "stochastic_models/hitting_times/first_passage_monte_carlo.h"
 #include "stochastic_models/hitting_times/hitting_time_density.h"
 #include "stochastic_models/hitting_times/hitting_time_ornstein_uhlenbeck.h"
 #include "stochastic_models/likelihood/ornstein_uhlenbeck_likelihood.h"
 #include "stochastic_models/likelihood/ornstein_uhlenbeck_online.h"
 #include "stochastic_models/sde/ornstein_uhlenbeck.h"
 
+#include <limits>
+
 const std::vector<double> simulateOrnsteinUhlenbeck(
     const double& mu,
     const double& alpha,
     const double& sigma,
     const double start,
     const unsigned int& size,
-    const unsigned int& t
+    const double& t
 ) {
   // Create the Ornstein-Uhlenbeck process model
   OrnsteinUhlenbeckModel model(mu, alpha, sigma);
@@ -35,26 +38,41 @@ const double hittingTimeDensityOrnsteinUhlenbeck(
     double first,
     double second
 ) {
-  // Create core model as pointer to void because that type is required by
-  // GSL.
-  void* model = new HittingTimeOrnsteinUhlenbeck(mu, alpha, sigma);
-
-  // The ModelFunc is provided to determine which function to provide to
-  // GSL for integration.
-  ModelFunc fn = &integrateHittingTimeDensity;
-
-  // Calculate the hitting time density at point x given the arguments
-  // first and second.
-  const double value = hittingTimeDensity(x, fn, model, first, second);
-
-  // Then need to cast model back to OrnsteinUhlenbeckModel pointer to
-  // clean up.
-  HittingTimeOrnsteinUhlenbeck* ptr =
-      static_cast<HittingTimeOrnsteinUhlenbeck*>(model);
-  delete ptr;
-  ptr = nullptr;
-  model = nullptr;
-  return value;
+  // The closed form is used where it applies, otherwise the quadrature.
+  const HittingTimeOrnsteinUhlenbeck model(mu, alpha, sigma);
+  return hittingTimeDensity(x, model, first, second);
+}
+const std::unordered_map<std::string, const double>
+hittingTimeMonteCarloOrnsteinUhlenbeck(
+    const double x,
+    const double mu,
+    const double alpha,
+    const double sigma,
+    const double first,
+    const double second,
+    const std::size_t n_paths,
+    const double dt,
+    const double horizon,
+    const uint64_t seed
+) {
+  const OrnsteinUhlenbeckModel model(mu, alpha, sigma);
+  FirstPassageOptions options;
+  options.dt = dt;
+  options.horizon = horizon;
+  const FirstPassageEstimate estimate =
+      estimateFirstPassage(model, x, first, second, n_paths, seed, options);
+  const double median = estimate.exit_times.empty()
+                            ? std::numeric_limits<double>::quiet_NaN()
+                            : estimate.quantile(0.5);
+  const std::unordered_map<std::string, const double> key_value_pairs{
+      {"probability", estimate.probability},
+      {"standard_error", estimate.standard_error},
+      {"expected_time", estimate.expected_time},
+      {"median_time", median},
+      {"unresolved",
+       static_cast<double>(estimate.unresolved) / static_cast<double>(n_paths)}
+  };
+  return key_value_pairs;
 }
 const std::unordered_map<std::string, const double>
 ornsteinUhlenbeckMaximumLikelihood(const std::vector<double> vec) {
@@ -12,7 +12,6 @@
 #include "stochastic_models/trading/trading_levels_params.h"
 
 #include <cmath>
-#include <iostream>
 #include <stdexcept>
 const ExponentialMeanReversion* ExponentialMeanReversion::clone() const {
   return new ExponentialMeanReversion(*this);
@@ -23,39 +22,12 @@ const double ExponentialMeanReversion::F(
     const double& r,
     const double& c
 ) const {
-  // First create a deep copy of the model pointer and copy the contents of
-  // model into the temporary location. This is because we are going to
-  // free that memory in the destructor of the OptimalMeanReversionParams
-  // struct.
-  const HittingTimeOrnsteinUhlenbeck* temp_ptr = hitting_time_kernel->clone();
-
-  // Create new instance of the OptimalMeanReversionParams struct as a
-  // void pointer as this is required by the GSL numerical integration
-  // function.
-  void* params = new OptimalMeanReversionParams{temp_ptr, x, r};
-  ModelFunc fn = funcOptimalMeanReversionF;
-  double lower = 0;
-  double value{0.0};
-  try {
-    value = semiInfiniteIntegrationUpper(fn, params, lower);
-  } catch (const std::exception& e) {
-    std::cout << "Exception " << e.what()
-              << " caught in ExponentialMeanReversion::F." << std::endl;
-    delete static_cast<OptimalMeanReversionParams*>(params);
-    params = nullptr;
-    temp_ptr = nullptr;
-    throw;
-  }
-
-  // Then cast the void pointer back to the original type and free the memory.
-  OptimalMeanReversionParams* ptr =
-      static_cast<OptimalMeanReversionParams*>(params);
-  delete ptr;
-  ptr = nullptr;
-  params = nullptr;
-  temp_ptr = nullptr;
-
-  return value;
+  return integrateUpper(
+      [&](const double u) {
+        return hitting_time_kernel->optimalTradingFCore(x, u, r);
+      },
+      0.0
+  );
 }
 const double ExponentialMeanReversion::G(
     const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
@@ -63,39 +35,12 @@ const double ExponentialMeanReversion::G(
     const double& r,
     const double& c
 ) const {
-  // First create a deep copy of the model pointer and copy the contents of
-  // model into the temporary location. This is because we are going to free
-  // that memory in the destructor of the OptimalMeanReversionParams
-  // struct.
-  const HittingTimeOrnsteinUhlenbeck* temp_ptr = hitting_time_kernel->clone();
-
-  // Create new instance of the OptimalMeanReversionParams struct as a
-  // void pointer as this is required by the GSL numerical integration
-  // function.
-  void* params = new OptimalMeanReversionParams{temp_ptr, x, r};
-  ModelFunc fn = funcOptimalMeanReversionG;
-  double lower = 0;
-  double value{0.0};
-  try {
-    value = semiInfiniteIntegrationUpper(fn, params, lower);
-  } catch (const std::exception& e) {
-    std::cout << "Exception " << e.what()
-              << " caught in ExponentialMeanReversion::G." << std::endl;
-    delete static_cast<OptimalMeanReversionParams*>(params);
-    params = nullptr;
-    temp_ptr = nullptr;
-    throw;
-  }
-
-  // Then cast the void pointer back to the original type and free the memory.
-  OptimalMeanReversionParams* ptr =
-      static_cast<OptimalMeanReversionParams*>(params);
-  delete ptr;
-  ptr = nullptr;
-  params = nullptr;
-  temp_ptr = nullptr;
-
-  return value;
+  return integrateUpper(
+      [&](const double u) {
+        return hitting_time_kernel->optimalTradingGCore(x, u, r);
+      },
+      0.0
+  );
 }
 const double ExponentialMeanReversion::L_star(
     const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
@@ -147,9 +92,7 @@ const double ExponentialMeanReversion::d(
             funcV, hitting_time_kernel, value, b_star, r, c
         ) -
         std::exp(value))) -
-      (instantaneousDifferential(
-           funcG, hitting_time_kernel, value, b_star, r, c
-       ) *
+      (instantaneousDifferential(funcG, hitting_time_kernel, value, r, c) *
        (ExponentialMeanReversion::V(hitting_time_kernel, value, b_star, r, c) -
         std::exp(value) - c));
 
@@ -229,9 +172,7 @@ const double ExponentialMeanReversion::a(
             funcV, hitting_time_kernel, value, b_star, r, c
         ) -
         std::exp(value))) -
-      (instantaneousDifferential(
-           funcF, hitting_time_kernel, value, b_star, r, c
-       ) *
+      (instantaneousDifferential(funcF, hitting_time_kernel, value, r, c) *
        (ExponentialMeanReversion::V(hitting_time_kernel, value, b_star, r, c) -
         std::exp(value) - c));
   return result;
@@ -260,25 +201,13 @@ const double ExponentialMeanReversion::instantaneousDifferential(
     const double& r,
     const double& c
 ) const {
-  // Create a deep copy of the model and optimizer pointers to ensure that
-  // cleanup does not delete heap memory that is not owned by this scope.
-  const HittingTimeOrnsteinUhlenbeck* temp_kernel =
-      hitting_time_kernel->clone();
-  const ExponentialMeanReversion* temp_optimizer = clone();
-
   // Create copy to not modify the original value and
   // not provide to function that takes a non-const.
   double x_copied = x;
 
   // Adaptive differentiation function.
-  void* params =
-      new EntryLevelParams{temp_optimizer, temp_kernel, b_star, r, c};
-  double value = adaptiveCentralDifferentiation(fn, params, x_copied);
-  struct EntryLevelParams* p = static_cast<EntryLevelParams*>(params);
-  delete p;
-  p = nullptr;
-  params = nullptr;
-  return value;
+  EntryLevelView params{this, hitting_time_kernel, b_star, r, c};
+  return adaptiveCentralDifferentiation(fn, &params, x_copied);
 }
 const double ExponentialMeanReversion::instantaneousDifferential(
     ModelFunc fn,
@@ -287,21 +216,11 @@ const double ExponentialMeanReversion::instantaneousDifferential(
     const double& r,
     const double& c
 ) const {
-  // Create a deep copy of the model and optimizer pointers to ensure that
-  // cleanup does not delete heap memory that is not owned by this scope.
-  const HittingTimeOrnsteinUhlenbeck* temp_model = hitting_time_kernel->clone();
-  const ExponentialMeanReversion* temp_optimizer = clone();
-
   // Create copy to not modify the original value and
   // not provide to function that takes a non-const.
   double x_copied = x;
 
   // Adaptive differentiation function.
-  void* params = new ExitLevelParams{temp_optimizer, temp_model, r, c};
-  double value = adaptiveCentralDifferentiation(fn, params, x_copied);
-  struct ExitLevelParams* p = static_cast<ExitLevelParams*>(params);
-  delete p;
-  p = nullptr;
-  params = nullptr;
-  return value;
+  ExitLevelView params{this, hitting_time_kernel, r, c};
+  return adaptiveCentralDifferentiation(fn, &params, x_copied);
 }
@@ -0,0 +1,141 @@
+#include "stochastic_models/hitting_times/first_passage_monte_carlo.h"
+#include "stochastic_models/distributions/random.h"
+#include "stochastic_models/numeric_utils/parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+/**
+ * @brief Bridge crossing probabilities below this are treated as zero so no
+ * uniform is drawn for steps far from both levels.
+ *
+ */
+static constexpr double negligible_crossing = 1e-12;
+
+const double FirstPassageEstimate::quantile(const double p) const {
+  if (!(p >= 0.0 && p <= 1.0)) {
+    throw std::invalid_argument("Quantile probability must lie in [0, 1].");
+  }
+  if (exit_times.empty()) {
+    throw std::invalid_argument("No path was absorbed within the horizon.");
+  }
+  const double position = p * static_cast<double>(exit_times.size() - 1);
+  const std::size_t lower = static_cast<std::size_t>(position);
+  if (lower + 1 >= exit_times.size()) {
+    return exit_times.back();
+  }
+  const double weight = position - static_cast<double>(lower);
+  return (1.0 - weight) * exit_times[lower] + weight * exit_times[lower + 1];
+}
+
+const FirstPassageEstimate estimateFirstPassage(
+    const OrnsteinUhlenbeckModel& model,
+    const double x,
+    const double first,
+    const double second,
+    const std::size_t n_paths,
+    const std::uint64_t seed,
+    const FirstPassageOptions& options
+) {
+  const double lower = std::min(first, second);
+  const double upper = std::max(first, second);
+  if (!(x > lower && x < upper)) {
+    throw std::invalid_argument(
+        "Starting point must lie strictly between the levels."
+    );
+  }
+  if (n_paths == 0 || options.chunk_size == 0 || !(options.dt > 0.0) ||
+      !(options.horizon > 0.0)) {
+    throw std::invalid_argument(
+        "Number of paths, dt, horizon and chunk size must be positive."
+    );
+  }
+  const std::size_t max_steps =
+      static_cast<std::size_t>(std::ceil(options.horizon / options.dt));
+  const OrnsteinUhlenbeckStepConstants step =
+      model.stepConstants(options.dt, DiscretizationScheme::Exact);
+  const double bridge_scale = -2.0 / (step.scale * step.scale);
+
+  // Exit time of every path, or NaN while unresolved, and whether it left
+  // through the upper level.
+  std::vector<double> times(n_paths, std::numeric_limits<double>::quiet_NaN());
+  std::vector<char> exited_upper(n_paths, 0);
+
+  parallelFor(
+      n_paths,
+      simulation_path_block,
+      [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t path = begin; path < end; ++path) {
+          PathStream<OrnsteinUhlenbeckStepConstants> stream(
+              step, x, max_steps + 1, options.chunk_size, seed, path
+          );
+          // Crossing uniforms use a separate key so they never overlap the
+          // noise of any path.
+          PhiloxEngine crossings(~seed, path);
+          double previous = x;
+          std::size_t index{0};
+          for (std::span<const double> chunk : stream) {
+            for (const double& value : chunk) {
+              if (index++ == 0) {
+                continue;
+              }
+              bool hit_upper = value >= upper;
+              bool hit_lower = value <= lower;
+              if (!hit_upper && !hit_lower && options.bridge_correction) {
+                const double upper_crossing = std::exp(
+                    bridge_scale * (upper - previous) * (upper - value)
+                );
+                const double lower_crossing = std::exp(
+                    bridge_scale * (previous - lower) * (value - lower)
+                );
+                if (upper_crossing + lower_crossing > negligible_crossing) {
+                  const double u = crossings.uniform();
+                  hit_upper = u < upper_crossing;
+                  hit_lower = !hit_upper && u < upper_crossing + lower_crossing;
+                }
+              }
+              if (hit_upper || hit_lower) {
+                times[path] = static_cast<double>(index - 1) * options.dt;
+                exited_upper[path] = hit_upper;
+                break;
+              }
+              previous = value;
+            }
+            // Stop generating the path once it has been absorbed.
+            if (!std::isnan(times[path])) {
+              break;
+            }
+          }
+        }
+      }
+  );
+
+  FirstPassageEstimate estimate{0.0, 0.0, 0.0, 0, {}};
+  estimate.exit_times.reserve(n_paths);
+  std::size_t hits{0};
+  const bool first_is_upper = first > second;
+  for (std::size_t path{0}; path < n_paths; ++path) {
+    if (std::isnan(times[path])) {
+      ++estimate.unresolved;
+      continue;
+    }
+    if (static_cast<bool>(exited_upper[path]) == first_is_upper) {
+      ++hits;
+    }
+    estimate.exit_times.push_back(times[path]);
+    estimate.expected_time += times[path];
+  }
+  std::sort(estimate.exit_times.begin(), estimate.exit_times.end());
+  const double n = static_cast<double>(n_paths);
+  estimate.probability = static_cast<double>(hits) / n;
+  estimate.standard_error =
+      std::sqrt(estimate.probability * (1.0 - estimate.probability) / n);
+  estimate.expected_time =
+      estimate.exit_times.empty()
+          ? std::numeric_limits<double>::quiet_NaN()
+          : estimate.expected_time /
+                static_cast<double>(estimate.exit_times.size());
+  return estimate;
+}
@@ -2,10 +2,21 @@
 
 #include <cmath>
 #include <random>
-#include <time.h>
 GaussianDistribution::~GaussianDistribution() {}
 GaussianDistribution::GaussianDistribution(const double mu, const double sigma)
-    : mu(mu), sigma(sigma) {}
+    : GaussianDistribution(
+          mu,
+          sigma,
+          (static_cast<std::uint64_t>(std::random_device{}()) << 32) |
+              std::random_device{}()
+      ) {}
+GaussianDistribution::GaussianDistribution(
+    const double mu,
+    const double sigma,
+    const std::uint64_t seed,
+    const std::uint64_t stream
+)
+    : mu(mu), sigma(sigma), engine(seed, stream) {}
 GaussianDistribution::GaussianDistribution() : GaussianDistribution(0, 1.0) {}
 const double GaussianDistribution::getMean() const { // Returns class mean.
   return mu;
@@ -33,25 +44,35 @@ GaussianDistribution::cdf(const double& x) { // Produces cdf for a given x.
 }
 std::vector<double> GaussianDistribution::sample(
     const std::size_t& size
-) const { // Draws random samples from distribution.
-  // Create uniform distribution instance to generate seed for normal
-  // distribution
-  std::uniform_int_distribution<> distrib(1, 99999999);
-
-  // draw seed from uniform distribution
-  const long int time_seed{static_cast<long int>(time(NULL))};
-  std::mt19937 unif_gen(time_seed);
-  int seed{distrib(unif_gen)};
-
-  // instantiate normal distribution generator
-  std::normal_distribution<> norm(mu, sigma);
-  std::mt19937 norm_gen(seed);
-
-  // generate size many samples
-  std::vector<double> sample{};
-  for (unsigned int i{0}; i < size; i++) {
-    sample.push_back(norm(norm_gen));
-  }
-
+) const { // Draws random samples from the distribution's own stream.
+  return sample(size, engine);
+}
+std::vector<double> GaussianDistribution::sample(
+    const std::size_t& size, PhiloxEngine& engine
+) const { // Draws random samples from the provided stream.
+  std::vector<double> sample(size);
+  fill(sample, engine);
   return sample;
 }
+void GaussianDistribution::fill(std::span<double> out) const {
+  fill(out, engine);
+}
+void GaussianDistribution::fill(
+    std::span<double> out, PhiloxEngine& engine
+) const { // Fills the buffer with standard normals then rescales them.
+  engine.fillNormal(out);
+  if (mu == 0.0 && sigma == 1.0) {
+    return;
+  }
+  for (double& value : out) {
+    value = mu + sigma * value;
+  }
+}
+void GaussianDistribution::seed(
+    const std::uint64_t seed, const std::uint64_t stream
+) {
+  engine.seed(seed, stream);
+}
+const std::uint64_t GaussianDistribution::getSeed() const {
+  return engine.getSeed();
+}
@@ -4,20 +4,13 @@
 GeneralLinearModel::GeneralLinearModel()
     : GeneralLinearModel::GeneralLinearModel(0.0, 1.0) {}
 GeneralLinearModel::GeneralLinearModel(const double mu, const double sigma)
-    : mu(mu), sigma(sigma) {
-  dist = new GaussianDistribution();
-}
-GeneralLinearModel::GeneralLinearModel(const GeneralLinearModel& other)
-    : mu(other.mu), sigma(other.sigma) {
-  dist = new GaussianDistribution();
-}
+    : mu(mu), sigma(sigma) {}
+GeneralLinearModel::GeneralLinearModel(const GeneralLinearModel& other) =
+    default;
 const GeneralLinearModel* GeneralLinearModel::clone() const {
   return new GeneralLinearModel(*this);
 }
-GeneralLinearModel::~GeneralLinearModel() {
-  delete dist;
-  dist = nullptr;
-}
+GeneralLinearModel::~GeneralLinearModel() = default;
 const double GeneralLinearModel::getMean() const {
   return 0.0;
 }
@@ -34,21 +27,48 @@ const double GeneralLinearModel::getConditionalVariance() const {
   return ((2 * sigma * mu) / (std::exp(2 * mu) - std::exp(mu)));
 }
 std::vector<double> GeneralLinearModel::Simulate(
-    const double start, const unsigned int& size, const unsigned int& t
+    const double start, const unsigned int& size, const double& t
 ) const {
-  const std::vector<double> distribution_draws = (*dist).sample(size);
-  std::vector<double> vec = {start};
-
-  for (unsigned int n{}; n < size; n++) {
-    const double sample = coreEquation(vec[n], distribution_draws[n], t);
-    vec.push_back(sample);
-  }
-
-  return vec;
+  return simulateSteps(coreKernel(t), start, size);
 }
-const double GeneralLinearModel::coreEquation(
-    const double& x, const double& noise, const unsigned int& t
+std::vector<double> GeneralLinearModel::SimulatePaths(
+    const double start,
+    const std::size_t n_paths,
+    const std::size_t n_steps,
+    const double dt,
+    const std::uint64_t seed
 ) const {
-  const double exp_mu_t = std::exp(mu * t);
-  return x * exp_mu_t + exp_mu_t * std::exp(-mu * t) * sigma * noise;
+  std::vector<double> paths(n_paths * n_steps);
+  SimulatePaths(paths, start, n_paths, n_steps, dt, seed);
+  return paths;
+}
+void GeneralLinearModel::SimulatePaths(
+    std::span<double> paths,
+    const double start,
+    const std::size_t n_paths,
+    const std::size_t n_steps,
+    const double dt,
+    const std::uint64_t seed
+) const {
+  simulatePathsWithKernel(
+      coreKernel(dt), paths, start, n_paths, n_steps, seed
+  );
+}
+PathStream<GeneralLinearStepConstants> GeneralLinearModel::SimulateStream(
+    const double start,
+    const std::size_t n_steps,
+    const double dt,
+    const std::size_t chunk_size,
+    const std::uint64_t seed,
+    const std::uint64_t stream
+) const {
+  return PathStream<GeneralLinearStepConstants>(
+      coreKernel(dt), start, n_steps, chunk_size, seed, stream
+  );
+}
+const GeneralLinearStepConstants
+GeneralLinearModel::coreKernel(const double dt) const {
+  // The noise term e^{mu t} e^{-mu t} sigma dW reduces to sigma dW, whose
+  // increment over dt has standard deviation sigma * sqrt(dt).
+  return {std::exp(mu * dt), sigma * std::sqrt(dt)};
 }
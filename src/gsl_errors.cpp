@@ -1,11 +1,9 @@
 #include "stochastic_models/exceptions/gsl_errors.h"
 
-#include <iostream>
+#include <gsl/gsl_errno.h>
+#include <mutex>
 
-void custom_gsl_exception_handler(
-    const char* reason, const char* file, int line, int gsl_errno
-) {
-  // Log the error details
-  std::cerr << "GSL Error: " << reason << " in " << file << ":" << line
-            << " (Error Code: " << gsl_errno << ")" << std::endl;
+void disableGslErrorHandler() {
+  static std::once_flag disabled;
+  std::call_once(disabled, []() { gsl_set_error_handler_off(); });
 }
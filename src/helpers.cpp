@@ -8,7 +8,7 @@
 #include <stdexcept>
 
 void check_function_status(
-    const int& status, const std::vector<int> ignore_codes
+    const int& status, std::span<const int> ignore_codes
 ) {
   if (status && std::find(ignore_codes.begin(), ignore_codes.end(), status) ==
                     ignore_codes.end()) {
@@ -1,5 +1,48 @@
+#include "stochastic_models/hitting_times/hitting_time_density.h"
 #include "stochastic_models/hitting_times/hitting_time_ornstein_uhlenbeck.h"
 #include "stochastic_models/numeric_utils/integration.h"
+
+#include <algorithm>
+#include <cmath>
+#include <gsl/gsl_sf_dawson.h>
+#include <limits>
+
+/**
+ * @brief Smallest difference of scaled integrals, relative to the larger of
+ * the two, that the closed form accepts. Below it more than half of the
+ * digits cancel and the quadrature is used instead.
+ *
+ */
+static constexpr double closed_form_cancellation = 1e-8;
+
+/**
+ * @brief Returns the integral of exp(t^2) over [0, z], scaled by exp(-scale).
+ *
+ * @param z The upper limit of the integral.
+ * @param scale The exponent of the scaling, at least z^2.
+ * @return const double The scaled integral exp(z^2 - scale) D(z).
+ */
+static const double scaledDawsonIntegral(const double z, const double scale) {
+  return std::exp(z * z - scale) * gsl_sf_dawson(z);
+}
+
+/**
+ * @brief Returns the difference of two scaled integrals, or NaN if it loses
+ * more digits to cancellation than closed_form_cancellation allows.
+ *
+ * @param upper The scaled integral at the upper limit.
+ * @param lower The scaled integral at the lower limit.
+ * @return const double The difference upper - lower.
+ */
+static const double checkedDifference(const double upper, const double lower) {
+  const double difference = upper - lower;
+  if (std::abs(difference) <
+      closed_form_cancellation * std::max(std::abs(upper), std::abs(lower))) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  return difference;
+}
+
 double integrateHittingTimeDensity(double x, void* model) {
   HittingTimeOrnsteinUhlenbeck* m =
       static_cast<HittingTimeOrnsteinUhlenbeck*>(model);
@@ -12,3 +55,42 @@ const double hittingTimeDensity(
   return adaptiveIntegration(fn, model, second, x) /
          adaptiveIntegration(fn, model, second, first);
 }
+const double hittingTimeDensityClosedForm(
+    const double x,
+    const HittingTimeOrnsteinUhlenbeck& kernel,
+    const double first,
+    const double second
+) {
+  const double z_x = kernel.hittingTimeDensityArgument(x);
+  const double z_first = kernel.hittingTimeDensityArgument(first);
+  const double z_second = kernel.hittingTimeDensityArgument(second);
+  if (!std::isfinite(z_x) || !std::isfinite(z_first) ||
+      !std::isfinite(z_second)) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  // The constant factor of S(x) cancels in the ratio, as does the scaling
+  // by the largest exp(z^2).
+  const double scale =
+      std::max({z_x * z_x, z_first * z_first, z_second * z_second});
+  const double e_x = scaledDawsonIntegral(z_x, scale);
+  const double e_first = scaledDawsonIntegral(z_first, scale);
+  const double e_second = scaledDawsonIntegral(z_second, scale);
+  // A vanishing numerator is exact when x is the second level; otherwise
+  // both differences must keep their digits.
+  const double numerator =
+      x == second ? 0.0 : checkedDifference(e_x, e_second);
+  return numerator / checkedDifference(e_first, e_second);
+}
+const double hittingTimeDensity(
+    const double x,
+    const HittingTimeOrnsteinUhlenbeck& kernel,
+    const double first,
+    const double second
+) {
+  const double value = hittingTimeDensityClosedForm(x, kernel, first, second);
+  if (std::isfinite(value)) {
+    return value;
+  }
+  auto core = [&](const double y) { return kernel.hittingTimeDensityCore(y); };
+  return integrate(core, second, x) / integrate(core, second, first);
+}
@@ -18,6 +18,11 @@ const double
 HittingTimeOrnsteinUhlenbeck::hittingTimeDensityCore(const double& x) const {
   return exp(x * alpha * (x - 2 * mu) / (pow(sigma, 2)));
 }
+const double HittingTimeOrnsteinUhlenbeck::hittingTimeDensityArgument(
+    const double& x
+) const {
+  return sqrt(alpha / pow(sigma, 2)) * (x - mu);
+}
 const double HittingTimeOrnsteinUhlenbeck::optimalTradingFCore(
     const double& x, const double& u, const double& r
 ) const {
@@ -30,6 +35,22 @@ const double HittingTimeOrnsteinUhlenbeck::optimalTradingGCore(
   return pow(u, (r / alpha) - 1) *
          exp(sqrt(2 * alpha / pow(sigma, 2)) * (mu - x) * u - (pow(u, 2) / 2));
 }
+const double
+HittingTimeOrnsteinUhlenbeck::optimalTradingExponent(const double& r) const {
+  return r / alpha;
+}
+const double HittingTimeOrnsteinUhlenbeck::optimalTradingScale() const {
+  return sqrt(2 * alpha / pow(sigma, 2));
+}
+const double
+HittingTimeOrnsteinUhlenbeck::optimalTradingDrift(const double& x) const {
+  return optimalTradingScale() * (x - mu);
+}
+const double HittingTimeOrnsteinUhlenbeck::optimalTradingDerivativeRate(
+    const double& r
+) const {
+  return r + alpha;
+}
 const double HittingTimeOrnsteinUhlenbeck::optimalTradingLCore(
     const double& r, const double& c
 ) const {
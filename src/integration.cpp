@@ -3,18 +3,104 @@
 #include "stochastic_models/exceptions/gsl_errors.h"
 #include "stochastic_models/numeric_utils/helpers.h"
 
-IntegrationState::IntegrationState(gsl_integration_workspace& w)
-    : workspace(&w) {}
-IntegrationState::~IntegrationState() {
+#include <array>
+#include <new>
+#include <stdexcept>
+
+/**
+ * @brief GSL error codes that the integration routines do not treat as
+ * failures. Round-off errors are not critical to the current use-case.
+ *
+ */
+static constexpr std::array<int, 1> integration_ignore_codes{GSL_EROUND};
+
+IntegrationWorkspacePool::Lease::Lease(
+    IntegrationWorkspacePool& pool, gsl_integration_workspace* w
+)
+    : pool(&pool), workspace(w) {}
+IntegrationWorkspacePool::Lease::Lease(Lease&& other) noexcept
+    : pool(other.pool), workspace(other.workspace) {
+  other.workspace = nullptr;
+}
+gsl_integration_workspace* IntegrationWorkspacePool::Lease::get() const {
+  return workspace;
+}
+IntegrationWorkspacePool::Lease::~Lease() {
   if (workspace != nullptr) {
-    gsl_integration_workspace_free(workspace);
+    pool->available.push_back(workspace);
     workspace = nullptr;
   }
 }
+IntegrationWorkspacePool::~IntegrationWorkspacePool() {
+  for (gsl_integration_workspace* workspace : available) {
+    gsl_integration_workspace_free(workspace);
+  }
+}
+IntegrationWorkspacePool::Lease IntegrationWorkspacePool::acquire() {
+  if (available.empty()) {
+    gsl_integration_workspace* workspace =
+        gsl_integration_workspace_alloc(workspace_size);
+    if (workspace == nullptr) {
+      throw std::bad_alloc();
+    }
+    ++total;
+    // Reserve room for every workspace so returning a lease never allocates.
+    available.reserve(total);
+    return Lease(*this, workspace);
+  }
+  gsl_integration_workspace* workspace = available.back();
+  available.pop_back();
+  return Lease(*this, workspace);
+}
+const std::size_t IntegrationWorkspacePool::allocated() const {
+  return total;
+}
+IntegrationWorkspacePool& threadIntegrationWorkspacePool() {
+  thread_local IntegrationWorkspacePool pool;
+  return pool;
+}
+
+GaussJacobiRule::GaussJacobiRule(const std::size_t n, const double beta)
+    : workspace(nullptr), beta(beta) {
+  if (n == 0 || !(beta > -1.0)) {
+    throw std::invalid_argument(
+        "Gauss-Jacobi rule needs at least one node and beta > -1."
+    );
+  }
+  disableGslErrorHandler();
+  // GSL weights (b - x)^alpha (x - a)^beta on [a, b].
+  workspace = gsl_integration_fixed_alloc(
+      gsl_integration_fixed_jacobi, n, 0.0, 1.0, 0.0, beta
+  );
+  if (workspace == nullptr) {
+    throw std::bad_alloc();
+  }
+}
+GaussJacobiRule::~GaussJacobiRule() {
+  gsl_integration_fixed_free(workspace);
+}
+const std::size_t GaussJacobiRule::size() const {
+  return gsl_integration_fixed_n(workspace);
+}
+const double GaussJacobiRule::getBeta() const {
+  return beta;
+}
+const double* GaussJacobiRule::nodes() const {
+  return gsl_integration_fixed_nodes(workspace);
+}
+const double* GaussJacobiRule::weights() const {
+  return gsl_integration_fixed_weights(workspace);
+}
 
-const double
-adaptiveIntegration(ModelFunc fn, void* model, double& lower, double& upper) {
-  IntegrationState state(*gsl_integration_workspace_alloc(1000));
+const double adaptiveIntegration(
+    ModelFunc fn,
+    void* model,
+    double& lower,
+    double& upper,
+    IntegrationWorkspacePool& pool
+) {
+  disableGslErrorHandler();
+  const IntegrationWorkspacePool::Lease workspace = pool.acquire();
 
   double result, error;
 
@@ -22,30 +108,33 @@ adaptiveIntegration(ModelFunc fn, void* model, double& lower, double& upper) {
   F.function = *fn;
   F.params = model;
 
-  /* set custom error handler */
-  gsl_error_handler_t* old_handler =
-      gsl_set_error_handler(&custom_gsl_exception_handler);
-
   int status = gsl_integration_qags(
-      &F, lower, upper, 0, 1e-7, 1000, state.workspace, &result, &error
+      &F,
+      lower,
+      upper,
+      0,
+      1e-7,
+      IntegrationWorkspacePool::workspace_size,
+      workspace.get(),
+      &result,
+      &error
   );
 
-  /* restore original handler */
-  gsl_set_error_handler(old_handler);
-
   // Check the status returned from the integration routine.
-  // We are choosing to ignore a round-off error as it is not critical to the
-  // current use-case.
-  const std::vector<int> ignore_codes = {GSL_EROUND};
-  check_function_status(status, ignore_codes);
+  check_function_status(status, integration_ignore_codes);
 
   const double value = result;
 
   return value;
 }
-const double
-semiInfiniteIntegrationUpper(ModelFunc fn, void* model, double& lower) {
-  IntegrationState state(*gsl_integration_workspace_alloc(1000));
+const double semiInfiniteIntegrationUpper(
+    ModelFunc fn,
+    void* model,
+    double& lower,
+    IntegrationWorkspacePool& pool
+) {
+  disableGslErrorHandler();
+  const IntegrationWorkspacePool::Lease workspace = pool.acquire();
 
   double result, error = 0;
 
@@ -53,22 +142,19 @@ semiInfiniteIntegrationUpper(ModelFunc fn, void* model, double& lower) {
   F.function = *fn;
   F.params = model;
 
-  /* set custom error handler */
-  gsl_error_handler_t* old_handler =
-      gsl_set_error_handler(&custom_gsl_exception_handler);
-
   int status = gsl_integration_qagiu(
-      &F, lower, 0, 1e-7, 1000, state.workspace, &result, &error
+      &F,
+      lower,
+      0,
+      1e-7,
+      IntegrationWorkspacePool::workspace_size,
+      workspace.get(),
+      &result,
+      &error
   );
 
-  /* restore original handler */
-  gsl_set_error_handler(old_handler);
-
   // Check the status returned from the integration routine.
-  // We are choosing to ignore a round-off error as it is not critical to the
-  // current use-case.
-  const std::vector<int> ignore_codes = {GSL_EROUND};
-  check_function_status(status, ignore_codes);
+  check_function_status(status, integration_ignore_codes);
 
   const double value = result;
 
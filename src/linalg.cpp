@@ -61,12 +61,9 @@ const boost::numeric::ublas::matrix<double> BoostMatrixInverter::invertMatrix(
   // Allocate GSL matrix memory space for inverted matrix.
   std::size_t rows = boost_matrix.size1();
   std::size_t cols = boost_matrix.size2();
+  disableGslErrorHandler();
   gsl_matrix* gsl_mat = gsl_matrix_alloc(rows, cols);
 
-  // Set custom GSL error handler.
-  gsl_error_handler_t* old_handler =
-      gsl_set_error_handler(&custom_gsl_exception_handler);
-
   // Copy Boost matrix to GSL matrix.
   copyBoostToGslMatrix(boost_matrix, gsl_mat);
 
@@ -92,8 +89,5 @@ const boost::numeric::ublas::matrix<double> BoostMatrixInverter::invertMatrix(
   gsl_matrix_free(gsl_mat);
   gsl_matrix_free(gsl_inv);
 
-  // Restore original GSL error handler.
-  gsl_set_error_handler(old_handler);
-
   return boost_inv_matrix;
 }
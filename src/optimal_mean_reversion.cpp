@@ -5,48 +5,319 @@
 #include "stochastic_models/sde/ornstein_uhlenbeck.h"
 #include "stochastic_models/trading/trading_levels_params.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <numbers>
 #include <stdexcept>
+
+/**
+ * @brief Number of nodes of the fixed-order rule for the F and G transforms,
+ * which keeps the relative error below 1e-12 over the validated range.
+ *
+ */
+static constexpr std::size_t transform_rule_nodes = 48;
+/**
+ * @brief Largest exponent r / alpha for which the fixed-order rule has been
+ * validated.
+ *
+ */
+static constexpr double transform_max_exponent = 40.0;
+/**
+ * @brief Largest absolute drift sqrt(2 alpha / sigma^2) (x - mu) for which the
+ * fixed-order rule has been validated. This is eight stationary standard
+ * deviations, twice the range searched by the trading level solvers.
+ *
+ */
+static constexpr double transform_max_drift = 8.0;
+/**
+ * @brief The fixed-order rule integrates up to where the integrand has fallen
+ * by exp(-transform_truncation) from its peak.
+ *
+ */
+static constexpr double transform_truncation = 40.0;
+
+/**
+ * @brief Returns whether the fixed-order rule is accurate for the transform
+ * with the given exponent and drift.
+ *
+ * @param nu The exponent r / alpha.
+ * @param drift The coefficient of u in the exponent of the integrand.
+ * @return const bool Whether fixedOrderTransform may be used.
+ */
+static const bool
+fixedOrderTransformValid(const double nu, const double drift) {
+  return nu > 0.0 && nu <= transform_max_exponent &&
+         std::abs(drift) <= transform_max_drift;
+}
+
+/**
+ * @brief Returns the Gauss-Jacobi rule for the weight u^(nu - 1) on [0, 1].
+ *
+ * @param nu The exponent r / alpha.
+ * @return const GaussJacobiRule& The rule, owned by the calling thread.
+ */
+static const GaussJacobiRule& transformRule(const double nu) {
+  // The rule only depends on the exponent, which rarely changes between
+  // calls, so each thread keeps the rules of the last two exponents it used:
+  // those of r and of the derivative rate r + alpha alternate when the second
+  // derivatives of the transforms are needed.
+  thread_local std::unique_ptr<GaussJacobiRule> rules[2];
+  thread_local std::size_t last{0};
+  for (std::size_t i{0}; i < 2; ++i) {
+    if (rules[i] && rules[i]->getBeta() == nu - 1.0) {
+      last = i;
+      return *rules[i];
+    }
+  }
+  last = 1 - last;
+  rules[last] =
+      std::make_unique<GaussJacobiRule>(transform_rule_nodes, nu - 1.0);
+  return *rules[last];
+}
+
+/**
+ * @brief Returns the point at which the fixed-order rule truncates the
+ * transform with the given exponent and drift.
+ *
+ * @param nu The exponent r / alpha.
+ * @param drift The coefficient of u in the exponent of the integrand.
+ * @return const double The upper limit of integration.
+ */
+static const double transformUpperLimit(const double nu, const double drift) {
+  // Beyond the peak of u^nu exp(drift u - u^2 / 2), the integrand of the
+  // derivative, its log falls at least as fast as that of a unit Gaussian.
+  // Truncating sqrt(2 * transform_truncation) past the peak discards a
+  // relative exp(-transform_truncation) of it and, dividing by u, of the
+  // transform itself.
+  const double peak =
+      std::max(0.5 * (drift + std::sqrt(drift * drift + 4 * nu)), 0.0);
+  return peak + std::sqrt(2 * transform_truncation);
+}
+
+/**
+ * @brief Evaluates the transform of u^(nu - 1) exp(drift u - u^2 / 2) over
+ * [0, inf) with a Gauss-Jacobi rule for the weight u^(nu - 1).
+ *
+ * The rule absorbs the singularity of the power at zero and the remaining
+ * factor is entire, so a few dozen nodes suffice once the range is truncated.
+ *
+ * @param nu The exponent r / alpha.
+ * @param drift The coefficient of u in the exponent of the integrand.
+ * @return const double The value of the transform.
+ */
+static const double fixedOrderTransform(const double nu, const double drift) {
+  const GaussJacobiRule& rule = transformRule(nu);
+  const double upper = transformUpperLimit(nu, drift);
+  const double* nodes = rule.nodes();
+  const double* weights = rule.weights();
+  double sum = 0.0;
+  for (std::size_t i{0}; i < rule.size(); ++i) {
+    const double u = upper * nodes[i];
+    sum += weights[i] * std::exp(drift * u - 0.5 * u * u);
+  }
+  return std::pow(upper, nu) * sum;
+}
+
+/**
+ * @brief Evaluates F, G and their derivatives in one sweep over the rule of
+ * fixedOrderTransform. F uses the drift and G its negation, and each
+ * derivative weights the integrand of its transform by scale u.
+ *
+ * @param nu The exponent r / alpha.
+ * @param scale The scale sqrt(2 alpha / sigma^2) of the drift.
+ * @param drift The coefficient of u in the exponent of the F integrand.
+ * @return const OptimalTradingTransforms F, F', G and G'.
+ */
+static const OptimalTradingTransforms
+fixedOrderTransforms(const double nu, const double scale, const double drift) {
+  const GaussJacobiRule& rule = transformRule(nu);
+  const double upper_f = transformUpperLimit(nu, drift);
+  const double upper_g = transformUpperLimit(nu, -drift);
+  const double* nodes = rule.nodes();
+  const double* weights = rule.weights();
+  double f{0.0}, f_moment{0.0}, g{0.0}, g_moment{0.0};
+  for (std::size_t i{0}; i < rule.size(); ++i) {
+    const double u_f = upper_f * nodes[i];
+    const double u_g = upper_g * nodes[i];
+    const double term_f = weights[i] * std::exp(drift * u_f - 0.5 * u_f * u_f);
+    const double term_g =
+        weights[i] * std::exp(-drift * u_g - 0.5 * u_g * u_g);
+    f += term_f;
+    f_moment += u_f * term_f;
+    g += term_g;
+    g_moment += u_g * term_g;
+  }
+  const double scale_f = std::pow(upper_f, nu);
+  const double scale_g = std::pow(upper_g, nu);
+  return OptimalTradingTransforms{
+      scale_f * f,
+      scale * scale_f * f_moment,
+      scale_g * g,
+      -scale * scale_g * g_moment
+  };
+}
+
+/**
+ * @brief Largest absolute drift at which the asymptotic transforms are
+ * evaluated. Beyond it the drift is clamped, which keeps the alternating
+ * series of asymptoticTransforms from cancelling and is well outside the
+ * range searched by the trading level solvers.
+ *
+ */
+static constexpr double asymptotic_max_drift = 8.0;
+/**
+ * @brief Evaluates F, G and their derivatives to leading order in the
+ * exponent r / alpha, in closed form.
+ *
+ * F(x;r) is the integral of u^(nu - 1) exp(z u - u^2 / 2) over [0, inf). As nu
+ * tends to zero it approaches 2^(nu / 2 - 1) Gamma(nu / 2) + J(z), where J(z)
+ * integrates (exp(z u) - 1) exp(-u^2 / 2) / u, and its derivative in the
+ * drift approaches M(z) = sqrt(pi / 2) exp(z^2 / 2) erfc(-z / sqrt(2)). G is F
+ * with the drift negated. The approximation keeps the shape of the root
+ * functions of the trading levels, so their roots land within a fraction of a
+ * stationary standard deviation of the exact ones for the small exponents of
+ * typical discount rates.
+ *
+ * Expanding exp(z u) gives J(z) as the series of c_k z^k over k >= 1 with
+ * c_1 = sqrt(pi / 2), c_2 = 1 / 2 and c_(k + 2) = c_k k / ((k + 1) (k + 2)).
+ * J(-z) only flips the sign of the odd terms, and M(-z) is M(z) with the
+ * complementary erfc, so both transforms share one series and one erfc.
+ *
+ * @param nu The exponent r / alpha.
+ * @param scale The scale sqrt(2 alpha / sigma^2) of the drift.
+ * @param drift The coefficient of u in the exponent of the F integrand.
+ * @return const OptimalTradingTransforms F, F', G and G'.
+ */
+static const OptimalTradingTransforms
+asymptoticTransforms(const double nu, const double scale, const double drift) {
+  const double z =
+      std::clamp(drift, -asymptotic_max_drift, asymptotic_max_drift);
+  const double z_squared = z * z;
+  double odd_term = std::sqrt(0.5 * std::numbers::pi) * z;
+  double even_term = 0.5 * z_squared;
+  double odd = odd_term, even = even_term;
+  // Each pass advances the odd terms from k to k + 2 and the even terms from
+  // k + 1 to k + 3. The terms grow while k is below z^2.
+  for (double k{1.0};; k += 2.0) {
+    odd_term *= z_squared * k / ((k + 1.0) * (k + 2.0));
+    even_term *= z_squared * (k + 1.0) / ((k + 2.0) * (k + 3.0));
+    odd += odd_term;
+    even += even_term;
+    if (k > z_squared &&
+        std::abs(odd_term) + std::abs(even_term) <=
+            std::numeric_limits<double>::epsilon() * (std::abs(odd) + even)) {
+      break;
+    }
+  }
+
+  // erfc of the positive argument avoids cancelling in 2 - erfc.
+  const double gaussian =
+      std::sqrt(0.5 * std::numbers::pi) * std::exp(0.5 * z_squared);
+  const double tail = std::erfc(std::abs(z) / std::numbers::sqrt2);
+  const double slope_f = gaussian * (z >= 0.0 ? 2.0 - tail : tail);
+  const double slope_g = gaussian * (z >= 0.0 ? tail : 2.0 - tail);
+  const double base = std::exp(
+      (0.5 * nu - 1.0) * std::numbers::ln2 + std::lgamma(0.5 * nu)
+  );
+  return OptimalTradingTransforms{
+      base + even + odd, scale * slope_f, base + even - odd, -scale * slope_g
+  };
+}
+
+/**
+ * @brief Returns the coefficients of the value function with a stop loss
+ * from the transforms at the stop loss and exit levels.
+ *
+ * @param at_stop_loss The transforms at the stop loss level.
+ * @param at_exit The transforms at the exit level b*.
+ * @param b_star The exit level.
+ * @param stop_loss The stop loss level.
+ * @param c The cost of trading.
+ * @return const ValueFunctionCoefficients The coefficients C and D.
+ */
+static const ValueFunctionCoefficients stopLossCoefficients(
+    const OptimalTradingTransforms& at_stop_loss,
+    const OptimalTradingTransforms& at_exit,
+    const double& b_star,
+    const double& stop_loss,
+    const double& c
+) {
+  const double bMinusC = b_star - c;
+  const double lMinusC = stop_loss - c;
+  const double determinant =
+      (at_exit.F * at_stop_loss.G) - (at_stop_loss.F * at_exit.G);
+  return ValueFunctionCoefficients{
+      ((bMinusC * at_stop_loss.G) - (lMinusC * at_exit.G)) / determinant,
+      ((lMinusC * at_exit.F) - (bMinusC * at_stop_loss.F)) / determinant
+  };
+}
+
 OptimalMeanReversionParams::~OptimalMeanReversionParams() {
   delete hitting_time_kernel;
   hitting_time_kernel = nullptr;
 }
 double funcOptimalMeanReversionF(double x, void* params) {
-  struct OptimalMeanReversionParams* p =
-      static_cast<OptimalMeanReversionParams*>(params);
+  struct OptimalMeanReversionView* p =
+      static_cast<OptimalMeanReversionView*>(params);
   double value = p->hitting_time_kernel->optimalTradingFCore(p->x, x, p->r);
   return value;
 }
 double valueFuncStopLoss(double x, void* params) {
-  struct EntryLevelStopLossParams* p =
-      static_cast<EntryLevelStopLossParams*>(params);
+  struct EntryLevelStopLossView* p =
+      static_cast<EntryLevelStopLossView*>(params);
   double value = p->optimizer->V(
       p->hitting_time_kernel, x, p->b_star, p->stop_loss, p->r, p->c
   );
   return value;
 }
 double valueFunc(double x, void* params) {
-  struct EntryLevelParams* p = static_cast<EntryLevelParams*>(params);
+  struct EntryLevelView* p = static_cast<EntryLevelView*>(params);
   double value =
       p->optimizer->V(p->hitting_time_kernel, x, p->b_star, p->r, p->c);
   return value;
 }
 double funcIntegrateF(double x, void* params) {
-  struct ExitLevelParams* p = static_cast<ExitLevelParams*>(params);
+  struct ExitLevelView* p = static_cast<ExitLevelView*>(params);
   double value = p->optimizer->F(p->hitting_time_kernel, x, p->r, p->c);
   return value;
 }
 double funcIntegrateG(double x, void* params) {
-  struct ExitLevelParams* p = static_cast<ExitLevelParams*>(params);
+  struct ExitLevelView* p = static_cast<ExitLevelView*>(params);
   double value = p->optimizer->G(p->hitting_time_kernel, x, p->r, p->c);
   return value;
 }
 double funcOptimalMeanReversionG(double x, void* params) {
-  struct OptimalMeanReversionParams* p =
-      static_cast<OptimalMeanReversionParams*>(params);
+  struct OptimalMeanReversionView* p =
+      static_cast<OptimalMeanReversionView*>(params);
   double value = p->hitting_time_kernel->optimalTradingGCore(p->x, x, p->r);
   return value;
 }
+OptimalMeanReversion::OptimalMeanReversion(
+    const TransformQuadrature quadrature
+)
+    : quadrature(quadrature), cache(std::make_shared<TransformCache>()) {}
+const TransformQuadrature OptimalMeanReversion::getQuadrature() const {
+  return quadrature;
+}
+TransformCache* OptimalMeanReversion::getTransformCache() const {
+  return cache.get();
+}
+void OptimalMeanReversion::setTransformCache(
+    std::shared_ptr<TransformCache> cache
+) {
+  this->cache = std::move(cache);
+}
+const TransformTable* OptimalMeanReversion::getTransformTable() const {
+  return table.get();
+}
+void OptimalMeanReversion::setTransformTable(
+    std::shared_ptr<const TransformTable> table
+) {
+  this->table = std::move(table);
+}
 const OptimalMeanReversion* OptimalMeanReversion::clone() const {
   return new OptimalMeanReversion(*this);
 }
@@ -56,28 +327,37 @@ const double OptimalMeanReversion::F(
     const double& r,
     const double& c
 ) const {
-  // First create a deep copy of the model pointer and copy the contents of
-  // model into the temporary location. This is because we are going to
-  // free that memory in the destructor of the OptimalMeanReversionParams
-  // struct.
-  const HittingTimeOrnsteinUhlenbeck* temp_ptr = hitting_time_kernel->clone();
-
-  // Create new instance of the OptimalMeanReversionParams struct as a void
-  // pointer as this is required by the GSL numerical integration function.
-  void* params = new OptimalMeanReversionParams{temp_ptr, x, r};
-  ModelFunc fn = funcOptimalMeanReversionF;
-  double lower = 0;
-  double value = semiInfiniteIntegrationUpper(fn, params, lower);
-
-  // Then cast the void pointer back to the original type and free the memory.
-  OptimalMeanReversionParams* ptr =
-      static_cast<OptimalMeanReversionParams*>(params);
-  delete ptr;
-  ptr = nullptr;
-  params = nullptr;
-  temp_ptr = nullptr;
+  if (table) {
+    const double nu = hitting_time_kernel->optimalTradingExponent(r);
+    const double drift = hitting_time_kernel->optimalTradingDrift(x);
+    if (table->covers(nu, drift)) {
+      return table
+          ->transforms(hitting_time_kernel->optimalTradingScale(), drift)
+          .F;
+    }
+  }
+  if (quadrature == TransformQuadrature::Asymptotic) {
+    return asymptoticTransforms(
+               hitting_time_kernel->optimalTradingExponent(r),
+               hitting_time_kernel->optimalTradingScale(),
+               hitting_time_kernel->optimalTradingDrift(x)
+    )
+        .F;
+  }
+  if (quadrature == TransformQuadrature::FixedOrder) {
+    const double nu = hitting_time_kernel->optimalTradingExponent(r);
+    const double drift = hitting_time_kernel->optimalTradingDrift(x);
+    if (fixedOrderTransformValid(nu, drift)) {
+      return fixedOrderTransform(nu, drift);
+    }
+  }
 
-  return value;
+  return integrateUpper(
+      [&](const double u) {
+        return hitting_time_kernel->optimalTradingFCore(x, u, r);
+      },
+      0.0
+  );
 }
 const double OptimalMeanReversion::G(
     const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
@@ -85,39 +365,85 @@ const double OptimalMeanReversion::G(
     const double& r,
     const double& c
 ) const {
-  // First create a deep copy of the model pointer and copy the contents of
-  // model into the temporary location. This is because we are going to free
-  // that memory in the destructor of the OptimalMeanReversionParams struct.
-  const HittingTimeOrnsteinUhlenbeck* temp_ptr = hitting_time_kernel->clone();
+  if (table) {
+    const double nu = hitting_time_kernel->optimalTradingExponent(r);
+    const double drift = hitting_time_kernel->optimalTradingDrift(x);
+    if (table->covers(nu, drift)) {
+      return table
+          ->transforms(hitting_time_kernel->optimalTradingScale(), drift)
+          .G;
+    }
+  }
+  if (quadrature == TransformQuadrature::Asymptotic) {
+    return asymptoticTransforms(
+               hitting_time_kernel->optimalTradingExponent(r),
+               hitting_time_kernel->optimalTradingScale(),
+               hitting_time_kernel->optimalTradingDrift(x)
+    )
+        .G;
+  }
+  if (quadrature == TransformQuadrature::FixedOrder) {
+    const double nu = hitting_time_kernel->optimalTradingExponent(r);
+    const double drift = -hitting_time_kernel->optimalTradingDrift(x);
+    if (fixedOrderTransformValid(nu, drift)) {
+      return fixedOrderTransform(nu, drift);
+    }
+  }
 
-  // Create new instance of the OptimalMeanReversionParams struct as a void
-  // pointer as this is required by the GSL numerical integration function.
-  void* params = new OptimalMeanReversionParams{temp_ptr, x, r};
-  ModelFunc fn = funcOptimalMeanReversionG;
-  double value = 0.0;
-  try {
-    double lower = 0;
-    value = semiInfiniteIntegrationUpper(fn, params, lower);
-  } catch (const std::exception& e) {
-    std::cout << "Exception " << e.what()
-              << " caught in OptimalMeanReversion::G." << std::endl;
-    struct OptimalMeanReversionParams* p =
-        static_cast<OptimalMeanReversionParams*>(params);
-    delete p;
-    p = nullptr;
-    params = nullptr;
-    temp_ptr = nullptr;
-    throw;
+  return integrateUpper(
+      [&](const double u) {
+        return hitting_time_kernel->optimalTradingGCore(x, u, r);
+      },
+      0.0
+  );
+}
+const OptimalTradingTransforms OptimalMeanReversion::transforms(
+    const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
+    const double& x,
+    const double& r
+) const {
+  const double scale = hitting_time_kernel->optimalTradingScale();
+  const double nu = hitting_time_kernel->optimalTradingExponent(r);
+  const double drift = hitting_time_kernel->optimalTradingDrift(x);
+  if (table && table->covers(nu, drift)) {
+    return table->transforms(scale, drift);
+  }
+  // The approximation is not cached, as that would mix it with exact
+  // transforms in a cache shared with clones and other optimizers.
+  if (quadrature == TransformQuadrature::Asymptotic) {
+    return asymptoticTransforms(nu, scale, drift);
+  }
+  const TransformCacheKey key{nu, scale, drift, quadrature};
+  OptimalTradingTransforms result;
+  if (cache && cache->find(key, result)) {
+    return result;
   }
-  // Then cast the void pointer back to the original type and free the memory.
-  OptimalMeanReversionParams* ptr =
-      static_cast<OptimalMeanReversionParams*>(params);
-  delete ptr;
-  ptr = nullptr;
-  params = nullptr;
-  temp_ptr = nullptr;
 
-  return value;
+  // A quantized cache holds the transforms at the drift of the cell of x.
+  const double cell_drift = cache ? cache->quantizedDrift(drift) : drift;
+  const double cell_x = x + (cell_drift - drift) / scale;
+  if (quadrature == TransformQuadrature::FixedOrder &&
+      fixedOrderTransformValid(nu, cell_drift)) {
+    result = fixedOrderTransforms(nu, scale, cell_drift);
+  } else {
+    // The derivatives are the transforms carrying one more power of u.
+    const double derivative_rate =
+        hitting_time_kernel->optimalTradingDerivativeRate(r);
+    result = OptimalTradingTransforms{
+        F(hitting_time_kernel, cell_x, r, 0.0),
+        scale * F(hitting_time_kernel, cell_x, derivative_rate, 0.0),
+        G(hitting_time_kernel, cell_x, r, 0.0),
+        -scale * G(hitting_time_kernel, cell_x, derivative_rate, 0.0)
+    };
+  }
+  if (!cache) {
+    return result;
+  }
+  cache->insert(key, result);
+  if (cell_drift == drift) {
+    return result;
+  }
+  return extrapolateTransforms(result, x - cell_x);
 }
 const double OptimalMeanReversion::L_star(
     const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
@@ -132,12 +458,9 @@ const double OptimalMeanReversion::b(
     const double& r,
     const double& c
 ) const {
-  ModelFunc fn = funcIntegrateF;
-  const double result =
-      OptimalMeanReversion::F(hitting_time_kernel, value, r, c) -
-      (value - c) *
-          instantaneousDifferential(fn, hitting_time_kernel, value, r, c);
-  return result;
+  const OptimalTradingTransforms at_b =
+      transforms(hitting_time_kernel, value, r);
+  return at_b.F - (value - c) * at_b.F_prime;
 }
 const double OptimalMeanReversion::b(
     const double& value,
@@ -146,49 +469,68 @@ const double OptimalMeanReversion::b(
     const double& r,
     const double& c
 ) const {
-  ModelFunc fnF = funcIntegrateF;
-  ModelFunc fnG = funcIntegrateG;
-
   const double bMinusC = value - c;
   const double lMinusC = stop_loss - c;
-  const double gL =
-      OptimalMeanReversion::G(hitting_time_kernel, stop_loss, r, c);
-  const double gB = OptimalMeanReversion::G(hitting_time_kernel, value, r, c);
-  const double fL =
-      OptimalMeanReversion::F(hitting_time_kernel, stop_loss, r, c);
-  const double fB = OptimalMeanReversion::F(hitting_time_kernel, value, r, c);
+  const OptimalTradingTransforms at_l =
+      transforms(hitting_time_kernel, stop_loss, r);
+  const OptimalTradingTransforms at_b =
+      transforms(hitting_time_kernel, value, r);
 
   const double result =
-      (((lMinusC * gB) - (bMinusC * gL)) *
-       instantaneousDifferential(fnF, hitting_time_kernel, value, r, c)) +
-      (((bMinusC * fL) - (lMinusC * fB)) *
-       instantaneousDifferential(fnG, hitting_time_kernel, value, r, c)) -
-      ((gB * fL) - (gL * fB));
+      (((lMinusC * at_b.G) - (bMinusC * at_l.G)) * at_b.F_prime) +
+      (((bMinusC * at_l.F) - (lMinusC * at_b.F)) * at_b.G_prime) -
+      ((at_b.G * at_l.F) - (at_l.G * at_b.F));
   return result;
 }
+const ValueFunctionCoefficients OptimalMeanReversion::valueFunction(
+    const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
+    const double& b_star,
+    const double& r,
+    const double& c
+) const {
+  return ValueFunctionCoefficients{
+      (b_star - c) / transforms(hitting_time_kernel, b_star, r).F, 0.0
+  };
+}
+const ValueFunctionCoefficients OptimalMeanReversion::valueFunction(
+    const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
+    const double& b_star,
+    const double& stop_loss,
+    const double& r,
+    const double& c
+) const {
+  return stopLossCoefficients(
+      transforms(hitting_time_kernel, stop_loss, r),
+      transforms(hitting_time_kernel, b_star, r),
+      b_star,
+      stop_loss,
+      c
+  );
+}
 const double OptimalMeanReversion::d(
     const double& value,
     const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
+    const ValueFunctionCoefficients& coefficients,
     const double& b_star,
     const double& stop_loss,
     const double& r,
     const double& c
 ) const {
-  ModelFunc funcG = funcIntegrateG;
-  ModelFunc funcV = valueFuncStopLoss;
+  const OptimalTradingTransforms at_d =
+      transforms(hitting_time_kernel, value, r);
 
-  const double vPrimeD = instantaneousDifferential(
-      funcV, hitting_time_kernel, value, b_star, stop_loss, r, c
-  );
-  const double g = OptimalMeanReversion::G(hitting_time_kernel, value, r, c);
-  const double differential = instantaneousDifferential(
-      funcG, hitting_time_kernel, value, b_star, r, c
-  );
-  const double v = OptimalMeanReversion::V(
-      hitting_time_kernel, value, b_star, stop_loss, r, c
-  );
+  // The value function and its derivative at d. The continuation region is
+  // closed so the derivative is one-sided at the levels, where the root
+  // solvers evaluate their brackets.
+  double v = value - c;
+  double vPrimeD = 1.0;
+  if ((b_star >= value) && (value >= stop_loss)) {
+    v = coefficients.C * at_d.F + coefficients.D * at_d.G;
+    vPrimeD = coefficients.C * at_d.F_prime + coefficients.D * at_d.G_prime;
+  }
 
-  const double result = (g * (vPrimeD - 1)) - (differential * (v - value - c));
+  const double result =
+      (at_d.G * (vPrimeD - 1)) - (at_d.G_prime * (v - value - c));
 
   return result;
 }
@@ -196,24 +538,37 @@ const double OptimalMeanReversion::d(
     const double& value,
     const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
     const double& b_star,
+    const double& stop_loss,
     const double& r,
     const double& c
 ) const {
-  ModelFunc funcG = funcIntegrateG;
-  ModelFunc funcV = valueFunc;
-  const double result =
-      (OptimalMeanReversion::G(hitting_time_kernel, value, r, c) *
-       (instantaneousDifferential(
-            funcV, hitting_time_kernel, value, b_star, r, c
-        ) -
-        1)) -
-      (instantaneousDifferential(
-           funcG, hitting_time_kernel, value, b_star, r, c
-       ) *
-       (OptimalMeanReversion::V(hitting_time_kernel, value, b_star, r, c) -
-        value - c));
-
-  return result;
+  return d(
+      value,
+      hitting_time_kernel,
+      valueFunction(hitting_time_kernel, b_star, stop_loss, r, c),
+      b_star,
+      stop_loss,
+      r,
+      c
+  );
+}
+const double OptimalMeanReversion::d(
+    const double& value,
+    const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
+    const double& b_star,
+    const double& r,
+    const double& c
+) const {
+  // Without a stop loss the value function holds for every x below b*.
+  return d(
+      value,
+      hitting_time_kernel,
+      valueFunction(hitting_time_kernel, b_star, r, c),
+      b_star,
+      -std::numeric_limits<double>::infinity(),
+      r,
+      c
+  );
 }
 const double OptimalMeanReversion::a(
     const double& value,
@@ -232,27 +587,46 @@ const double OptimalMeanReversion::a(
 const double OptimalMeanReversion::a(
     const double& value,
     const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
+    const ValueFunctionCoefficients& coefficients,
     const double& b_star,
     const double& stop_loss,
     const double& r,
     const double& c
 ) const {
-  ModelFunc funcF = funcIntegrateF;
-  ModelFunc funcV = valueFuncStopLoss;
-  const double vPrimeA = instantaneousDifferential(
-      funcV, hitting_time_kernel, value, b_star, stop_loss, r, c
-  );
-  const double f = OptimalMeanReversion::F(hitting_time_kernel, value, r, c);
-  const double differential = instantaneousDifferential(
-      funcF, hitting_time_kernel, value, b_star, r, c
-  );
-  const double v = OptimalMeanReversion::V(
-      hitting_time_kernel, value, b_star, stop_loss, r, c
-  );
-  const double result = (f * (vPrimeA - 1)) - (differential * (v - value - c));
+  const OptimalTradingTransforms at_a =
+      transforms(hitting_time_kernel, value, r);
+
+  // The value function and its derivative at a, one-sided at the levels.
+  double v = value - c;
+  double vPrimeA = 1.0;
+  if ((b_star >= value) && (value >= stop_loss)) {
+    v = coefficients.C * at_a.F + coefficients.D * at_a.G;
+    vPrimeA = coefficients.C * at_a.F_prime + coefficients.D * at_a.G_prime;
+  }
+
+  const double result =
+      (at_a.F * (vPrimeA - 1)) - (at_a.F_prime * (v - value - c));
 
   return result;
 }
+const double OptimalMeanReversion::a(
+    const double& value,
+    const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
+    const double& b_star,
+    const double& stop_loss,
+    const double& r,
+    const double& c
+) const {
+  return a(
+      value,
+      hitting_time_kernel,
+      valueFunction(hitting_time_kernel, b_star, stop_loss, r, c),
+      b_star,
+      stop_loss,
+      r,
+      c
+  );
+}
 const double OptimalMeanReversion::V(
     const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
     const double& x,
@@ -276,27 +650,15 @@ const double OptimalMeanReversion::V(
     const double& c
 ) const {
   if ((b_star > x) && (x > stop_loss)) {
-    ModelFunc fnF = funcIntegrateF;
-    ModelFunc fnG = funcIntegrateG;
-
-    const double bMinusC = b_star - c;
-    const double lMinusC = stop_loss - c;
-    const double gL =
-        OptimalMeanReversion::G(hitting_time_kernel, stop_loss, r, c);
-    const double gBstar =
-        OptimalMeanReversion::G(hitting_time_kernel, b_star, r, c);
-    const double fL =
-        OptimalMeanReversion::F(hitting_time_kernel, stop_loss, r, c);
-    const double fBstar =
-        OptimalMeanReversion::F(hitting_time_kernel, b_star, r, c);
-
-    const double C =
-        ((bMinusC * gL) - (lMinusC * gBstar)) / ((fBstar * gL) - (fL * gBstar));
-    const double D =
-        ((lMinusC * fBstar) - (bMinusC * fL)) / ((fBstar * gL) - (fL * gBstar));
-
-    return C * F(hitting_time_kernel, x, r, c) +
-           D * G(hitting_time_kernel, x, r, c);
+    const ValueFunctionCoefficients coefficients = stopLossCoefficients(
+        transforms(hitting_time_kernel, stop_loss, r),
+        transforms(hitting_time_kernel, b_star, r),
+        b_star,
+        stop_loss,
+        c
+    );
+    return coefficients.C * F(hitting_time_kernel, x, r, c) +
+           coefficients.D * G(hitting_time_kernel, x, r, c);
   } else {
     return x - c;
   }
@@ -310,38 +672,21 @@ const double OptimalMeanReversion::instantaneousDifferential(
     const double& r,
     const double& c
 ) const {
-  // Create a deep copy of the model and optimizer pointers to ensure that
-  // cleanup does not delete heap memory that is not owned by this scope.
-  const HittingTimeOrnsteinUhlenbeck* temp_kernel =
-      hitting_time_kernel->clone();
-  const OptimalMeanReversion* temp_optimizer = clone();
-
   // Create copy to not modify the original value and
   // not provide to function that takes a non-const.
   double x_copied = x;
 
   // Adaptive differentiation function.
-  void* params =
-      new EntryLevelStopLossParams{temp_optimizer, temp_kernel, b_star,
-                                   stop_loss,      r,           c};
+  EntryLevelStopLossView params{
+      this, hitting_time_kernel, b_star, stop_loss, r, c
+  };
 
   try {
-    double value = adaptiveCentralDifferentiation(fn, params, x_copied);
-    struct EntryLevelStopLossParams* p =
-        static_cast<EntryLevelStopLossParams*>(params);
-    delete p;
-    p = nullptr;
-    params = nullptr;
-    return value;
+    return adaptiveCentralDifferentiation(fn, &params, x_copied);
   } catch (std::exception& e) {
     std::cout << "Exception " << e.what()
               << " caught in OptimalMeanReversion::instantaneousDifferential."
               << std::endl;
-    struct EntryLevelStopLossParams* p =
-        static_cast<EntryLevelStopLossParams*>(params);
-    delete p;
-    p = nullptr;
-    params = nullptr;
     throw;
   }
 }
@@ -353,35 +698,19 @@ const double OptimalMeanReversion::instantaneousDifferential(
     const double& r,
     const double& c
 ) const {
-  // Create a deep copy of the model and optimizer pointers to ensure that
-  // cleanup does not delete heap memory that is not owned by this scope.
-  const HittingTimeOrnsteinUhlenbeck* temp_kernel =
-      hitting_time_kernel->clone();
-  const OptimalMeanReversion* temp_optimizer = clone();
-
   // Create copy to not modify the original value and
   // not provide to function that takes a non-const.
   double x_copied = x;
 
   // Adaptive differentiation function.
-  void* params =
-      new EntryLevelParams{temp_optimizer, temp_kernel, b_star, r, c};
+  EntryLevelView params{this, hitting_time_kernel, b_star, r, c};
 
   try {
-    double value = adaptiveCentralDifferentiation(fn, params, x_copied);
-    struct EntryLevelParams* p = static_cast<EntryLevelParams*>(params);
-    delete p;
-    p = nullptr;
-    params = nullptr;
-    return value;
+    return adaptiveCentralDifferentiation(fn, &params, x_copied);
   } catch (std::exception& e) {
     std::cout << "Exception " << e.what()
               << " caught in OptimalMeanReversion::instantaneousDifferential."
               << std::endl;
-    struct EntryLevelParams* p = static_cast<EntryLevelParams*>(params);
-    delete p;
-    p = nullptr;
-    params = nullptr;
     throw;
   }
 }
@@ -392,34 +721,19 @@ const double OptimalMeanReversion::instantaneousDifferential(
     const double& r,
     const double& c
 ) const {
-  // Create a deep copy of the model and optimizer pointers to ensure that
-  // cleanup does not delete heap memory that is not owned by this scope.
-  const HittingTimeOrnsteinUhlenbeck* temp_kernel =
-      hitting_time_kernel->clone();
-  const OptimalMeanReversion* temp_optimizer = clone();
-
   // Create copy to not modify the original value and
   // not provide to function that takes a non-const.
   double x_copied = x;
 
   // Adaptive differentiation function.
-  void* params = new ExitLevelParams{temp_optimizer, temp_kernel, r, c};
+  ExitLevelView params{this, hitting_time_kernel, r, c};
 
   try {
-    double value = adaptiveCentralDifferentiation(fn, params, x_copied);
-    struct ExitLevelParams* p = static_cast<ExitLevelParams*>(params);
-    delete p;
-    p = nullptr;
-    params = nullptr;
-    return value;
+    return adaptiveCentralDifferentiation(fn, &params, x_copied);
   } catch (std::exception& e) {
     std::cout << "Exception " << e.what()
               << " caught in OptimalMeanReversion::instantaneousDifferential."
               << std::endl;
-    struct ExitLevelParams* p = static_cast<ExitLevelParams*>(params);
-    delete p;
-    p = nullptr;
-    params = nullptr;
     throw;
   }
 }
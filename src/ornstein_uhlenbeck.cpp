@@ -1,8 +1,10 @@
 #include "stochastic_models/sde/ornstein_uhlenbeck.h"
 
-#include "stochastic_models/distributions/gaussian.h"
-
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <limits>
+#include <stdexcept>
 /**
  * @brief No args constructor delegates to main constructor.
  *
@@ -16,28 +18,21 @@ OrnsteinUhlenbeckModel::OrnsteinUhlenbeckModel()
 OrnsteinUhlenbeckModel::OrnsteinUhlenbeckModel(
     const double mu, const double alpha, const double sigma
 )
-    : mu(mu), alpha(alpha), sigma(sigma) {
-  dist = new GaussianDistribution();
-}
+    : mu(mu), alpha(alpha), sigma(sigma) {}
 /**
- * @brief Copy constructor.
+ * @brief Copy constructor. The copy draws its noise from a random stream of
+ * its own, as set by the StochasticModel copy constructor.
  *
  * @param other The OrnsteinUhlenbeckModel to copy.
  */
 OrnsteinUhlenbeckModel::OrnsteinUhlenbeckModel(
     const OrnsteinUhlenbeckModel& other
-)
-    : mu(other.mu), alpha(other.alpha), sigma(other.sigma) {
-  dist = new GaussianDistribution();
-}
+) = default;
 /**
  * @brief Destructor.
  *
  */
-OrnsteinUhlenbeckModel::~OrnsteinUhlenbeckModel() {
-  delete dist;
-  dist = nullptr;
-}
+OrnsteinUhlenbeckModel::~OrnsteinUhlenbeckModel() = default;
 const OrnsteinUhlenbeckModel* OrnsteinUhlenbeckModel::clone() const {
   return new OrnsteinUhlenbeckModel(*this);
 }
@@ -47,25 +42,164 @@ const double OrnsteinUhlenbeckModel::getMean() const {
 const double OrnsteinUhlenbeckModel::getUnconditionalVariance() const {
   return std::pow(sigma, 2) / (2 * alpha);
 }
+const double
+OrnsteinUhlenbeckModel::getConditionalMean(const double x, const double t)
+    const {
+  return getMean() + (x - getMean()) * std::exp(-alpha * t);
+}
+const double
+OrnsteinUhlenbeckModel::getConditionalVariance(const double t) const {
+  if (alpha == 0.0) {
+    return std::pow(sigma, 2) * t;
+  }
+  return getUnconditionalVariance() * -std::expm1(-2.0 * alpha * t);
+}
 std::vector<double> OrnsteinUhlenbeckModel::Simulate(
-    const double start, const unsigned int& size, const unsigned int& t
+    const double start, const unsigned int& size, const double& t
 ) const {
-  const std::vector<double> distribution_draws = (*dist).sample(size - 1);
-  std::vector<double> vec = {start};
-
-  for (const unsigned int& val : distribution_draws) {
-    const double& last = vec.back();
-    const double sample = coreEquation(last, val, t);
-    vec.push_back(sample);
+  if (size == 0) {
+    return {};
+  }
+  return simulateSteps(coreKernel(t), start, size - 1);
+}
+std::vector<double> OrnsteinUhlenbeckModel::Simulate(
+    const double start,
+    const unsigned int& size,
+    const double dt,
+    const DiscretizationScheme scheme
+) const {
+  if (size == 0) {
+    return {};
+  }
+  return simulateSteps(stepConstants(dt, scheme), start, size - 1);
+}
+PathStream<OrnsteinUhlenbeckStepConstants>
+OrnsteinUhlenbeckModel::SimulateStream(
+    const double start,
+    const std::size_t n_steps,
+    const double dt,
+    const std::size_t chunk_size,
+    const std::uint64_t seed,
+    const std::uint64_t stream,
+    const DiscretizationScheme scheme
+) const {
+  return PathStream<OrnsteinUhlenbeckStepConstants>(
+      stepConstants(dt, scheme), start, n_steps, chunk_size, seed, stream
+  );
+}
+TimedSeries OrnsteinUhlenbeckModel::SimulateAdaptive(
+    const double start,
+    const double horizon,
+    const double dt,
+    std::span<const double> levels,
+    const AdaptiveSimulationOptions& options
+) const {
+  if (!(dt > 0.0)) {
+    throw std::invalid_argument("Time step dt must be positive.");
   }
+  const std::size_t total_steps =
+      horizon > 0.0 ? static_cast<std::size_t>(std::llround(horizon / dt)) : 0;
+  // Exact step constants for steps of dt * 2^j, computed once.
+  const unsigned int coarsest = std::min(options.max_coarsening, 62U);
+  std::vector<OrnsteinUhlenbeckStepConstants> steps;
+  steps.reserve(coarsest + 1);
+  for (unsigned int j{0}; j <= coarsest; ++j) {
+    steps.push_back(
+        stepConstants(std::ldexp(dt, j), DiscretizationScheme::Exact)
+    );
+  }
+
+  TimedSeries series;
+  series.times.push_back(0.0);
+  series.values.push_back(start);
+  std::array<double, 256> noise;
+  std::size_t next_noise = noise.size();
+  std::size_t elapsed{0};
+  double x = start;
+
+  while (elapsed < total_steps) {
+    double distance = std::numeric_limits<double>::infinity();
+    for (const double& level : levels) {
+      distance = std::min(distance, std::abs(x - level));
+    }
+    // Take the coarsest step that keeps the nearest level out of reach and
+    // does not overshoot the horizon.
+    unsigned int j{0};
+    while (j < coarsest &&
+           (std::size_t{1} << (j + 1)) <= total_steps - elapsed) {
+      const OrnsteinUhlenbeckStepConstants& candidate = steps[j + 1];
+      const double move = std::abs(candidate(x, 0.0) - x);
+      if (move + options.distance_multiple * candidate.scale > distance) {
+        break;
+      }
+      ++j;
+    }
 
-  return vec;
+    if (next_noise == noise.size()) {
+      dist.fill(noise);
+      next_noise = 0;
+    }
+    x = steps[j](x, noise[next_noise++]);
+    elapsed += std::size_t{1} << j;
+    series.times.push_back(static_cast<double>(elapsed) * dt);
+    series.values.push_back(x);
+  }
+  return series;
+}
+const OrnsteinUhlenbeckStepConstants OrnsteinUhlenbeckModel::stepConstants(
+    const double dt, const DiscretizationScheme scheme
+) const {
+  // -expm1(-x) = 1 - e^{-x} without cancellation for small x.
+  const double decay = -std::expm1(-alpha * dt);
+  OrnsteinUhlenbeckStepConstants step{
+      1.0 - decay, mu * decay, sigma * std::sqrt(dt)
+  };
+  if (scheme == DiscretizationScheme::Exact) {
+    if (alpha == 0.0) {
+      step.scale = sigma * std::sqrt(dt);
+    } else {
+      step.scale =
+          sigma * std::sqrt(-std::expm1(-2.0 * alpha * dt) / (2.0 * alpha));
+    }
+  }
+  return step;
 }
-const double OrnsteinUhlenbeckModel::coreEquation(
-    const double& x, const double& noise, const unsigned int& t
+std::vector<double> OrnsteinUhlenbeckModel::SimulatePaths(
+    const double start,
+    const std::size_t n_paths,
+    const std::size_t n_steps,
+    const double dt,
+    const std::uint64_t seed,
+    const DiscretizationScheme scheme,
+    const VarianceReduction reduction
 ) const {
-  double delta{std::exp(-alpha * t)};
-  const double solution =
-      (x * delta) + (mu * (1 - delta)) + (t * sigma * noise);
-  return solution;
+  std::vector<double> paths(n_paths * n_steps);
+  SimulatePaths(paths, start, n_paths, n_steps, dt, seed, scheme, reduction);
+  return paths;
+}
+void OrnsteinUhlenbeckModel::SimulatePaths(
+    std::span<double> paths,
+    const double start,
+    const std::size_t n_paths,
+    const std::size_t n_steps,
+    const double dt,
+    const std::uint64_t seed,
+    const DiscretizationScheme scheme,
+    const VarianceReduction reduction
+) const {
+  // Step constants are identical for every path and step so are computed
+  // once; the recurrence is then a single fused multiply-add per value.
+  simulatePathsWithKernel(
+      stepConstants(dt, scheme),
+      paths,
+      start,
+      n_paths,
+      n_steps,
+      seed,
+      reduction
+  );
+}
+const OrnsteinUhlenbeckStepConstants
+OrnsteinUhlenbeckModel::coreKernel(const double dt) const {
+  return stepConstants(dt, DiscretizationScheme::EulerMaruyama);
 }
@@ -0,0 +1,71 @@
+#include "stochastic_models/numeric_utils/parallel.h"
+
+#include <limits>
+#include <stdexcept>
+
+const unsigned int hardwareWorkers() {
+  const unsigned int workers = std::thread::hardware_concurrency();
+  return workers == 0 ? 1 : workers;
+}
+
+/**
+ * @brief Packs a range into the word of WorkStealingRanges::Range.
+ *
+ * @param begin The first index of the range.
+ * @param end One past the last index of the range.
+ * @return const std::uint64_t The packed range.
+ */
+static const std::uint64_t
+packRange(const std::uint64_t begin, const std::uint64_t end) {
+  return (end << 32) | begin;
+}
+
+WorkStealingRanges::WorkStealingRanges(
+    const std::size_t n, const std::size_t workers
+)
+    : ranges(workers) {
+  if (workers == 0 || n > std::numeric_limits<std::uint32_t>::max()) {
+    throw std::invalid_argument(
+        "Work stealing needs a worker and fewer than 2^32 indices."
+    );
+  }
+  for (std::size_t worker{0}; worker < workers; ++worker) {
+    ranges[worker].bounds.store(
+        packRange(n * worker / workers, n * (worker + 1) / workers),
+        std::memory_order_relaxed
+    );
+  }
+}
+const bool
+WorkStealingRanges::next(const std::size_t worker, std::size_t& index) {
+  std::atomic<std::uint64_t>& own = ranges[worker].bounds;
+  std::uint64_t bounds = own.load(std::memory_order_acquire);
+  while ((bounds & 0xFFFFFFFFU) < (bounds >> 32)) {
+    const std::uint64_t begin = bounds & 0xFFFFFFFFU;
+    const std::uint64_t claimed = packRange(begin + 1, bounds >> 32);
+    if (own.compare_exchange_weak(bounds, claimed, std::memory_order_acq_rel)) {
+      index = begin;
+      return true;
+    }
+  }
+  // The own range is empty, so no thief modifies it and the owner may store
+  // a stolen range into it directly.
+  for (std::size_t offset{1}; offset < ranges.size(); ++offset) {
+    std::atomic<std::uint64_t>& victim =
+        ranges[(worker + offset) % ranges.size()].bounds;
+    std::uint64_t stolen = victim.load(std::memory_order_acquire);
+    while ((stolen & 0xFFFFFFFFU) < (stolen >> 32)) {
+      const std::uint64_t begin = stolen & 0xFFFFFFFFU;
+      const std::uint64_t end = stolen >> 32;
+      const std::uint64_t middle = begin + (end - begin) / 2;
+      if (victim.compare_exchange_weak(
+              stolen, packRange(begin, middle), std::memory_order_acq_rel
+          )) {
+        own.store(packRange(middle + 1, end), std::memory_order_release);
+        index = middle;
+        return true;
+      }
+    }
+  }
+  return false;
+}
@@ -0,0 +1,215 @@
+#include "stochastic_models/distributions/quasi_random.h"
+#include "stochastic_models/distributions/random.h"
+
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+
+/**
+ * @brief Joe–Kuo primitive polynomial data for dimensions 2 to 21: degree s,
+ * coefficients a and initial direction numbers m.
+ *
+ */
+struct SobolPolynomial {
+  unsigned int s;
+  unsigned int a;
+  std::array<std::uint32_t, 7> m;
+};
+static constexpr std::array<SobolPolynomial, 20> sobol_polynomials{{
+    {1, 0, {1}},
+    {2, 1, {1, 3}},
+    {3, 1, {1, 3, 1}},
+    {3, 2, {1, 1, 1}},
+    {4, 1, {1, 1, 3, 3}},
+    {4, 4, {1, 3, 5, 13}},
+    {5, 2, {1, 1, 5, 5, 17}},
+    {5, 4, {1, 1, 5, 5, 5}},
+    {5, 7, {1, 1, 7, 11, 19}},
+    {5, 11, {1, 1, 5, 1, 1}},
+    {5, 13, {1, 1, 1, 3, 11}},
+    {5, 14, {1, 3, 5, 5, 31}},
+    {6, 1, {1, 3, 3, 9, 7, 49}},
+    {6, 13, {1, 1, 1, 15, 21, 21}},
+    {6, 16, {1, 3, 1, 13, 27, 49}},
+    {6, 19, {1, 1, 1, 15, 7, 5}},
+    {6, 22, {1, 3, 1, 15, 13, 25}},
+    {6, 25, {1, 1, 5, 5, 19, 61}},
+    {7, 1, {1, 3, 7, 11, 23, 15, 103}},
+    {7, 4, {1, 3, 7, 13, 13, 15, 69}},
+}};
+
+const double inverseStandardNormalCdf(const double u) {
+  if (u <= 0.0) {
+    return -std::numeric_limits<double>::infinity();
+  }
+  if (u >= 1.0) {
+    return std::numeric_limits<double>::infinity();
+  }
+  static constexpr double a[] = {
+      -3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+      1.383577518672690e+02,  -3.066479806614716e+01, 2.506628277459239e+00
+  };
+  static constexpr double b[] = {
+      -5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+      6.680131188771972e+01, -1.328068155288572e+01
+  };
+  static constexpr double c[] = {
+      -7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+      -2.549732539343734e+00, 4.374664141464968e+00,  2.938163982698783e+00
+  };
+  static constexpr double d[] = {
+      7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+      3.754408661907416e+00
+  };
+  static constexpr double tail = 0.02425;
+
+  double x{};
+  if (u < tail || u > 1.0 - tail) {
+    const double q = std::sqrt(-2.0 * std::log(u < tail ? u : 1.0 - u));
+    x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+        ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    x = u < tail ? x : -x;
+  } else {
+    const double q = u - 0.5;
+    const double r = q * q;
+    x = (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) *
+        q /
+        (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+  }
+  // One Halley step on Phi(x) - u.
+  const double error = 0.5 * std::erfc(-x / std::numbers::sqrt2) - u;
+  const double step =
+      error * std::sqrt(2.0 * std::numbers::pi) * std::exp(0.5 * x * x);
+  return x - step / (1.0 + 0.5 * x * step);
+}
+
+SobolSequence::SobolSequence(const std::size_t dimensions)
+    : dimensions(dimensions), directions(dimensions), shift(dimensions, 0) {
+  if (dimensions == 0 || dimensions > max_dimensions) {
+    throw std::invalid_argument(
+        "Sobol sequence supports between 1 and 21 dimensions."
+    );
+  }
+  for (unsigned int bit{0}; bit < 32; ++bit) {
+    directions[0][bit] = 1U << (31 - bit);
+  }
+  for (std::size_t dim{1}; dim < dimensions; ++dim) {
+    const SobolPolynomial& polynomial = sobol_polynomials[dim - 1];
+    const unsigned int s = polynomial.s;
+    std::array<std::uint32_t, 32>& v = directions[dim];
+    for (unsigned int bit{0}; bit < s; ++bit) {
+      v[bit] = polynomial.m[bit] << (31 - bit);
+    }
+    for (unsigned int bit{s}; bit < 32; ++bit) {
+      std::uint32_t value = v[bit - s] ^ (v[bit - s] >> s);
+      for (unsigned int k{1}; k < s; ++k) {
+        if ((polynomial.a >> (s - 1 - k)) & 1U) {
+          value ^= v[bit - k];
+        }
+      }
+      v[bit] = value;
+    }
+  }
+}
+SobolSequence::SobolSequence(
+    const std::size_t dimensions, const std::uint64_t seed
+)
+    : SobolSequence(dimensions) {
+  // The last stream is reserved for the shift so simulations can use the
+  // leading streams of the same seed for pseudo-random padding.
+  PhiloxEngine engine(seed, std::numeric_limits<std::uint64_t>::max());
+  for (std::uint32_t& value : shift) {
+    value = engine();
+  }
+}
+const std::size_t SobolSequence::getDimensions() const {
+  return dimensions;
+}
+void SobolSequence::uniforms(
+    const std::uint64_t index, std::span<double> out
+) const {
+  // Only the low 32 bits of the index address distinct points.
+  const std::uint32_t gray = static_cast<std::uint32_t>(index ^ (index >> 1));
+  for (std::size_t dim{0}; dim < dimensions; ++dim) {
+    std::uint32_t value = shift[dim];
+    for (unsigned int bit{0}; bit < 32; ++bit) {
+      if ((gray >> bit) & 1U) {
+        value ^= directions[dim][bit];
+      }
+    }
+    // Centre the point within its cell so it lies strictly inside (0, 1).
+    out[dim] = (value + 0.5) * (1.0 / 4294967296.0);
+  }
+}
+void SobolSequence::normals(
+    const std::uint64_t index, std::span<double> out
+) const {
+  uniforms(index, out);
+  for (std::size_t dim{0}; dim < dimensions; ++dim) {
+    out[dim] = inverseStandardNormalCdf(out[dim]);
+  }
+}
+
+BrownianBridge::BrownianBridge(const std::size_t steps)
+    : steps(steps), bridge_index(steps), left_index(steps),
+      right_index(steps), left_weight(steps), right_weight(steps),
+      std_dev(steps) {
+  if (steps == 0) {
+    return;
+  }
+  // map[i] records which normal fixes point i + 1 (zero while unfixed).
+  std::vector<std::size_t> map(steps, 0);
+  map[steps - 1] = 1;
+  bridge_index[0] = steps - 1;
+  std_dev[0] = std::sqrt(static_cast<double>(steps));
+  std::size_t j{0};
+  for (std::size_t i{1}; i < steps; ++i) {
+    while (map[j] != 0) {
+      ++j;
+    }
+    std::size_t k{j};
+    while (map[k] == 0) {
+      ++k;
+    }
+    // Fix the midpoint of the unfixed run [j, k).
+    const std::size_t l = j + ((k - 1 - j) >> 1);
+    map[l] = i;
+    bridge_index[i] = l;
+    left_index[i] = j;
+    right_index[i] = k;
+    const double span = static_cast<double>(k + 1 - j);
+    left_weight[i] = static_cast<double>(k - l) / span;
+    right_weight[i] = static_cast<double>(l + 1 - j) / span;
+    std_dev[i] =
+        std::sqrt(static_cast<double>((l + 1 - j) * (k - l)) / span);
+    j = k + 1;
+    if (j >= steps) {
+      j = 0;
+    }
+  }
+}
+const std::size_t BrownianBridge::getSteps() const {
+  return steps;
+}
+void BrownianBridge::transform(
+    std::span<const double> normals, std::span<double> increments
+) const {
+  if (steps == 0) {
+    return;
+  }
+  // Build the path W(1), ..., W(n) in place, then difference it.
+  double* const path = increments.data();
+  path[steps - 1] = std_dev[0] * normals[0];
+  for (std::size_t i{1}; i < steps; ++i) {
+    const std::size_t j = left_index[i];
+    const std::size_t k = right_index[i];
+    const std::size_t l = bridge_index[i];
+    const double left = j != 0 ? path[j - 1] : 0.0;
+    path[l] = left_weight[i] * left + right_weight[i] * path[k] +
+              std_dev[i] * normals[i];
+  }
+  for (std::size_t i{steps - 1}; i > 0; --i) {
+    path[i] -= path[i - 1];
+  }
+}
@@ -0,0 +1,289 @@
+#include "stochastic_models/distributions/random.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+
+/**
+ * @brief Philox4x32 round multipliers, Weyl key increments and round count.
+ *
+ */
+static constexpr std::uint32_t philox_m0 = 0xD2511F53U;
+static constexpr std::uint32_t philox_m1 = 0xCD9E8D57U;
+static constexpr std::uint32_t philox_w0 = 0x9E3779B9U;
+static constexpr std::uint32_t philox_w1 = 0xBB67AE85U;
+static constexpr unsigned int philox_rounds = 10;
+/**
+ * @brief Number of Box–Muller pairs transformed together by fillNormal.
+ *
+ */
+static constexpr std::size_t normal_block_pairs = 128;
+/**
+ * @brief Fewest Box–Muller pairs transformed by the bulk kernel; a final
+ * partial block of at least this many pairs is transformed in bulk too, so
+ * that the antithetic half of a simulation path block takes the bulk path.
+ *
+ */
+static constexpr std::size_t normal_bulk_min_pairs = 32;
+
+/**
+ * @brief Apply the ten Philox4x32 rounds to a counter in place.
+ *
+ * Operates on scalars rather than arrays so that bulk generation over many
+ * counters can be vectorized across counters.
+ *
+ */
+static inline void philoxRounds(
+    std::uint32_t& c0,
+    std::uint32_t& c1,
+    std::uint32_t& c2,
+    std::uint32_t& c3,
+    std::uint32_t k0,
+    std::uint32_t k1
+) {
+  for (unsigned int round{0}; round < philox_rounds; ++round) {
+    const std::uint64_t product0 = static_cast<std::uint64_t>(philox_m0) * c0;
+    const std::uint64_t product1 = static_cast<std::uint64_t>(philox_m1) * c2;
+    c0 = static_cast<std::uint32_t>(product1 >> 32) ^ c1 ^ k0;
+    c1 = static_cast<std::uint32_t>(product1);
+    c2 = static_cast<std::uint32_t>(product0 >> 32) ^ c3 ^ k1;
+    c3 = static_cast<std::uint32_t>(product0);
+    k0 += philox_w0;
+    k1 += philox_w1;
+  }
+}
+/**
+ * @brief Combine two 32-bit outputs into a uniform value in [0, 1) with 53
+ * bits of precision.
+ *
+ */
+static inline double uniformFromWords(
+    const std::uint32_t high, const std::uint32_t low
+) {
+  return ((high >> 5) * 67108864.0 + (low >> 6)) *
+         (1.0 / 9007199254740992.0);
+}
+/**
+ * @brief Branch-free natural logarithm of a positive, normal double.
+ *
+ * Splits x into 2^e * m with m in [sqrt(1/2), sqrt(2)) using integer
+ * operations on its bit pattern and evaluates log(m) = 2 atanh((m - 1) /
+ * (m + 1)) with a truncated series accurate to double precision over that
+ * range.
+ *
+ */
+static inline double polynomialLog(const double x) {
+  const std::uint64_t bits = std::bit_cast<std::uint64_t>(x);
+  const std::uint64_t fraction = bits & 0x000FFFFFFFFFFFFFULL;
+  // 1 when the mantissa exceeds sqrt(2) and is halved into [sqrt(1/2), 1).
+  const std::uint64_t upper = fraction > 0x0006A09E667F3BCCULL;
+  const double mantissa =
+      std::bit_cast<double>(fraction | ((0x3FFULL - upper) << 52));
+  // Adding the biased exponent to the mantissa of 2^52 converts it exactly.
+  const double exponent =
+      std::bit_cast<double>(((bits >> 52) + upper) | 0x4330000000000000ULL) -
+      (4503599627370496.0 + 1023.0);
+
+  const double s = (mantissa - 1.0) / (mantissa + 1.0);
+  const double s2 = s * s;
+  double series = 1.0 / 21.0;
+  series = series * s2 + 1.0 / 19.0;
+  series = series * s2 + 1.0 / 17.0;
+  series = series * s2 + 1.0 / 15.0;
+  series = series * s2 + 1.0 / 13.0;
+  series = series * s2 + 1.0 / 11.0;
+  series = series * s2 + 1.0 / 9.0;
+  series = series * s2 + 1.0 / 7.0;
+  series = series * s2 + 1.0 / 5.0;
+  series = series * s2 + 1.0 / 3.0;
+  series = series * s2 + 1.0;
+  return exponent * std::numbers::ln2 + 2.0 * s * series;
+}
+/**
+ * @brief Branch-free cosine and sine of 2 pi u for u in [0, 1).
+ *
+ * Reduces the angle to r in [-pi/4, pi/4] around the nearest quarter turn,
+ * evaluates truncated Taylor series for sin(r) and cos(r) and selects their
+ * order and signs from the quarter turn index.
+ *
+ */
+static inline void
+polynomialSinCos(const double u, double& cosine, double& sine) {
+  const double turns = 4.0 * u;
+  // Adding 2^52 rounds to the nearest integer, whose low bits hold the
+  // quadrant index modulo 4.
+  const double shifted = turns + 4503599627370496.0;
+  const double nearest = shifted - 4503599627370496.0;
+  const double r = (turns - nearest) * (0.5 * std::numbers::pi);
+  const std::uint64_t quadrant = std::bit_cast<std::uint64_t>(shifted) & 3;
+
+  const double r2 = r * r;
+  double sin_series = -1.0 / 1307674368000.0;
+  sin_series = sin_series * r2 + 1.0 / 6227020800.0;
+  sin_series = sin_series * r2 - 1.0 / 39916800.0;
+  sin_series = sin_series * r2 + 1.0 / 362880.0;
+  sin_series = sin_series * r2 - 1.0 / 5040.0;
+  sin_series = sin_series * r2 + 1.0 / 120.0;
+  sin_series = sin_series * r2 - 1.0 / 6.0;
+  const double sin_r = r + r * r2 * sin_series;
+  double cos_series = 1.0 / 20922789888000.0;
+  cos_series = cos_series * r2 - 1.0 / 87178291200.0;
+  cos_series = cos_series * r2 + 1.0 / 479001600.0;
+  cos_series = cos_series * r2 - 1.0 / 3628800.0;
+  cos_series = cos_series * r2 + 1.0 / 40320.0;
+  cos_series = cos_series * r2 - 1.0 / 720.0;
+  cos_series = cos_series * r2 + 1.0 / 24.0;
+  cos_series = cos_series * r2 - 0.5;
+  const double cos_r = 1.0 + r2 * cos_series;
+
+  // Odd quadrants swap sine and cosine; the sign of the cosine flips in
+  // quadrants 1 and 2 and the sign of the sine in quadrants 2 and 3.
+  const std::uint64_t odd = 0 - (quadrant & 1);
+  const std::uint64_t cos_sign = ((quadrant ^ (quadrant >> 1)) & 1) << 63;
+  const std::uint64_t sin_sign = (quadrant >> 1) << 63;
+  const std::uint64_t sin_bits = std::bit_cast<std::uint64_t>(sin_r);
+  const std::uint64_t cos_bits = std::bit_cast<std::uint64_t>(cos_r);
+  cosine = std::bit_cast<double>(
+      ((sin_bits & odd) | (cos_bits & ~odd)) ^ cos_sign
+  );
+  sine = std::bit_cast<double>(
+      ((cos_bits & odd) | (sin_bits & ~odd)) ^ sin_sign
+  );
+}
+
+PhiloxEngine::PhiloxEngine(const std::uint64_t seed, const std::uint64_t stream)
+    : key{}, counter{}, buffer{}, index(4), cached_normal(0.0),
+      has_cached_normal(false) {
+  PhiloxEngine::seed(seed, stream);
+}
+void PhiloxEngine::seed(const std::uint64_t seed, const std::uint64_t stream) {
+  key = {
+      static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)
+  };
+  counter = {
+      0, 0, static_cast<std::uint32_t>(stream),
+      static_cast<std::uint32_t>(stream >> 32)
+  };
+  index = 4;
+  has_cached_normal = false;
+}
+PhiloxEngine PhiloxEngine::split(const std::uint64_t stream) const {
+  return PhiloxEngine(getSeed(), stream);
+}
+PhiloxEngine::counter_type
+PhiloxEngine::generateBlock(counter_type counter, key_type key) {
+  philoxRounds(counter[0], counter[1], counter[2], counter[3], key[0], key[1]);
+  return counter;
+}
+PhiloxEngine::counter_type PhiloxEngine::nextBlock() {
+  const counter_type block = generateBlock(counter, key);
+  // Only the lower 64 bits count blocks; the upper 64 bits are the stream.
+  if (++counter[0] == 0) {
+    ++counter[1];
+  }
+  return block;
+}
+PhiloxEngine::result_type PhiloxEngine::operator()() {
+  if (index == 4) {
+    buffer = nextBlock();
+    index = 0;
+  }
+  return buffer[index++];
+}
+void PhiloxEngine::discard(const unsigned long long n) {
+  has_cached_normal = false;
+  const unsigned long long position = (4 - index) % 4;
+  if (n <= position) {
+    index += static_cast<unsigned int>(n);
+    return;
+  }
+  // Skip whole blocks by moving the counter, then regenerate the partial one.
+  const unsigned long long remaining = n - position;
+  std::uint64_t blocks =
+      (static_cast<std::uint64_t>(counter[1]) << 32) | counter[0];
+  blocks += remaining / 4;
+  counter[0] = static_cast<std::uint32_t>(blocks);
+  counter[1] = static_cast<std::uint32_t>(blocks >> 32);
+  index = 4;
+  if (remaining % 4 != 0) {
+    buffer = nextBlock();
+    index = static_cast<unsigned int>(remaining % 4);
+  }
+}
+double PhiloxEngine::uniform() {
+  const std::uint32_t high = (*this)();
+  const std::uint32_t low = (*this)();
+  return uniformFromWords(high, low);
+}
+double PhiloxEngine::normal() {
+  if (has_cached_normal) {
+    has_cached_normal = false;
+    return cached_normal;
+  }
+  // 1 - uniform lies in (0, 1], keeping the logarithm finite.
+  const double radius = std::sqrt(-2.0 * std::log(1.0 - uniform()));
+  const double theta = 2.0 * std::numbers::pi * uniform();
+  cached_normal = radius * std::sin(theta);
+  has_cached_normal = true;
+  return radius * std::cos(theta);
+}
+void PhiloxEngine::fillNormal(std::span<double> out) {
+  std::size_t position{0};
+  if (has_cached_normal && !out.empty()) {
+    out[0] = cached_normal;
+    has_cached_normal = false;
+    position = 1;
+  }
+  if (out.size() - position >= 2 * normal_bulk_min_pairs) {
+    // Bulk draws start on a block boundary.
+    index = 4;
+    std::uint64_t blocks =
+        (static_cast<std::uint64_t>(counter[1]) << 32) | counter[0];
+    std::array<double, normal_block_pairs> radius_uniforms;
+    std::array<double, normal_block_pairs> angle_uniforms;
+
+    while (out.size() - position >= 2 * normal_bulk_min_pairs) {
+      const std::size_t pairs =
+          std::min(normal_block_pairs, (out.size() - position) / 2);
+      for (std::size_t i{0}; i < pairs; ++i) {
+        const std::uint64_t block_counter = blocks + i;
+        std::uint32_t c0 = static_cast<std::uint32_t>(block_counter);
+        std::uint32_t c1 = static_cast<std::uint32_t>(block_counter >> 32);
+        std::uint32_t c2 = counter[2];
+        std::uint32_t c3 = counter[3];
+        philoxRounds(c0, c1, c2, c3, key[0], key[1]);
+        // 1 - uniform lies in (0, 1], keeping the logarithm finite.
+        radius_uniforms[i] = 1.0 - uniformFromWords(c0, c1);
+        angle_uniforms[i] = uniformFromWords(c2, c3);
+      }
+      blocks += pairs;
+
+      double* const cosines = out.data() + position;
+      double* const sines = cosines + pairs;
+      for (std::size_t i{0}; i < pairs; ++i) {
+        const double radius =
+            std::sqrt(-2.0 * polynomialLog(radius_uniforms[i]));
+        double cosine;
+        double sine;
+        polynomialSinCos(angle_uniforms[i], cosine, sine);
+        cosines[i] = radius * cosine;
+        sines[i] = radius * sine;
+      }
+      position += 2 * pairs;
+    }
+    counter[0] = static_cast<std::uint32_t>(blocks);
+    counter[1] = static_cast<std::uint32_t>(blocks >> 32);
+  }
+  // Scalar fallback for the remainder.
+  for (; position < out.size(); ++position) {
+    out[position] = normal();
+  }
+}
+const std::uint64_t PhiloxEngine::getSeed() const {
+  return (static_cast<std::uint64_t>(key[1]) << 32) | key[0];
+}
+const std::uint64_t PhiloxEngine::getStream() const {
+  return (static_cast<std::uint64_t>(counter[3]) << 32) | counter[2];
+}
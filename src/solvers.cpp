@@ -4,67 +4,345 @@
 #include "stochastic_models/exceptions/gsl_errors.h"
 #include "stochastic_models/numeric_utils/helpers.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <math.h>
+#include <optional>
+#include <stdexcept>
+#include <string>
 
-BrentSolverState::BrentSolverState() {
-  fsolver_type = gsl_root_fsolver_brent;
-  fsolver = gsl_root_fsolver_alloc(fsolver_type);
+/**
+ * @brief Adapts a ModelFuncFdf to the ModelFunc taken by the bracketing
+ * solvers.
+ *
+ */
+struct FdfParams {
+  ModelFuncFdf fdf;
+  void* model;
+};
+
+/**
+ * @brief Returns the function value of the ModelFuncFdf in params.
+ *
+ * @param x The point at which to evaluate the function.
+ * @param params Pointer to the FdfParams to evaluate.
+ * @return double The function value at x.
+ */
+static double fdfValue(double x, void* params) {
+  const FdfParams* p = static_cast<const FdfParams*>(params);
+  double f, df;
+  p->fdf(x, p->model, &f, &df);
+  return f;
 }
-BrentSolverState::~BrentSolverState() {
-  if (fsolver != nullptr) {
-    gsl_root_fsolver_free(fsolver);
-    fsolver = nullptr;
+
+/**
+ * @brief A solver owned by a thread and whether a solve is using it.
+ *
+ */
+struct ThreadSolver {
+  // The solver.
+  BrentSolverState state;
+  // Whether a solve on the thread is using the solver.
+  bool in_use{false};
+
+  explicit ThreadSolver(const gsl_root_fsolver_type* type) : state(type) {}
+};
+
+/**
+ * @brief Returns the calling thread's solver of a type, allocated on first
+ * use.
+ *
+ * @param type The Brent or bisection solver type.
+ * @return ThreadSolver& The thread's solver.
+ */
+static ThreadSolver& threadSolver(const gsl_root_fsolver_type* type) {
+  if (type == gsl_root_fsolver_bisection) {
+    thread_local ThreadSolver bisection(gsl_root_fsolver_bisection);
+    return bisection;
   }
+  thread_local ThreadSolver brent(gsl_root_fsolver_brent);
+  return brent;
 }
 
-const double
-brentSolver(ModelFunc fn, void* model, double& lower, double& upper) {
-  if (lower >= upper) {
-    throw std::invalid_argument(
-        "Invalid interval: lower bound must be less than upper bound."
-    );
+/**
+ * @brief Lends a solve the calling thread's solver, so repeated solves do not
+ * allocate. A solve started while the thread's solver is lent, such as one
+ * made by the function being solved, gets a solver of its own.
+ *
+ */
+class SolverLease {
+public:
+  explicit SolverLease(const gsl_root_fsolver_type* type)
+      : shared(threadSolver(type)) {
+    if (shared.in_use) {
+      owned.emplace(type);
+      fsolver = owned->fsolver;
+    } else {
+      shared.in_use = true;
+      fsolver = shared.state.fsolver;
+    }
+    if (fsolver == nullptr) {
+      std::cerr << "Error: failed to allocate memory for solver." << std::endl;
+      throw NoMemoryError();
+    }
+  }
+  SolverLease(const SolverLease&) = delete;
+  SolverLease& operator=(const SolverLease&) = delete;
+  ~SolverLease() {
+    if (!owned) {
+      shared.in_use = false;
+    }
   }
 
-  BrentSolverState solver_state;
+  // The lent solver.
+  gsl_root_fsolver* fsolver;
 
-  // Catch error if solver cannot be allocated.
-  if (solver_state.fsolver == nullptr) {
-    std::cerr << "Error: failed to allocate memory for solver." << std::endl;
-    throw NoMemoryError();
-  }
+private:
+  // The thread's solver of the requested type.
+  ThreadSolver& shared;
+  // A solver of this lease's own when the thread's solver was already lent.
+  std::optional<BrentSolverState> owned;
+};
+
+/**
+ * @brief Finds a root with a GSL bracketing solver.
+ *
+ * @param fn The function whose root is sought.
+ * @param model Opaque model/context pointer passed to fn.
+ * @param lower Lower bound of the bracketing interval.
+ * @param upper Upper bound of the bracketing interval.
+ * @param options The Brent or Bisection method, tolerances and budget.
+ * @param straddle Whether fn must change sign over the interval. If not,
+ * the solver iterates from the interval regardless, as brentSolver always
+ * has.
+ * @return const SolverResult The root, final bracket and iteration count.
+ */
+static const SolverResult bracketingSolve(
+    ModelFunc fn,
+    void* model,
+    const double lower,
+    const double upper,
+    const SolverOptions& options,
+    const bool straddle = true
+) {
+  disableGslErrorHandler();
+  const SolverLease solver_state(
+      options.method == RootMethod::Bisection ? gsl_root_fsolver_bisection
+                                              : gsl_root_fsolver_brent
+  );
 
   gsl_function F;
   F.function = fn;
   F.params = model;
 
-  // Set custom error handler.
-  gsl_error_handler_t* old_handler =
-      gsl_set_error_handler(&custom_gsl_exception_handler);
-
   int status = gsl_root_fsolver_set(solver_state.fsolver, &F, lower, upper);
+  if (status == GSL_EINVAL && straddle) {
+    throw NoSolutionError("Function does not change sign over the interval.");
+  }
+  if (status != GSL_EINVAL) {
+    check_function_status(status, {});
+  }
 
-  // We are choosing to ignore an invalid interval as we aren't always
-  // straddling y = 0.
-  const std::vector<int> ignore_codes = {GSL_EINVAL};
-  check_function_status(status, ignore_codes);
-
-  int iter = 0, max_iter = 100;
-  double result = 0, x_lo = 0, x_hi = 0;
-  do {
-    iter++;
+  SolverResult result{0.5 * (lower + upper), lower, upper, 0, false};
+  while (!result.converged && result.iterations < options.max_iterations) {
+    ++result.iterations;
     status = gsl_root_fsolver_iterate(solver_state.fsolver);
-    result = gsl_root_fsolver_root(solver_state.fsolver);
-    x_lo = gsl_root_fsolver_x_lower(solver_state.fsolver);
-    x_hi = gsl_root_fsolver_x_upper(solver_state.fsolver);
-    status = gsl_root_test_interval(x_lo, x_hi, 0, 0.0001);
+    // An iteration fails if the function is not finite at the new point.
+    check_function_status(status, {});
+    result.root = gsl_root_fsolver_root(solver_state.fsolver);
+    result.lower = gsl_root_fsolver_x_lower(solver_state.fsolver);
+    result.upper = gsl_root_fsolver_x_upper(solver_state.fsolver);
+    result.converged = gsl_root_test_interval(
+                           result.lower,
+                           result.upper,
+                           options.epsabs,
+                           options.epsrel
+                       ) == GSL_SUCCESS;
+  }
+  return result;
+}
+
+/**
+ * @brief Finds a root with Newton's method, optionally with Aitken
+ * acceleration, keeping a bracket and bisecting it whenever a step leaves it
+ * or fails to halve the step before last.
+ *
+ * @param fdf Function evaluating the function and its derivative.
+ * @param model Opaque model/context pointer passed to fdf.
+ * @param lower Lower bound of the bracketing interval.
+ * @param upper Upper bound of the bracketing interval.
+ * @param options The Newton or Steffenson method, tolerances and budget.
+ * @return const SolverResult The root, final bracket and iteration count.
+ */
+static const SolverResult derivativeSolve(
+    ModelFuncFdf fdf,
+    void* model,
+    const double lower,
+    const double upper,
+    const SolverOptions& options
+) {
+  double f_lower, f_upper, df;
+  fdf(lower, model, &f_lower, &df);
+  fdf(upper, model, &f_upper, &df);
+  if (!std::isfinite(f_lower) || !std::isfinite(f_upper)) {
+    throw NoSolutionError(
+        "Root finding solver failed due to no solution at a single point."
+    );
+  }
+  if (f_lower == 0.0) {
+    return SolverResult{lower, lower, lower, 0, true};
+  }
+  if (f_upper == 0.0) {
+    return SolverResult{upper, upper, upper, 0, true};
+  }
+  if ((f_lower > 0.0) == (f_upper > 0.0)) {
+    throw NoSolutionError("Function does not change sign over the interval.");
+  }
+
+  // Ends of the bracket where the function is negative and positive.
+  double negative = f_lower < 0.0 ? lower : upper;
+  double positive = f_lower < 0.0 ? upper : lower;
+
+  SolverResult result{0.5 * (lower + upper), lower, upper, 0, false};
+  double x = result.root, f;
+  fdf(x, model, &f, &df);
+  double previous = std::numeric_limits<double>::quiet_NaN();
+  double step = upper - lower, step_before = step;
+  while (!result.converged && result.iterations < options.max_iterations) {
+    if (!std::isfinite(f) || !std::isfinite(df)) {
+      throw NoSolutionError(
+          "Root finding solver failed due to no solution at a single point."
+      );
+    }
+    if (f == 0.0) {
+      result.converged = true;
+      break;
+    }
+    ++result.iterations;
+    (f < 0.0 ? negative : positive) = x;
+    result.lower = std::min(negative, positive);
+    result.upper = std::max(negative, positive);
 
-  } while (status == GSL_CONTINUE && iter < max_iter);
+    double candidate = x - f / df;
+    if (options.method == RootMethod::Steffenson && std::isfinite(previous)) {
+      const double accelerated =
+          candidate - (candidate - x) * (candidate - x) /
+                          ((candidate - x) - (x - previous));
+      if (std::isfinite(accelerated)) {
+        candidate = accelerated;
+      }
+    }
+    // Division by a vanishing derivative gives a non-finite candidate, which
+    // is not inside the bracket either.
+    const bool inside = candidate > result.lower && candidate < result.upper;
+    if (!inside || std::abs(candidate - x) > 0.5 * std::abs(step_before)) {
+      candidate = 0.5 * (result.lower + result.upper);
+    }
 
-  // Restore original handler.
-  gsl_set_error_handler(old_handler);
+    step_before = step;
+    step = candidate - x;
+    previous = x;
+    x = candidate;
+    fdf(x, model, &f, &df);
+    result.root = x;
+    result.converged =
+        gsl_root_test_delta(x, previous, options.epsabs, options.epsrel) ==
+            GSL_SUCCESS ||
+        gsl_root_test_interval(
+            result.lower, result.upper, options.epsabs, options.epsrel
+        ) == GSL_SUCCESS;
+  }
+  if (!std::isfinite(f)) {
+    throw NoSolutionError(
+        "Root finding solver failed due to no solution at a single point."
+    );
+  }
+  return result;
+}
 
-  const double value = result;
+BrentSolverState::BrentSolverState()
+    : BrentSolverState(gsl_root_fsolver_brent) {}
+BrentSolverState::BrentSolverState(const gsl_root_fsolver_type* type) {
+  fsolver_type = type;
+  fsolver = gsl_root_fsolver_alloc(fsolver_type);
+}
+BrentSolverState::~BrentSolverState() {
+  if (fsolver != nullptr) {
+    gsl_root_fsolver_free(fsolver);
+    fsolver = nullptr;
+  }
+}
 
-  return value;
+const double brentSolver(
+    ModelFunc fn,
+    void* model,
+    double& lower,
+    double& upper,
+    const SolverOptions& options
+) {
+  if (lower >= upper) {
+    throw std::invalid_argument(
+        "Invalid interval: lower bound must be less than upper bound."
+    );
+  }
+  if (options.method == RootMethod::Newton ||
+      options.method == RootMethod::Steffenson) {
+    throw std::invalid_argument(
+        "Newton and Steffenson methods need the derivative of the function."
+    );
+  }
+  // We are choosing to ignore an invalid interval as we aren't always
+  // straddling y = 0.
+  const SolverResult result =
+      bracketingSolve(fn, model, lower, upper, options, false);
+  lower = result.lower;
+  upper = result.upper;
+  if (!result.converged) {
+    throw NoSolutionError(
+        "Root not found to the requested tolerance after " +
+        std::to_string(result.iterations) + " iterations."
+    );
+  }
+  return result.root;
+}
+const SolverResult solveRoot(
+    ModelFunc fn,
+    void* model,
+    const double lower,
+    const double upper,
+    const SolverOptions& options
+) {
+  if (lower >= upper) {
+    throw std::invalid_argument(
+        "Invalid interval: lower bound must be less than upper bound."
+    );
+  }
+  if (options.method == RootMethod::Newton ||
+      options.method == RootMethod::Steffenson) {
+    throw std::invalid_argument(
+        "Newton and Steffenson methods need the derivative of the function."
+    );
+  }
+  return bracketingSolve(fn, model, lower, upper, options);
+}
+const SolverResult solveRoot(
+    ModelFuncFdf fdf,
+    void* model,
+    const double lower,
+    const double upper,
+    const SolverOptions& options
+) {
+  if (lower >= upper) {
+    throw std::invalid_argument(
+        "Invalid interval: lower bound must be less than upper bound."
+    );
+  }
+  if (options.method == RootMethod::Brent ||
+      options.method == RootMethod::Bisection) {
+    FdfParams params{fdf, model};
+    return bracketingSolve(fdfValue, &params, lower, upper, options);
+  }
+  return derivativeSolve(fdf, model, lower, upper, options);
 }
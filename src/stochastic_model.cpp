@@ -1,2 +1,27 @@
 #include "stochastic_models/sde/stochastic_model.h"
+
+#include <atomic>
+#include <limits>
+
+/**
+ * @brief Next stream id given to a copied model. Ids are handed out from the
+ * largest down so they stay clear of the ids passed to seed.
+ *
+ */
+static std::atomic<std::uint64_t> next_copy_stream{
+    std::numeric_limits<std::uint64_t>::max()
+};
+
+StochasticModel::StochasticModel(const StochasticModel& other)
+    : dist(other.dist) {
+  dist.seed(
+      other.dist.getSeed(),
+      next_copy_stream.fetch_sub(1, std::memory_order_relaxed)
+  );
+}
 StochasticModel::~StochasticModel() {};
+void StochasticModel::seed(
+    const std::uint64_t seed, const std::uint64_t stream
+) {
+  dist.seed(seed, stream);
+}
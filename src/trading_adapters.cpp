@@ -0,0 +1,55 @@
+#include "stochastic_models/trading/adapters.h"
+
+#include "stochastic_models/exceptions/errors.h"
+
+// nlohmann suggested to improve the depth of error reporting from json objects.
+// When enabled, exception messages contain a JSON Pointer to the JSON value
+// that triggered the exception. This carries additional runtime overhead.
+// https://json.nlohmann.me/home/exceptions/#extended-diagnostic-messages
+#ifndef JSON_DIAGNOSTICS
+#define JSON_DIAGNOSTICS 0
+#endif
+#include <nlohmann/json.hpp>
+const std::string
+TransformTableJsonAdapter::serialize(const TransformTable& table) const {
+  nlohmann::json panels = nlohmann::json::array();
+  for (const TransformTablePanel& panel : table.getPanels()) {
+    panels.push_back(
+        {{"drift_lower", panel.drift_lower},
+         {"drift_upper", panel.drift_upper},
+         {"log_f", panel.log_f},
+         {"log_f_prime", panel.log_f_prime},
+         {"log_g", panel.log_g},
+         {"log_g_prime", panel.log_g_prime}}
+    );
+  }
+  nlohmann::json json_obj = {
+      {"exponent", table.getExponent()},
+      {"tolerance", table.getTolerance()},
+      {"panels", panels}
+  };
+  return json_obj.dump();
+}
+const TransformTable
+TransformTableJsonAdapter::deserialize(const std::string& state) const {
+  try {
+    nlohmann::json json_obj = nlohmann::json::parse(state);
+    std::vector<TransformTablePanel> panels;
+    for (const nlohmann::json& panel : json_obj.at("panels")) {
+      TransformTablePanel& restored = panels.emplace_back();
+      panel.at("drift_lower").get_to(restored.drift_lower);
+      panel.at("drift_upper").get_to(restored.drift_upper);
+      panel.at("log_f").get_to(restored.log_f);
+      panel.at("log_f_prime").get_to(restored.log_f_prime);
+      panel.at("log_g").get_to(restored.log_g);
+      panel.at("log_g_prime").get_to(restored.log_g_prime);
+    }
+    return TransformTable(
+        json_obj.at("exponent").template get<double>(),
+        json_obj.at("tolerance").template get<double>(),
+        std::move(panels)
+    );
+  } catch (const nlohmann::json::exception& exc) {
+    throw TransformTableParseError(exc.what());
+  }
+}
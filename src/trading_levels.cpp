@@ -1,5 +1,6 @@
 #include "stochastic_models/trading/trading_levels.h"
 
+#include "stochastic_models/exceptions/errors.h"
 #include "stochastic_models/numeric_utils/helpers.h"
 #include "stochastic_models/numeric_utils/solvers.h"
 #include "stochastic_models/trading/optimal_mean_reversion.h"
@@ -7,10 +8,64 @@
 
 #include <algorithm>
 #include <iostream>
+#include <limits>
+
+/**
+ * @brief Half width of the first bracket around an approximate level in
+ * stationary standard deviations. The approximate levels of typical discount
+ * rates land within it.
+ *
+ */
+static constexpr double bracket_step = 0.1;
+/**
+ * @brief Absolute tolerance of the approximate levels in stationary standard
+ * deviations, a tenth of bracket_step.
+ *
+ */
+static constexpr double approximation_tolerance = 1e-2;
+
+/**
+ * @brief Brackets a root of an exact root function around the root of its
+ * closed-form approximation.
+ *
+ * If the approximation does not change sign over [lower, upper] the search
+ * starts from the midpoint, so the bracket is never worse than the bounds.
+ *
+ * @param approximate Callable taking x and returning the approximate root
+ * function at x.
+ * @param exact Callable taking x and returning the exact root function at x.
+ * @param deviation The stationary standard deviation of the process.
+ * @param lower The lower solver bound.
+ * @param upper The upper solver bound.
+ * @return const RootBracket An interval over which exact changes sign.
+ * @throws NoSolutionError if exact does not change sign over [lower, upper].
+ */
+template <typename Approximate, typename Exact>
+static const RootBracket approximateBracket(
+    Approximate& approximate,
+    Exact& exact,
+    const double deviation,
+    const double lower,
+    const double upper
+) {
+  double guess = 0.5 * (lower + upper);
+  try {
+    SolverOptions options;
+    options.epsabs = approximation_tolerance * deviation;
+    options.epsrel = 0.0;
+    guess = solve(approximate, lower, upper, options).root;
+  } catch (const NoSolutionError&) {
+  }
+  return expandBracket(exact, guess, bracket_step * deviation, lower, upper);
+}
+
 OrnsteinUhlenbeckTradingLevels::OrnsteinUhlenbeckTradingLevels(
     const double mu, const double alpha, const double sigma
 )
     : optimizer(std::make_unique<OptimalMeanReversion>()),
+      approximation(std::make_unique<OptimalMeanReversion>(
+          TransformQuadrature::Asymptotic
+      )),
       model(std::make_unique<OrnsteinUhlenbeckModel>(mu, alpha, sigma)),
       hitting_time_kernel(
           std::make_unique<HittingTimeOrnsteinUhlenbeck>(mu, alpha, sigma)
@@ -19,6 +74,10 @@ const OptimalMeanReversion*
 OrnsteinUhlenbeckTradingLevels::getOptimizer() const {
   return optimizer.get();
 };
+const OptimalMeanReversion*
+OrnsteinUhlenbeckTradingLevels::getApproximation() const {
+  return approximation.get();
+}
 const StochasticModel* OrnsteinUhlenbeckTradingLevels::getModel() const {
   return model.get();
 };
@@ -48,99 +107,176 @@ const double OrnsteinUhlenbeckTradingLevels::optimalExitUpperBound() const {
 const double OrnsteinUhlenbeckTradingLevels::optimalEntryLowerBound() const {
   return lowerSolverBound(getModel());
 }
+const RootBracket OrnsteinUhlenbeckTradingLevels::optimalExitBracket(
+    const double& stop_loss, const double& r, const double& c
+) const {
+  const HittingTimeOrnsteinUhlenbeck* kernel = getHittingTimeKernel();
+  auto approximate = [&](const double x) {
+    return getApproximation()->b(x, kernel, stop_loss, r, c);
+  };
+  auto exact = [&](const double x) {
+    return getOptimizer()->b(x, kernel, stop_loss, r, c);
+  };
+  return approximateBracket(
+      approximate,
+      exact,
+      1.0 / kernel->optimalTradingScale(),
+      optimalExitLowerBound(r, c),
+      optimalExitUpperBound()
+  );
+}
+const RootBracket OrnsteinUhlenbeckTradingLevels::optimalExitBracket(
+    const double& r, const double& c
+) const {
+  const HittingTimeOrnsteinUhlenbeck* kernel = getHittingTimeKernel();
+  auto approximate = [&](const double x) {
+    return getApproximation()->b(x, kernel, r, c);
+  };
+  auto exact = [&](const double x) {
+    return getOptimizer()->b(x, kernel, r, c);
+  };
+  return approximateBracket(
+      approximate,
+      exact,
+      1.0 / kernel->optimalTradingScale(),
+      optimalExitLowerBound(r, c),
+      optimalExitUpperBound()
+  );
+}
+const RootBracket OrnsteinUhlenbeckTradingLevels::optimalEntryBracket(
+    const double& b_star,
+    const double& stop_loss,
+    const double& r,
+    const double& c
+) const {
+  const HittingTimeOrnsteinUhlenbeck* kernel = getHittingTimeKernel();
+  const ValueFunctionCoefficients approximate_coefficients =
+      getApproximation()->valueFunction(kernel, b_star, stop_loss, r, c);
+  const ValueFunctionCoefficients coefficients =
+      getOptimizer()->valueFunction(kernel, b_star, stop_loss, r, c);
+  auto approximate = [&](const double x) {
+    return getApproximation()->d(
+        x, kernel, approximate_coefficients, b_star, stop_loss, r, c
+    );
+  };
+  auto exact = [&](const double x) {
+    return getOptimizer()->d(x, kernel, coefficients, b_star, stop_loss, r, c);
+  };
+  return approximateBracket(
+      approximate,
+      exact,
+      1.0 / kernel->optimalTradingScale(),
+      stop_loss,
+      b_star
+  );
+}
+const RootBracket OrnsteinUhlenbeckTradingLevels::optimalEntryBracket(
+    const double& b_star, const double& r, const double& c
+) const {
+  const HittingTimeOrnsteinUhlenbeck* kernel = getHittingTimeKernel();
+  auto approximate = [&](const double x) {
+    return getApproximation()->d(x, kernel, b_star, r, c);
+  };
+  auto exact = [&](const double x) {
+    return getOptimizer()->d(x, kernel, b_star, r, c);
+  };
+  return approximateBracket(
+      approximate,
+      exact,
+      1.0 / kernel->optimalTradingScale(),
+      optimalEntryLowerBound(),
+      b_star
+  );
+}
+const RootBracket OrnsteinUhlenbeckTradingLevels::optimalEntryLowerBracket(
+    const double& d_star,
+    const double& b_star,
+    const double& stop_loss,
+    const double& r,
+    const double& c
+) const {
+  const HittingTimeOrnsteinUhlenbeck* kernel = getHittingTimeKernel();
+  const ValueFunctionCoefficients approximate_coefficients =
+      getApproximation()->valueFunction(kernel, b_star, stop_loss, r, c);
+  const ValueFunctionCoefficients coefficients =
+      getOptimizer()->valueFunction(kernel, b_star, stop_loss, r, c);
+  auto approximate = [&](const double x) {
+    return getApproximation()->a(
+        x, kernel, approximate_coefficients, b_star, stop_loss, r, c
+    );
+  };
+  auto exact = [&](const double x) {
+    return getOptimizer()->a(x, kernel, coefficients, b_star, stop_loss, r, c);
+  };
+  return approximateBracket(
+      approximate,
+      exact,
+      1.0 / kernel->optimalTradingScale(),
+      stop_loss,
+      d_star
+  );
+}
 const double OrnsteinUhlenbeckTradingLevels::optimalExit(
     const double& stop_loss, const double& r, const double& c
 ) const {
-  // We need deep copies of the model and optimizer pointers to initialise the
-  // params instance. This is because GSL requires a pointer to void and we
-  // cannot use smart pointers with much benefit here. So we create deep
-  // copies and then free that memory in the destructor of the
-  // ExitLevelStopLossParams struct.
-  void* params = new ExitLevelStopLossParams{
-      newOptimizer(), newHittingTimeKernel(), stop_loss, r, c
+  ExitLevelStopLossView params{
+      getOptimizer(), getHittingTimeKernel(), stop_loss, r, c
   };
-  ModelFunc fn = funcOptimalMeanReversionB;
+  ModelFunc fn = funcOptimalMeanReversionStopLossB;
   double value{0.0};
   try {
-    double upper = optimalExitUpperBound();
-    double lower = optimalExitLowerBound(r, c);
-    value = brentSolver(fn, params, lower, upper);
+    const RootBracket bracket = optimalExitBracket(stop_loss, r, c);
+    double lower = bracket.lower;
+    double upper = bracket.upper;
+    value = brentSolver(fn, &params, lower, upper);
   } catch (const std::exception& e) {
     std::cout << "Exception " << e.what()
               << " caught in OrnsteinUhlenbeckTradingLevels::optimalExit "
                  "with stop loss."
               << std::endl;
-    delete static_cast<ExitLevelStopLossParams*>(params);
-    params = nullptr;
     throw;
   }
-  // Then cast the void pointer back to the original type and free the memory.
-  delete static_cast<ExitLevelStopLossParams*>(params);
-  params = nullptr;
   return value;
 }
 const double OrnsteinUhlenbeckTradingLevels::optimalExit(
     const double& r, const double& c
 ) const {
-  // We need deep copies of the model and optimizer pointers to initialise the
-  // params instance. This is because GSL requires a pointer to void and we
-  // cannot use smart pointers with much benefit here. So we create deep
-  // copies and then free that memory in the destructor of the ExitLevelParams
-  // struct.
-  void* params =
-      new ExitLevelParams{newOptimizer(), newHittingTimeKernel(), r, c};
+  ExitLevelView params{getOptimizer(), getHittingTimeKernel(), r, c};
   ModelFunc fn = funcOptimalMeanReversionB;
 
   double value{0.0};
   try {
-    double upper = optimalExitUpperBound();
-    double lower = optimalExitLowerBound(r, c);
-    value = brentSolver(fn, params, lower, upper);
+    const RootBracket bracket = optimalExitBracket(r, c);
+    double lower = bracket.lower;
+    double upper = bracket.upper;
+    value = brentSolver(fn, &params, lower, upper);
   } catch (const std::exception& e) {
     std::cout << "Exception " << e.what()
               << " caught in OrnsteinUhlenbeckTradingLevels::optimalExit "
                  "without stop loss."
               << std::endl;
-    delete static_cast<ExitLevelParams*>(params);
-    params = nullptr;
     throw;
   }
-  // Then cast the void pointer back to the original type and free the memory.
-  delete static_cast<ExitLevelParams*>(params);
-  params = nullptr;
   return value;
 }
 const double OrnsteinUhlenbeckTradingLevels::optimalEntryLower(
     const double& d_star, const double& b_star, const double& r, const double& c
 ) const {
-  // We need deep copies of the model and optimizer pointers to initialise the
-  // params instance. This is because GSL requires a pointer to void and we
-  // cannot use smart pointers with much benefit here. So we create deep
-  // copies and then free that memory in the destructor of the
-  // EntryLevelParams struct.
-  void* params = new EntryLevelParams{
-      newOptimizer(), newHittingTimeKernel(), b_star, r, c
-  };
+  EntryLevelView params{getOptimizer(), getHittingTimeKernel(), b_star, r, c};
   ModelFunc fn = funcOptimalMeanReversionA;
 
   double value{0.0};
   try {
     double lower = optimalEntryLowerBound();
     double upper = d_star;
-    value = brentSolver(fn, params, lower, upper);
+    value = brentSolver(fn, &params, lower, upper);
   } catch (const std::exception& e) {
     std::cout << "Exception " << e.what()
               << " caught in OrnsteinUhlenbeckTradingLevels::optimalEntryLower "
                  "without stop loss."
               << std::endl;
-    delete static_cast<EntryLevelParams*>(params);
-    params = nullptr;
     throw;
   }
-
-  // Then cast the void pointer back to the original type and free the memory.
-  delete static_cast<EntryLevelParams*>(params);
-  params = nullptr;
   return value;
 }
 const double OrnsteinUhlenbeckTradingLevels::optimalEntryLower(
@@ -150,32 +286,24 @@ const double OrnsteinUhlenbeckTradingLevels::optimalEntryLower(
     const double& r,
     const double& c
 ) const {
-  // We need deep copies of the model and optimizer pointers to initialise the
-  // params instance. This is because GSL requires a pointer to void and we
-  // cannot use smart pointers with much benefit here. So we create deep
-  // copies and then free that memory in the destructor of the
-  // EntryLevelStopLossParams struct.
-  void* params = new EntryLevelStopLossParams{
-      newOptimizer(), newHittingTimeKernel(), b_star, stop_loss, r, c
+  EntryLevelStopLossView params{
+      getOptimizer(), getHittingTimeKernel(), b_star, stop_loss, r, c
   };
   ModelFunc fn = funcOptimalMeanReversionStopLossA;
   double value{0.0};
   try {
-    double lower = stop_loss;
-    double upper = d_star;
-    value = brentSolver(fn, params, lower, upper);
+    const RootBracket bracket =
+        optimalEntryLowerBracket(d_star, b_star, stop_loss, r, c);
+    double lower = bracket.lower;
+    double upper = bracket.upper;
+    value = brentSolver(fn, &params, lower, upper);
   } catch (const std::exception& e) {
     std::cout << "Exception " << e.what()
               << " caught in OrnsteinUhlenbeckTradingLevels::optimalEntryLower "
                  "with stop loss."
               << std::endl;
-    delete static_cast<EntryLevelStopLossParams*>(params);
-    params = nullptr;
     throw;
   }
-  // Then cast the void pointer back to the original type and free the memory.
-  delete static_cast<EntryLevelStopLossParams*>(params);
-  params = nullptr;
   return value;
 }
 const double OrnsteinUhlenbeckTradingLevels::optimalEntry(
@@ -184,62 +312,226 @@ const double OrnsteinUhlenbeckTradingLevels::optimalEntry(
     const double& r,
     const double& c
 ) const {
-  // We need deep copies of the model and optimizer pointers to initialise the
-  // params instance. This is because GSL requires a pointer to void and we
-  // cannot use smart pointers with much benefit here. So we create deep
-  // copies and then free that memory in the destructor of the
-  // EntryLevelStopLossParams struct.
-  void* params = new EntryLevelStopLossParams{
-      newOptimizer(), newHittingTimeKernel(), b_star, stop_loss, r, c
+  EntryLevelStopLossView params{
+      getOptimizer(), getHittingTimeKernel(), b_star, stop_loss, r, c
   };
   ModelFunc fn = funcOptimalMeanReversionStopLossD;
   double value{0.0};
   try {
-    double lower = stop_loss;
-    double upper = b_star;
-    value = brentSolver(fn, params, lower, upper);
+    const RootBracket bracket = optimalEntryBracket(b_star, stop_loss, r, c);
+    double lower = bracket.lower;
+    double upper = bracket.upper;
+    value = brentSolver(fn, &params, lower, upper);
   } catch (const std::exception& e) {
     std::cout << "Exception " << e.what()
               << " caught in OrnsteinUhlenbeckTradingLevels::optimalEntryLower "
                  "with stop loss."
               << std::endl;
-    delete static_cast<EntryLevelStopLossParams*>(params);
-    params = nullptr;
     throw;
   }
-  // Then cast the void pointer back to the original type and free the memory.
-  delete static_cast<EntryLevelStopLossParams*>(params);
-  params = nullptr;
   return value;
 }
 const double OrnsteinUhlenbeckTradingLevels::optimalEntry(
     const double& b_star, const double& r, const double& c
 ) const {
-  // We need deep copies of the model and optimizer pointers to initialise the
-  // params instance. This is because GSL requires a pointer to void and we
-  // cannot use smart pointers with much benefit here. So we create deep
-  // copies and then free that memory in the destructor of the
-  // EntryLevelParams struct.
-  void* params = new EntryLevelParams{
-      newOptimizer(), newHittingTimeKernel(), b_star, r, c
-  };
+  EntryLevelView params{getOptimizer(), getHittingTimeKernel(), b_star, r, c};
   ModelFunc fn = funcOptimalMeanReversionD;
   double value{0.0};
   try {
-    double lower = optimalEntryLowerBound();
-    double upper = b_star;
-    value = brentSolver(fn, params, lower, upper);
+    const RootBracket bracket = optimalEntryBracket(b_star, r, c);
+    double lower = bracket.lower;
+    double upper = bracket.upper;
+    value = brentSolver(fn, &params, lower, upper);
   } catch (const std::exception& e) {
     std::cout << "Exception " << e.what()
               << " caught in OrnsteinUhlenbeckTradingLevels::optimalEntry "
                  "without stop loss."
               << std::endl;
-    delete static_cast<EntryLevelParams*>(params);
-    params = nullptr;
     throw;
   }
-  // Then cast the void pointer back to the original type and free the memory.
-  delete static_cast<EntryLevelParams*>(params);
-  params = nullptr;
   return value;
 }
+const TradingLevelsSolution OrnsteinUhlenbeckTradingLevels::solveTradingLevels(
+    const double& stop_loss, const double& r, const double& c
+) const {
+  try {
+    return solveOrnsteinUhlenbeckTradingLevelsStopLoss(
+        getOptimizer(),
+        getApproximation(),
+        getHittingTimeKernel(),
+        optimalExitUpperBound(),
+        stop_loss,
+        r,
+        c
+    );
+  } catch (const std::exception& e) {
+    std::cout << "Exception " << e.what()
+              << " caught in OrnsteinUhlenbeckTradingLevels::"
+                 "solveTradingLevels with stop loss."
+              << std::endl;
+    throw;
+  }
+}
+const TradingLevelsSolution OrnsteinUhlenbeckTradingLevels::solveTradingLevels(
+    const double& r, const double& c
+) const {
+  try {
+    return solveOrnsteinUhlenbeckTradingLevels(
+        getOptimizer(),
+        getApproximation(),
+        getHittingTimeKernel(),
+        optimalEntryLowerBound(),
+        optimalExitUpperBound(),
+        r,
+        c
+    );
+  } catch (const std::exception& e) {
+    std::cout << "Exception " << e.what()
+              << " caught in OrnsteinUhlenbeckTradingLevels::"
+                 "solveTradingLevels without stop loss."
+              << std::endl;
+    throw;
+  }
+}
+const TradingLevelsSolution solveOrnsteinUhlenbeckTradingLevelsStopLoss(
+    const OptimalMeanReversion* optimizer,
+    const OptimalMeanReversion* approximation,
+    const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
+    const double upper_bound,
+    const double stop_loss,
+    const double r,
+    const double c
+) {
+  const HittingTimeOrnsteinUhlenbeck* kernel = hitting_time_kernel;
+  const double deviation = 1.0 / kernel->optimalTradingScale();
+  // The root functions capture the optimizer and kernel by reference, so no
+  // copies are made for GSL.
+  auto b = [&](const double x) {
+    return optimizer->b(x, kernel, stop_loss, r, c);
+  };
+  auto approximate_b = [&](const double x) {
+    return approximation->b(x, kernel, stop_loss, r, c);
+  };
+
+  TradingLevelsSolution solution{0.0, 0.0, 0.0};
+  RootBracket bracket = approximateBracket(
+      approximate_b,
+      b,
+      deviation,
+      std::max(optimizer->L_star(kernel, r, c), c),
+      upper_bound
+  );
+  solution.b_star = brentSolver(
+      callableModelFunc<decltype(b)>,
+      callablePointer(b),
+      bracket.lower,
+      bracket.upper
+  );
+
+  // F and G at b* and the stop loss enter d and a only through the value
+  // function coefficients, which are now fixed.
+  const ValueFunctionCoefficients coefficients =
+      optimizer->valueFunction(kernel, solution.b_star, stop_loss, r, c);
+  const ValueFunctionCoefficients approximate_coefficients =
+      approximation->valueFunction(kernel, solution.b_star, stop_loss, r, c);
+  auto d = [&](const double x) {
+    return optimizer->d(
+        x, kernel, coefficients, solution.b_star, stop_loss, r, c
+    );
+  };
+  auto approximate_d = [&](const double x) {
+    return approximation->d(
+        x, kernel, approximate_coefficients, solution.b_star, stop_loss, r, c
+    );
+  };
+  bracket = approximateBracket(
+      approximate_d, d, deviation, stop_loss, solution.b_star
+  );
+  solution.d_star = brentSolver(
+      callableModelFunc<decltype(d)>,
+      callablePointer(d),
+      bracket.lower,
+      bracket.upper
+  );
+
+  auto a = [&](const double x) {
+    return optimizer->a(
+        x, kernel, coefficients, solution.b_star, stop_loss, r, c
+    );
+  };
+  auto approximate_a = [&](const double x) {
+    return approximation->a(
+        x, kernel, approximate_coefficients, solution.b_star, stop_loss, r, c
+    );
+  };
+  bracket = approximateBracket(
+      approximate_a, a, deviation, stop_loss, solution.d_star
+  );
+  solution.a_star = brentSolver(
+      callableModelFunc<decltype(a)>,
+      callablePointer(a),
+      bracket.lower,
+      bracket.upper
+  );
+  return solution;
+}
+const TradingLevelsSolution solveOrnsteinUhlenbeckTradingLevels(
+    const OptimalMeanReversion* optimizer,
+    const OptimalMeanReversion* approximation,
+    const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
+    const double lower_bound,
+    const double upper_bound,
+    const double r,
+    const double c
+) {
+  const HittingTimeOrnsteinUhlenbeck* kernel = hitting_time_kernel;
+  const double deviation = 1.0 / kernel->optimalTradingScale();
+  auto b = [&](const double x) { return optimizer->b(x, kernel, r, c); };
+  auto approximate_b = [&](const double x) {
+    return approximation->b(x, kernel, r, c);
+  };
+
+  TradingLevelsSolution solution{
+      0.0, 0.0, std::numeric_limits<double>::quiet_NaN()
+  };
+  RootBracket bracket = approximateBracket(
+      approximate_b,
+      b,
+      deviation,
+      std::max(optimizer->L_star(kernel, r, c), c),
+      upper_bound
+  );
+  solution.b_star = brentSolver(
+      callableModelFunc<decltype(b)>,
+      callablePointer(b),
+      bracket.lower,
+      bracket.upper
+  );
+
+  // F(b*) enters d only through the value function coefficient.
+  const ValueFunctionCoefficients coefficients =
+      optimizer->valueFunction(kernel, solution.b_star, r, c);
+  const ValueFunctionCoefficients approximate_coefficients =
+      approximation->valueFunction(kernel, solution.b_star, r, c);
+  const double no_stop_loss = -std::numeric_limits<double>::infinity();
+  auto d = [&](const double x) {
+    return optimizer->d(
+        x, kernel, coefficients, solution.b_star, no_stop_loss, r, c
+    );
+  };
+  auto approximate_d = [&](const double x) {
+    return approximation->d(
+        x, kernel, approximate_coefficients, solution.b_star, no_stop_loss, r, c
+    );
+  };
+  bracket = approximateBracket(
+      approximate_d, d, deviation, lower_bound, solution.b_star
+  );
+  solution.d_star = brentSolver(
+      callableModelFunc<decltype(d)>,
+      callablePointer(d),
+      bracket.lower,
+      bracket.upper
+  );
+  return solution;
+}
@@ -0,0 +1,109 @@
+#include "stochastic_models/trading/trading_levels_batch.h"
+
+#include "stochastic_models/exceptions/errors.h"
+#include "stochastic_models/numeric_utils/parallel.h"
+#include "stochastic_models/trading/trading_levels.h"
+
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+
+/**
+ * @brief Returns whether a parameter set can be passed to the solvers.
+ *
+ * @param mu The long term mean.
+ * @param alpha The mean reversion speed.
+ * @param sigma The volatility.
+ * @param r The discount rate.
+ * @param c The cost of trading.
+ * @return const bool Whether the parameters are finite and alpha and sigma
+ * positive.
+ */
+static const bool validTradingParameters(
+    const double mu,
+    const double alpha,
+    const double sigma,
+    const double r,
+    const double c
+) {
+  return std::isfinite(mu) && std::isfinite(alpha) && std::isfinite(sigma) &&
+         std::isfinite(r) && std::isfinite(c) && alpha > 0.0 && sigma > 0.0;
+}
+
+const TradingLevelsBatchResult
+solveTradingLevelsBatch(const TradingLevelsBatchParams& params) {
+  const std::size_t n = params.mu.size();
+  if (params.alpha.size() != n || params.sigma.size() != n ||
+      params.r.size() != n || params.c.size() != n ||
+      (!params.stop_loss.empty() && params.stop_loss.size() != n)) {
+    throw std::invalid_argument(
+        "Batch parameters must have one element per parameter set."
+    );
+  }
+  const bool has_stop_loss = !params.stop_loss.empty();
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  TradingLevelsBatchResult result{
+      std::vector<double>(n, nan),
+      std::vector<double>(n, nan),
+      std::vector<double>(n, nan),
+      std::vector<TradingLevelsStatus>(n, TradingLevelsStatus::Failed)
+  };
+
+  // Every set writes only its own elements, so the results need no locking.
+  parallelForStealing(n, [&](const std::size_t i) {
+    const double r = params.r[i];
+    const double c = params.c[i];
+    if (!validTradingParameters(
+            params.mu[i], params.alpha[i], params.sigma[i], r, c
+        ) ||
+        (has_stop_loss && !std::isfinite(params.stop_loss[i]))) {
+      result.status[i] = TradingLevelsStatus::InvalidArgument;
+      return;
+    }
+    try {
+      // Only the kernel and optimizers are built, as in the tracker: an
+      // OrnsteinUhlenbeckTradingLevels would also seed the noise of a model
+      // the solve never simulates. The non-logging solves leave failures to
+      // the status of the set.
+      const double mu = params.mu[i];
+      const double alpha = params.alpha[i];
+      const double sigma = params.sigma[i];
+      const HittingTimeOrnsteinUhlenbeck kernel(mu, alpha, sigma);
+      const OptimalMeanReversion optimizer;
+      const OptimalMeanReversion approximation(TransformQuadrature::Asymptotic);
+      // The bounds of lowerSolverBound and upperSolverBound for the model.
+      const double spread = 4 * std::sqrt(std::pow(sigma, 2) / (2 * alpha));
+      const TradingLevelsSolution solution =
+          has_stop_loss ? solveOrnsteinUhlenbeckTradingLevelsStopLoss(
+                              &optimizer,
+                              &approximation,
+                              &kernel,
+                              mu + spread,
+                              params.stop_loss[i],
+                              r,
+                              c
+                          )
+                        : solveOrnsteinUhlenbeckTradingLevels(
+                              &optimizer,
+                              &approximation,
+                              &kernel,
+                              mu - spread,
+                              mu + spread,
+                              r,
+                              c
+                          );
+      result.b_star[i] = solution.b_star;
+      result.d_star[i] = solution.d_star;
+      result.a_star[i] = solution.a_star;
+      result.status[i] = TradingLevelsStatus::Solved;
+    } catch (const NoSolutionError&) {
+      result.status[i] = TradingLevelsStatus::NoSolution;
+    } catch (const std::invalid_argument&) {
+      result.status[i] = TradingLevelsStatus::InvalidArgument;
+    } catch (const std::exception&) {
+      result.status[i] = TradingLevelsStatus::Failed;
+    }
+  });
+  return result;
+}
@@ -24,33 +24,33 @@ EntryLevelParams::~EntryLevelParams() {
   hitting_time_kernel = nullptr;
 }
 double funcOptimalMeanReversionA(double x, void* params) {
-  struct EntryLevelParams* p = static_cast<EntryLevelParams*>(params);
+  struct EntryLevelView* p = static_cast<EntryLevelView*>(params);
   return p->optimizer->a(x, p->hitting_time_kernel, p->b_star, p->r, p->c);
 }
 double funcOptimalMeanReversionStopLossA(double x, void* params) {
-  struct EntryLevelStopLossParams* p =
-      static_cast<EntryLevelStopLossParams*>(params);
+  struct EntryLevelStopLossView* p =
+      static_cast<EntryLevelStopLossView*>(params);
   return p->optimizer->a(
       x, p->hitting_time_kernel, p->b_star, p->stop_loss, p->r, p->c
   );
 }
 double funcOptimalMeanReversionStopLossD(double x, void* params) {
-  struct EntryLevelStopLossParams* p =
-      static_cast<EntryLevelStopLossParams*>(params);
+  struct EntryLevelStopLossView* p =
+      static_cast<EntryLevelStopLossView*>(params);
   return p->optimizer->d(
       x, p->hitting_time_kernel, p->b_star, p->stop_loss, p->r, p->c
   );
 }
 double funcOptimalMeanReversionStopLossB(double x, void* params) {
-  struct ExitLevelStopLossParams* p =
-      static_cast<ExitLevelStopLossParams*>(params);
+  struct ExitLevelStopLossView* p =
+      static_cast<ExitLevelStopLossView*>(params);
   return p->optimizer->b(x, p->hitting_time_kernel, p->stop_loss, p->r, p->c);
 }
 double funcOptimalMeanReversionD(double x, void* params) {
-  struct EntryLevelParams* p = static_cast<EntryLevelParams*>(params);
+  struct EntryLevelView* p = static_cast<EntryLevelView*>(params);
   return p->optimizer->d(x, p->hitting_time_kernel, p->b_star, p->r, p->c);
 }
 double funcOptimalMeanReversionB(double x, void* params) {
-  struct ExitLevelParams* p = static_cast<ExitLevelParams*>(params);
+  struct ExitLevelView* p = static_cast<ExitLevelView*>(params);
   return p->optimizer->b(x, p->hitting_time_kernel, p->r, p->c);
 }
@@ -0,0 +1,336 @@
+#include "stochastic_models/trading/trading_levels_tracker.h"
+
+#include "stochastic_models/exceptions/errors.h"
+#include "stochastic_models/numeric_utils/solvers.h"
+#include "stochastic_models/trading/trading_levels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+/**
+ * @brief Factor by which a warm-started bracket grows when it does not hold
+ * the root.
+ */
+static constexpr double bracket_growth = 8.0;
+
+/**
+ * @brief The second derivatives of the transforms F(x;r) and G(x;r) in x.
+ *
+ */
+struct TransformCurvatures {
+  // The second derivative of F(x;r) in x.
+  double F;
+  // The second derivative of G(x;r) in x.
+  double G;
+};
+
+/**
+ * @brief Returns the second derivatives of the transforms at x.
+ *
+ * Differentiating under the integral sign twice gives
+ * F''(x;r) = scale^2 F(x; r + 2 alpha), which is scale F'(x; r + alpha), and
+ * G''(x;r) = -scale G'(x; r + alpha), so one evaluation of the transforms at
+ * the derivative rate gives both.
+ *
+ * @param optimizer The optimizer evaluating the transforms.
+ * @param hitting_time_kernel The kernel of the transforms.
+ * @param x The point at which to differentiate.
+ * @param r The discount rate.
+ * @return const TransformCurvatures F''(x;r) and G''(x;r).
+ */
+static const TransformCurvatures transformCurvatures(
+    const OptimalMeanReversion& optimizer,
+    const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
+    const double x,
+    const double r
+) {
+  const double scale = hitting_time_kernel->optimalTradingScale();
+  const OptimalTradingTransforms shifted = optimizer.transforms(
+      hitting_time_kernel,
+      x,
+      hitting_time_kernel->optimalTradingDerivativeRate(r)
+  );
+  return TransformCurvatures{scale * shifted.F_prime, -scale * shifted.G_prime};
+}
+
+/**
+ * @brief Finds a root of fn in brackets growing around a guess, clipped to
+ * the solver bounds.
+ *
+ * When newton is set the guess is first corrected by a Newton step, which
+ * leaves an error quadratic in the change of the parameters, so that the first
+ * bracket is narrow enough for Brent's method to meet its tolerance in an
+ * iteration or two. Each bracket that does not hold a root costs the two
+ * evaluations at its ends.
+ *
+ * @param fn Callable taking x and returning the root function at x.
+ * @param derivative Callable taking x and returning the derivative of the
+ * root function at x.
+ * @param newton Whether to correct the guess by a Newton step.
+ * @param guess The previous root mapped to the new parameters.
+ * @param initial_half_width The half width of the first bracket.
+ * @param half_width The largest half width of a bracket.
+ * @param lower The lower solver bound.
+ * @param upper The upper solver bound.
+ * @param root Set to the root if one is found.
+ * @return const bool Whether a bracket held a root and the solver converged
+ * to it.
+ */
+template <typename Fn, typename Derivative>
+static const bool warmStartedRoot(
+    Fn& fn,
+    Derivative& derivative,
+    const bool newton,
+    double guess,
+    const double initial_half_width,
+    const double half_width,
+    const double lower,
+    const double upper,
+    double& root
+) {
+  if (newton) {
+    // A step leaving the largest bracket is not trusted.
+    const double step = fn(guess) / derivative(guess);
+    if (std::abs(step) < half_width) {
+      guess -= step;
+    }
+  }
+  for (double width = std::min(initial_half_width, half_width);;
+       width = std::min(bracket_growth * width, half_width)) {
+    const double bracket_lower = std::max(guess - width, lower);
+    const double bracket_upper = std::min(guess + width, upper);
+    if (bracket_lower < bracket_upper) {
+      try {
+        const SolverResult result = solve(fn, bracket_lower, bracket_upper);
+        root = result.root;
+        return result.converged;
+      } catch (const NoSolutionError&) {
+      }
+    }
+    if (width >= half_width) {
+      return false;
+    }
+  }
+}
+
+OrnsteinUhlenbeckTradingLevelsTracker::OrnsteinUhlenbeckTradingLevelsTracker(
+    const double stop_loss, const double r, const double c
+)
+    : stop_loss(stop_loss), has_stop_loss(true), r(r), c(c) {}
+OrnsteinUhlenbeckTradingLevelsTracker::OrnsteinUhlenbeckTradingLevelsTracker(
+    const double r, const double c
+)
+    : stop_loss(-std::numeric_limits<double>::infinity()),
+      has_stop_loss(false),
+      r(r),
+      c(c) {}
+const TradingLevelsSolution OrnsteinUhlenbeckTradingLevelsTracker::update(
+    const double mu, const double alpha, const double sigma
+) {
+  if (!(alpha > 0.0) || !(sigma > 0.0)) {
+    throw std::invalid_argument(
+        "Tracked mean reversion speed and volatility must be positive."
+    );
+  }
+  const double deviation = std::sqrt(sigma * sigma / (2 * alpha));
+
+  if (solved && warmStart(mu, alpha, sigma, deviation)) {
+    ++warm_count;
+    return levels;
+  }
+
+  const OrnsteinUhlenbeckTradingLevels trading_levels(mu, alpha, sigma);
+  levels = has_stop_loss ? trading_levels.solveTradingLevels(stop_loss, r, c)
+                         : trading_levels.solveTradingLevels(r, c);
+  solved = true;
+  store(mu, alpha, deviation);
+  ++full_count;
+  return levels;
+}
+const bool OrnsteinUhlenbeckTradingLevelsTracker::warmStart(
+    const double mu,
+    const double alpha,
+    const double sigma,
+    const double deviation
+) {
+  // Only the kernel is built for the new parameters. Constructing an
+  // OrnsteinUhlenbeckTradingLevels would also seed the noise of its model,
+  // which costs more than the warm-started roots.
+  const HittingTimeOrnsteinUhlenbeck hitting_time_kernel(mu, alpha, sigma);
+  const HittingTimeOrnsteinUhlenbeck* kernel = &hitting_time_kernel;
+  const double infinity = std::numeric_limits<double>::infinity();
+  const double initial_half_width = initial_bracket_width * deviation;
+  const double half_width = bracket_width * deviation;
+  TradingLevelsSolution warm{
+      0.0, 0.0, std::numeric_limits<double>::quiet_NaN()
+  };
+  // The second derivatives are transforms at the exponent r / alpha + 1,
+  // whose quadrature rule is kept alongside that of r / alpha only while
+  // alpha is unchanged. A new alpha would build both rules on every update,
+  // which costs more than the iterations the Newton step saves.
+  const bool newton = alpha == levels_alpha;
+
+  // Any failure of the quadratures or solvers falls back to the full solve.
+  try {
+    // The brackets are clipped to where the levels are defined rather than to
+    // the solver bounds, which only limit the search of a full solve.
+    auto b = [&](const double x) {
+      return has_stop_loss ? optimizer.b(x, kernel, stop_loss, r, c)
+                           : optimizer.b(x, kernel, r, c);
+    };
+    // The first derivatives of F and G cancel in the derivative of b.
+    auto b_prime = [&](const double x) {
+      const TransformCurvatures curvatures =
+          transformCurvatures(optimizer, kernel, x, r);
+      if (!has_stop_loss) {
+        return -(x - c) * curvatures.F;
+      }
+      const OptimalTradingTransforms at_x = optimizer.transforms(kernel, x, r);
+      const OptimalTradingTransforms at_l =
+          optimizer.transforms(kernel, stop_loss, r);
+      return ((stop_loss - c) * at_x.G - (x - c) * at_l.G) * curvatures.F +
+             ((x - c) * at_l.F - (stop_loss - c) * at_x.F) * curvatures.G;
+    };
+    if (!warmStartedRoot(
+            b,
+            b_prime,
+            newton,
+            mu + standardized.b_star * deviation,
+            initial_half_width,
+            half_width,
+            std::max(optimizer.L_star(kernel, r, c), c),
+            infinity,
+            warm.b_star
+        )) {
+      return false;
+    }
+
+    const ValueFunctionCoefficients coefficients =
+        has_stop_loss
+            ? optimizer.valueFunction(kernel, warm.b_star, stop_loss, r, c)
+            : optimizer.valueFunction(kernel, warm.b_star, r, c);
+    // The transforms and their second derivatives at x, with the value
+    // function less the exit payoff x + c and its second derivative, which is
+    // zero outside the continuation region. d = G (V' - 1) - G' (V - x - c)
+    // and a = F (V' - 1) - F' (V - x - c), so their derivatives only need
+    // these as the first derivatives cancel.
+    auto expand = [&](const double x,
+                      OptimalTradingTransforms& at_x,
+                      TransformCurvatures& curvatures,
+                      double& excess,
+                      double& v_second) {
+      at_x = optimizer.transforms(kernel, x, r);
+      curvatures = transformCurvatures(optimizer, kernel, x, r);
+      excess = -2.0 * c;
+      v_second = 0.0;
+      if ((warm.b_star >= x) && (x >= stop_loss)) {
+        excess = coefficients.C * at_x.F + coefficients.D * at_x.G - x - c;
+        v_second =
+            coefficients.C * curvatures.F + coefficients.D * curvatures.G;
+      }
+    };
+    auto d = [&](const double x) {
+      return optimizer.d(x, kernel, coefficients, warm.b_star, stop_loss, r, c);
+    };
+    auto d_prime = [&](const double x) {
+      OptimalTradingTransforms at_x;
+      TransformCurvatures curvatures;
+      double excess;
+      double v_second;
+      expand(x, at_x, curvatures, excess, v_second);
+      return at_x.G * v_second - curvatures.G * excess;
+    };
+    if (!warmStartedRoot(
+            d,
+            d_prime,
+            newton,
+            mu + standardized.d_star * deviation,
+            initial_half_width,
+            half_width,
+            stop_loss,
+            warm.b_star,
+            warm.d_star
+        )) {
+      return false;
+    }
+
+    if (has_stop_loss) {
+      auto a = [&](const double x) {
+        return optimizer.a(
+            x, kernel, coefficients, warm.b_star, stop_loss, r, c
+        );
+      };
+      auto a_prime = [&](const double x) {
+        OptimalTradingTransforms at_x;
+        TransformCurvatures curvatures;
+        double excess;
+        double v_second;
+        expand(x, at_x, curvatures, excess, v_second);
+        return at_x.F * v_second - curvatures.F * excess;
+      };
+      if (!warmStartedRoot(
+              a,
+              a_prime,
+              newton,
+              mu + standardized.a_star * deviation,
+              initial_half_width,
+              half_width,
+              stop_loss,
+              warm.d_star,
+              warm.a_star
+          )) {
+        return false;
+      }
+    }
+  } catch (const std::runtime_error&) {
+    return false;
+  } catch (const std::invalid_argument&) {
+    return false;
+  }
+
+  levels = warm;
+  store(mu, alpha, deviation);
+  return true;
+}
+const TradingLevelsSolution OrnsteinUhlenbeckTradingLevelsTracker::update(
+    const OrnsteinUhlenbeckParameters& parameters
+) {
+  return update(parameters.mu, parameters.alpha, parameters.sigma);
+}
+void OrnsteinUhlenbeckTradingLevelsTracker::reset() {
+  solved = false;
+}
+void OrnsteinUhlenbeckTradingLevelsTracker::setBracketWidth(
+    const double width
+) {
+  if (!(width > 0.0)) {
+    throw std::invalid_argument("Bracket width must be positive.");
+  }
+  bracket_width = width;
+}
+const double OrnsteinUhlenbeckTradingLevelsTracker::getBracketWidth() const {
+  return bracket_width;
+}
+const bool OrnsteinUhlenbeckTradingLevelsTracker::hasLevels() const {
+  return solved;
+}
+const TradingLevelsSolution
+OrnsteinUhlenbeckTradingLevelsTracker::getLevels() const {
+  return levels;
+}
+const std::size_t OrnsteinUhlenbeckTradingLevelsTracker::warmStarts() const {
+  return warm_count;
+}
+const std::size_t OrnsteinUhlenbeckTradingLevelsTracker::fullSolves() const {
+  return full_count;
+}
+void OrnsteinUhlenbeckTradingLevelsTracker::store(
+    const double mu, const double alpha, const double deviation
+) {
+  levels_alpha = alpha;
+  standardized.b_star = (levels.b_star - mu) / deviation;
+  standardized.d_star = (levels.d_star - mu) / deviation;
+  standardized.a_star = (levels.a_star - mu) / deviation;
+}
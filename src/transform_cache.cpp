@@ -0,0 +1,99 @@
+#include "stochastic_models/trading/transform_cache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+TransformCache::TransformCache(const std::size_t capacity, const double quantum)
+    : capacity(capacity), quantum(quantum) {
+  if (!(quantum >= 0.0)) {
+    throw std::invalid_argument("Cache quantum must be non-negative.");
+  }
+  entries.reserve(capacity);
+}
+const OptimalTradingTransforms extrapolateTransforms(
+    const OptimalTradingTransforms& transforms, const double dx
+) {
+  return OptimalTradingTransforms{
+      transforms.F + transforms.F_prime * dx,
+      transforms.F_prime,
+      transforms.G + transforms.G_prime * dx,
+      transforms.G_prime
+  };
+}
+const double TransformCache::quantizedDrift(const double drift) const {
+  if (quantum == 0.0) {
+    return drift;
+  }
+  return std::round(drift / quantum) * quantum;
+}
+const bool TransformCache::find(
+    const TransformCacheKey& key, OptimalTradingTransforms& transforms
+) {
+  const double drift = quantizedDrift(key.drift);
+  std::lock_guard<std::mutex> lock(mutex);
+  for (Entry& entry : entries) {
+    if (entry.key.drift == drift && entry.key.exponent == key.exponent &&
+        entry.key.scale == key.scale &&
+        entry.key.quadrature == key.quadrature) {
+      entry.last_used = ++clock;
+      transforms = entry.transforms;
+      if (drift != key.drift) {
+        transforms =
+            extrapolateTransforms(transforms, (key.drift - drift) / key.scale);
+      }
+      ++hit_count;
+      return true;
+    }
+  }
+  ++miss_count;
+  return false;
+}
+void TransformCache::insert(
+    const TransformCacheKey& key, const OptimalTradingTransforms& transforms
+) {
+  if (capacity == 0) {
+    return;
+  }
+  TransformCacheKey stored = key;
+  stored.drift = quantizedDrift(key.drift);
+  const Entry entry{stored, transforms, 0};
+  std::lock_guard<std::mutex> lock(mutex);
+  if (entries.size() < capacity) {
+    entries.push_back(entry);
+    entries.back().last_used = ++clock;
+    return;
+  }
+  Entry& oldest = *std::min_element(
+      entries.begin(),
+      entries.end(),
+      [](const Entry& a, const Entry& b) { return a.last_used < b.last_used; }
+  );
+  oldest = entry;
+  oldest.last_used = ++clock;
+}
+void TransformCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex);
+  entries.clear();
+  clock = 0;
+  hit_count = 0;
+  miss_count = 0;
+}
+const std::size_t TransformCache::hits() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return hit_count;
+}
+const std::size_t TransformCache::misses() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return miss_count;
+}
+const std::size_t TransformCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return entries.size();
+}
+const std::size_t TransformCache::getCapacity() const {
+  return capacity;
+}
+const double TransformCache::getQuantum() const {
+  return quantum;
+}
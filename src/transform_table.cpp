@@ -0,0 +1,241 @@
+#include "stochastic_models/trading/transform_table.h"
+#include "stochastic_models/trading/optimal_mean_reversion.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+/**
+ * @brief Returns the Chebyshev coefficients of the polynomial interpolating
+ * values at the Chebyshev-Lobatto points cos(pi j / n), j = 0, ..., n.
+ *
+ * @param values The n + 1 values at the Chebyshev-Lobatto points.
+ * @return const std::vector<double> The n + 1 coefficients.
+ */
+static const std::vector<double>
+chebyshevCoefficients(const std::vector<double>& values) {
+  const std::size_t n = values.size() - 1;
+  std::vector<double> coefficients(n + 1, 0.0);
+  for (std::size_t k{0}; k <= n; ++k) {
+    double sum{0.0};
+    for (std::size_t j{0}; j <= n; ++j) {
+      const double term =
+          values[j] * std::cos(std::numbers::pi * static_cast<double>(j * k) /
+                               static_cast<double>(n));
+      sum += (j == 0 || j == n) ? 0.5 * term : term;
+    }
+    coefficients[k] = 2.0 * sum / static_cast<double>(n);
+  }
+  coefficients[0] *= 0.5;
+  coefficients[n] *= 0.5;
+  return coefficients;
+}
+
+/**
+ * @brief Evaluates a Chebyshev series with Clenshaw's recurrence.
+ *
+ * @param coefficients The coefficients of the series.
+ * @param t The point in [-1, 1].
+ * @return const double The value of the series at t.
+ */
+static const double
+chebyshevEvaluate(const std::vector<double>& coefficients, const double t) {
+  double b1{0.0}, b2{0.0};
+  for (std::size_t k = coefficients.size() - 1; k >= 1; --k) {
+    const double b0 = 2.0 * t * b1 - b2 + coefficients[k];
+    b2 = b1;
+    b1 = b0;
+  }
+  return t * b1 - b2 + coefficients[0];
+}
+
+/**
+ * @brief Returns the position in [-1, 1] of a drift within a panel, with
+ * t = 1 at the lower end to match the ordering of the Chebyshev-Lobatto
+ * points.
+ *
+ * @param panel The panel.
+ * @param drift The drift.
+ * @return const double The position t.
+ */
+static const double
+panelPosition(const TransformTablePanel& panel, const double drift) {
+  return 1.0 - 2.0 * (drift - panel.drift_lower) /
+                   (panel.drift_upper - panel.drift_lower);
+}
+
+/**
+ * @brief Interpolates the transforms within a panel.
+ *
+ * @param panel The panel.
+ * @param scale The scale sqrt(2 alpha / sigma^2) of the kernel.
+ * @param drift The drift.
+ * @return const OptimalTradingTransforms F, F', G and G'.
+ */
+static const OptimalTradingTransforms panelTransforms(
+    const TransformTablePanel& panel, const double scale, const double drift
+) {
+  const double t = panelPosition(panel, drift);
+  // Derivatives in x are scale times derivatives in the drift.
+  const double f = std::exp(chebyshevEvaluate(panel.log_f, t));
+  const double g = std::exp(chebyshevEvaluate(panel.log_g, t));
+  return OptimalTradingTransforms{
+      f,
+      scale * f * chebyshevEvaluate(panel.log_f_prime, t),
+      g,
+      scale * g * chebyshevEvaluate(panel.log_g_prime, t)
+  };
+}
+
+TransformTable::TransformTable(
+    const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
+    const double r,
+    const double lower,
+    const double upper,
+    const double tolerance
+)
+    : exponent(hitting_time_kernel->optimalTradingExponent(r)),
+      tolerance(tolerance) {
+  if (!(lower < upper) || !(tolerance > 0.0)) {
+    throw std::invalid_argument(
+        "Table range must be non-empty and tolerance positive."
+    );
+  }
+  // The table is built from the quadrature without the memo cache, which
+  // would only hold a few of the nodes.
+  OptimalMeanReversion optimizer(TransformQuadrature::FixedOrder);
+  optimizer.setTransformCache(nullptr);
+  fitPanel(optimizer, hitting_time_kernel, r, lower, upper, 0);
+}
+TransformTable::TransformTable(
+    const double exponent,
+    const double tolerance,
+    std::vector<TransformTablePanel> panels
+)
+    : exponent(exponent), tolerance(tolerance), panels(std::move(panels)) {
+  if (!(exponent > 0.0) || !std::isfinite(exponent) || !(tolerance > 0.0) ||
+      !std::isfinite(tolerance)) {
+    throw std::invalid_argument(
+        "Table exponent and tolerance must be finite and positive."
+    );
+  }
+  if (this->panels.empty()) {
+    throw std::invalid_argument("Table must have at least one panel.");
+  }
+  for (std::size_t i{0}; i < this->panels.size(); ++i) {
+    const TransformTablePanel& panel = this->panels[i];
+    const std::size_t size = panel.log_f.size();
+    if (!(panel.drift_lower < panel.drift_upper) ||
+        (i > 0 && panel.drift_lower != this->panels[i - 1].drift_upper) ||
+        size == 0 || panel.log_f_prime.size() != size ||
+        panel.log_g.size() != size || panel.log_g_prime.size() != size) {
+      throw std::invalid_argument(
+          "Table panels must be contiguous with coefficients of equal length."
+      );
+    }
+  }
+}
+void TransformTable::fitPanel(
+    const OptimalMeanReversion& optimizer,
+    const HittingTimeOrnsteinUhlenbeck* hitting_time_kernel,
+    const double r,
+    const double lower,
+    const double upper,
+    const std::size_t depth
+) {
+  const double scale = hitting_time_kernel->optimalTradingScale();
+  TransformTablePanel panel{
+      hitting_time_kernel->optimalTradingDrift(lower),
+      hitting_time_kernel->optimalTradingDrift(upper),
+      {},
+      {},
+      {},
+      {}
+  };
+
+  // Transforms at the Chebyshev-Lobatto points of 2 n intervals. The even
+  // points fit the panel and the odd ones check it.
+  const std::size_t n = panel_degree;
+  std::vector<OptimalTradingTransforms> exact(2 * n + 1);
+  for (std::size_t j{0}; j <= 2 * n; ++j) {
+    const double t =
+        std::cos(std::numbers::pi * static_cast<double>(j) / (2.0 * n));
+    const double x = lower + (upper - lower) * 0.5 * (1.0 - t);
+    exact[j] = optimizer.transforms(hitting_time_kernel, x, r);
+  }
+
+  // The logarithmic derivatives in the drift are interpolated from the
+  // quadrature rather than by differentiating the series, which would
+  // amplify its rounding by the square of the degree.
+  std::vector<double> f_values(n + 1), g_values(n + 1);
+  std::vector<double> f_prime_values(n + 1), g_prime_values(n + 1);
+  for (std::size_t j{0}; j <= n; ++j) {
+    const OptimalTradingTransforms& point = exact[2 * j];
+    f_values[j] = std::log(point.F);
+    g_values[j] = std::log(point.G);
+    f_prime_values[j] = point.F_prime / (scale * point.F);
+    g_prime_values[j] = point.G_prime / (scale * point.G);
+  }
+  panel.log_f = chebyshevCoefficients(f_values);
+  panel.log_f_prime = chebyshevCoefficients(f_prime_values);
+  panel.log_g = chebyshevCoefficients(g_values);
+  panel.log_g_prime = chebyshevCoefficients(g_prime_values);
+
+  double error{0.0};
+  for (std::size_t j{1}; j < 2 * n; j += 2) {
+    const double t =
+        std::cos(std::numbers::pi * static_cast<double>(j) / (2.0 * n));
+    const double drift =
+        panel.drift_lower +
+        (panel.drift_upper - panel.drift_lower) * 0.5 * (1.0 - t);
+    const OptimalTradingTransforms table = panelTransforms(panel, scale, drift);
+    error = std::max(
+        {error,
+         std::abs(table.F / exact[j].F - 1.0),
+         std::abs(table.F_prime / exact[j].F_prime - 1.0),
+         std::abs(table.G / exact[j].G - 1.0),
+         std::abs(table.G_prime / exact[j].G_prime - 1.0)}
+    );
+  }
+  if (error <= tolerance) {
+    panels.push_back(std::move(panel));
+    return;
+  }
+  if (depth == max_depth) {
+    throw std::invalid_argument(
+        "Transform table did not reach the tolerance within the maximum "
+        "depth."
+    );
+  }
+  const double middle = 0.5 * (lower + upper);
+  fitPanel(optimizer, hitting_time_kernel, r, lower, middle, depth + 1);
+  fitPanel(optimizer, hitting_time_kernel, r, middle, upper, depth + 1);
+}
+const bool
+TransformTable::covers(const double exponent, const double drift) const {
+  return exponent == this->exponent && drift >= panels.front().drift_lower &&
+         drift <= panels.back().drift_upper;
+}
+const OptimalTradingTransforms
+TransformTable::transforms(const double scale, const double drift) const {
+  // The first panel whose upper end is not below the drift contains it.
+  const auto panel = std::lower_bound(
+      panels.begin(),
+      panels.end() - 1,
+      drift,
+      [](const TransformTablePanel& panel, const double drift) {
+        return panel.drift_upper < drift;
+      }
+  );
+  return panelTransforms(*panel, scale, drift);
+}
+const double TransformTable::getExponent() const {
+  return exponent;
+}
+const double TransformTable::getTolerance() const {
+  return tolerance;
+}
+const std::vector<TransformTablePanel>& TransformTable::getPanels() const {
+  return panels;
+}
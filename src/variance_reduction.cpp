@@ -0,0 +1,53 @@
+#include "stochastic_models/sde/variance_reduction.h"
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+const ControlVariateEstimate controlVariateEstimate(
+    std::span<const double> samples,
+    std::span<const double> controls,
+    const double control_mean
+) {
+  if (samples.size() != controls.size()) {
+    throw std::invalid_argument(
+        "Samples and controls must have the same size."
+    );
+  }
+  if (samples.size() < 2) {
+    throw std::invalid_argument("At least two samples are required.");
+  }
+  const double n = static_cast<double>(samples.size());
+  double sample_mean{0.0};
+  double control_sample_mean{0.0};
+  for (std::size_t i{0}; i < samples.size(); ++i) {
+    sample_mean += samples[i];
+    control_sample_mean += controls[i];
+  }
+  sample_mean /= n;
+  control_sample_mean /= n;
+
+  double covariance{0.0};
+  double control_variance{0.0};
+  for (std::size_t i{0}; i < samples.size(); ++i) {
+    const double control_deviation = controls[i] - control_sample_mean;
+    covariance += (samples[i] - sample_mean) * control_deviation;
+    control_variance += control_deviation * control_deviation;
+  }
+  const double beta =
+      control_variance > 0.0 ? covariance / control_variance : 0.0;
+
+  double residual_variance{0.0};
+  for (std::size_t i{0}; i < samples.size(); ++i) {
+    const double residual = (samples[i] - sample_mean) -
+                            beta * (controls[i] - control_sample_mean);
+    residual_variance += residual * residual;
+  }
+  // One degree of freedom each for the mean and the fitted coefficient.
+  residual_variance /= n > 2.0 ? n - 2.0 : 1.0;
+
+  return {
+      sample_mean - beta * (control_sample_mean - control_mean),
+      std::sqrt(residual_variance / n), beta
+  };
+}
@@ -0,0 +1,129 @@
+#include "counting_allocator.h"
+#include "stochastic_models/sde/general_linear.h"
+#include "stochastic_models/sde/ornstein_uhlenbeck.h"
+#include "stochastic_models/trading/trading_levels.h"
+#include "stochastic_models/trading/trading_levels_params.h"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+/**
+ * @test Tests that constructing and copying the SDE models performs no heap
+ * allocation.
+ *
+ */
+TEST(AllocationTest, ModelConstructionTest) {
+  const std::size_t before = allocations.load();
+  {
+    const OrnsteinUhlenbeckModel model(0.5, 2.0, 0.3);
+    const OrnsteinUhlenbeckModel copy(model);
+    const GeneralLinearModel linear(0.1, 0.2);
+    const GeneralLinearModel linear_copy(linear);
+    const double value = copy.coreEquation(1.0, 0.5, 0.1) +
+                         linear_copy.coreEquation(1.0, 0.5, 0.1) +
+                         model.getMean() + linear.getMean();
+    EXPECT_TRUE(std::isfinite(value));
+  }
+  EXPECT_EQ(allocations.load() - before, 0U)
+      << "Constructing or copying a model allocated memory.";
+}
+/**
+ * @test Tests that simulating into a caller-provided buffer performs no heap
+ * allocation when the paths fit in a single block.
+ *
+ */
+TEST(AllocationTest, SimulatePathsIntoBufferTest) {
+  const OrnsteinUhlenbeckModel model(0.5, 2.0, 0.3);
+  std::array<double, 64 * 16> paths;
+  const std::size_t before = allocations.load();
+  model.SimulatePaths(paths, 1.0, 64, 16, 0.1, 3);
+  EXPECT_EQ(allocations.load() - before, 0U)
+      << "Simulating into a caller-provided buffer allocated memory.";
+}
+/**
+ * @test Tests that copies and clones of a model draw independent noise and
+ * that seeding makes Simulate reproducible.
+ *
+ */
+TEST(AllocationTest, CopiedStreamTest) {
+  OrnsteinUhlenbeckModel model(0.5, 2.0, 0.3);
+  model.seed(21);
+  const OrnsteinUhlenbeckModel copy(model);
+  const OrnsteinUhlenbeckModel second_copy(model);
+  const std::unique_ptr<const OrnsteinUhlenbeckModel> clone(model.clone());
+
+  const std::vector<double> original_path = model.Simulate(1.0, 8, 0.1);
+  const std::vector<double> copy_path = copy.Simulate(1.0, 8, 0.1);
+  EXPECT_NE(original_path, copy_path)
+      << "A copied model repeats the noise of the original.";
+  EXPECT_NE(copy_path, second_copy.Simulate(1.0, 8, 0.1))
+      << "Two copies of a model draw the same noise.";
+  EXPECT_NE(original_path, clone->Simulate(1.0, 8, 0.1))
+      << "A cloned model repeats the noise of the original.";
+
+  OrnsteinUhlenbeckModel reseeded(model);
+  model.seed(21);
+  reseeded.seed(21);
+  EXPECT_EQ(model.Simulate(1.0, 8, 0.1), original_path)
+      << "Seeding does not reproduce the stream of a model.";
+  EXPECT_EQ(reseeded.Simulate(1.0, 8, 0.1), original_path)
+      << "Seeding a copy does not reproduce the stream it was given.";
+}
+/**
+ * @test Tests that once the thread's solvers and the transform cache are in
+ * place, solving the trading levels performs no heap allocation.
+ *
+ */
+TEST(AllocationTest, TradingLevelsSolveTest) {
+  const OrnsteinUhlenbeckTradingLevels levels(0.3, 8.0, 0.3);
+  const double stop_loss = 0.05;
+  const double r = 0.05;
+  const double c = 0.02;
+  levels.solveTradingLevels(stop_loss, r, c);
+
+  const std::size_t before = allocations.load();
+  const double b_star = levels.optimalExit(stop_loss, r, c);
+  const double d_star = levels.optimalEntry(b_star, stop_loss, r, c);
+  const double a_star =
+      levels.optimalEntryLower(d_star, b_star, stop_loss, r, c);
+  const TradingLevelsSolution solution =
+      levels.solveTradingLevels(stop_loss, r, c);
+  EXPECT_TRUE(std::isfinite(a_star + solution.a_star));
+  EXPECT_EQ(allocations.load() - before, 0U)
+      << "Solving the trading levels allocated memory.";
+}
+/**
+ * @test Tests that the trading levels params free the clones they own, while
+ * the views used by the solvers borrow without allocating.
+ *
+ */
+TEST(AllocationTest, TradingLevelsParamsOwnershipTest) {
+  const OrnsteinUhlenbeckTradingLevels levels(0.3, 8.0, 0.3);
+  const double b_star = 0.4;
+  const double r = 0.05;
+  const double c = 0.02;
+
+  const std::size_t before = allocations.load();
+  const std::size_t freed_before = deallocations.load();
+  {
+    const EntryLevelParams params{
+        levels.getOptimizer()->clone(),
+        levels.getHittingTimeKernel()->clone(),
+        b_star,
+        r,
+        c
+    };
+    const EntryLevelView view{
+        levels.getOptimizer(), levels.getHittingTimeKernel(), b_star, r, c
+    };
+    EXPECT_EQ(params.b_star, view.b_star);
+  }
+  const std::size_t allocated = allocations.load() - before;
+  EXPECT_GE(allocated, 2U) << "The params were not built from clones.";
+  EXPECT_EQ(deallocations.load() - freed_before, allocated)
+      << "The params did not free the clones they own.";
+}
@@ -0,0 +1,54 @@
+#ifndef STOCHASTIC_MODELS_TESTS_COUNTING_ALLOCATOR_H
+#define STOCHASTIC_MODELS_TESTS_COUNTING_ALLOCATOR_H
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+/**
+ * @file
+ * @brief Replaces the global operator new and operator delete with versions
+ * that count the calls made by the executable.
+ *
+ * The replacements are definitions, so include this header from exactly one
+ * translation unit of each executable.
+ */
+
+/**
+ * @brief Number of calls to the global operator new made by this executable.
+ *
+ */
+static std::atomic<std::size_t> allocations{0};
+/**
+ * @brief Number of non-null pointers freed by the global operator delete.
+ *
+ */
+static std::atomic<std::size_t> deallocations{0};
+
+void* operator new(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+  return operator new(size);
+}
+void operator delete(void* pointer) noexcept {
+  if (pointer != nullptr) {
+    deallocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  std::free(pointer);
+}
+void operator delete[](void* pointer) noexcept {
+  operator delete(pointer);
+}
+void operator delete(void* pointer, std::size_t) noexcept {
+  operator delete(pointer);
+}
+void operator delete[](void* pointer, std::size_t) noexcept {
+  operator delete(pointer);
+}
+
+#endif
@@ -2,6 +2,7 @@
 #include "stochastic_models/trading/exponential_mean_reversion.h"
 #include "stochastic_models/trading/optimal_mean_reversion.h"
 
+#include <cmath>
 #include <cstdlib>
 #include <gtest/gtest.h>
 #include <stdexcept>
@@ -154,3 +155,46 @@ TEST(
        "not meant to be implemented.";
   delete hitting_time_kernel;
 }
+/**
+ * @test Tests that ExponentialMeanReversion::d differentiates G and V at the
+ * discount rate r by comparing it with central differences, and that it
+ * vanishes at the entry level d* of the exponential model.
+ *
+ */
+TEST(ExponentialMeanReversionTest, dDiscountRateTest) {
+  // Declare and initialize model and test parameters.
+  const double x = 1.2;
+  const double alpha = 5;
+  const double mu = 1.3499;
+  const double sigma = 0.15;
+  const double b_star = 1.4093;
+  const double d_star = 1.236887;
+  const double c = 0.02;
+  const double r = 0.05;
+  const double h = 1e-4;
+  const double tolerance = 1e-4;
+
+  const HittingTimeOrnsteinUhlenbeck hitting_time_kernel(mu, alpha, sigma);
+  ExponentialMeanReversion mean_reversion;
+  auto G = [&](const double y) {
+    return mean_reversion.G(&hitting_time_kernel, y, r, c);
+  };
+  auto V = [&](const double y) {
+    return mean_reversion.V(&hitting_time_kernel, y, b_star, r, c);
+  };
+  const double G_prime = (G(x + h) - G(x - h)) / (2 * h);
+  const double V_prime = (V(x + h) - V(x - h)) / (2 * h);
+  const double expected = G(x) * (V_prime - std::exp(x)) -
+                          G_prime * (V(x) - std::exp(x) - c);
+  const double actual =
+      mean_reversion.d(x, &hitting_time_kernel, b_star, r, c);
+
+  EXPECT_LE(std::abs(actual / expected - 1.0), tolerance)
+      << "ExponentialMeanReversion::d not differentiating at the discount "
+         "rate r.";
+  // d changes by about 3500 between x and d*.
+  EXPECT_LE(
+      std::abs(mean_reversion.d(d_star, &hitting_time_kernel, b_star, r, c)),
+      1e-1
+  ) << "ExponentialMeanReversion::d not vanishing at d*.";
+}
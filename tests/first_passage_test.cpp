@@ -0,0 +1,96 @@
+#include "stochastic_models/entrypoints/ou_model.h"
+#include "stochastic_models/hitting_times/first_passage_monte_carlo.h"
+#include "stochastic_models/sde/ornstein_uhlenbeck.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <gtest/gtest.h>
+/**
+ * @test Tests the estimate for Brownian motion (alpha = 0), where the hitting
+ * probability is linear in the start and the expected exit time is
+ * (x - lower) (upper - x) / sigma^2.
+ *
+ */
+TEST(FirstPassageMonteCarloTest, BrownianMotionTest) {
+  const OrnsteinUhlenbeckModel model(0.0, 0.0, 1.0);
+  const double x = 0.1;
+  const FirstPassageEstimate estimate =
+      estimateFirstPassage(model, x, 0.5, -0.5, 20000, 3);
+
+  EXPECT_EQ(estimate.unresolved, 0U) << "Paths were left unresolved.";
+  EXPECT_LE(abs(estimate.probability - 0.6), 4 * estimate.standard_error)
+      << "Hitting probability of Brownian motion is wrong.";
+  EXPECT_LE(abs(estimate.expected_time - 0.24), 0.01)
+      << "Expected exit time of Brownian motion is wrong.";
+}
+/**
+ * @test Tests the Monte Carlo probability against the quadrature of
+ * hittingTimeDensityOrnsteinUhlenbeck for a mean-reverting process.
+ *
+ */
+TEST(FirstPassageMonteCarloTest, QuadratureCrossCheckTest) {
+  const double mu = 0.0;
+  const double alpha = 2.0;
+  const double sigma = 1.0;
+  const double x = 0.2;
+  const double first = 0.6;
+  const double second = -0.3;
+  const OrnsteinUhlenbeckModel model(mu, alpha, sigma);
+  const FirstPassageEstimate estimate =
+      estimateFirstPassage(model, x, first, second, 20000, 17);
+  const double quadrature =
+      hittingTimeDensityOrnsteinUhlenbeck(x, mu, alpha, sigma, first, second);
+
+  EXPECT_LE(
+      abs(estimate.probability - quadrature),
+      4 * estimate.standard_error + 0.005
+  ) << "Monte Carlo probability disagrees with the quadrature.";
+}
+/**
+ * @test Tests that estimates are reproducible for a seed, that quantiles are
+ * ordered and that the levels may be given in either order.
+ *
+ */
+TEST(FirstPassageMonteCarloTest, QuantileTest) {
+  const OrnsteinUhlenbeckModel model(0.0, 1.0, 1.0);
+  const FirstPassageEstimate estimate =
+      estimateFirstPassage(model, 0.0, -0.4, 0.4, 4000, 9);
+  const FirstPassageEstimate repeat =
+      estimateFirstPassage(model, 0.0, -0.4, 0.4, 4000, 9);
+  const FirstPassageEstimate swapped =
+      estimateFirstPassage(model, 0.0, 0.4, -0.4, 4000, 9);
+
+  EXPECT_EQ(estimate.exit_times, repeat.exit_times)
+      << "Estimates differ for the same seed.";
+  EXPECT_LE(abs(estimate.probability + swapped.probability - 1.0), 1e-12)
+      << "Swapping the levels does not complement the probability.";
+  EXPECT_LE(estimate.quantile(0.0), estimate.quantile(0.25));
+  EXPECT_LE(estimate.quantile(0.25), estimate.quantile(0.5));
+  EXPECT_LE(estimate.quantile(0.5), estimate.quantile(1.0));
+  EXPECT_EQ(estimate.quantile(1.0), estimate.exit_times.back());
+  EXPECT_THROW(estimate.quantile(1.5), std::invalid_argument);
+}
+/**
+ * @test Tests that paths outliving the horizon are reported as unresolved and
+ * that invalid arguments are rejected.
+ *
+ */
+TEST(FirstPassageMonteCarloTest, UnresolvedTest) {
+  const OrnsteinUhlenbeckModel model(0.0, 1.0, 0.01);
+  FirstPassageOptions options;
+  options.horizon = 0.01;
+  const FirstPassageEstimate estimate =
+      estimateFirstPassage(model, 0.0, 1.0, -1.0, 100, 1, options);
+
+  EXPECT_EQ(estimate.unresolved, 100U) << "Paths were absorbed too early.";
+  EXPECT_EQ(estimate.probability, 0.0);
+  EXPECT_TRUE(std::isnan(estimate.expected_time));
+  EXPECT_THROW(estimate.quantile(0.5), std::invalid_argument);
+  EXPECT_THROW(
+      estimateFirstPassage(model, 2.0, 1.0, -1.0, 100, 1),
+      std::invalid_argument
+  );
+  EXPECT_THROW(
+      estimateFirstPassage(model, 0.0, 1.0, -1.0, 0, 1), std::invalid_argument
+  );
+}
@@ -3,6 +3,7 @@
 
 #include <cstdlib>
 #include <gtest/gtest.h>
+#include <vector>
 /**
  * @test Tests the output of the GaussianDistribution::getMean method and
  * asserts that it is equal to the mu value.
@@ -55,3 +56,50 @@ TEST(GaussianDistributionTest, cdfTest) {
       << "The value returned by GaussianDistribution.Cdf is not the "
          "expected value.";
 }
+/**
+ * @test Tests that GaussianDistribution::sample is reproducible for a seeded
+ * distribution and that consecutive calls continue the stream rather than
+ * repeating draws.
+ *
+ */
+TEST(GaussianDistributionTest, sampleSeedTest) {
+  const GaussianDistribution first(0.5, 2.0, 99);
+  const GaussianDistribution second(0.5, 2.0, 99);
+  const std::vector<double> first_draws = first.sample(10);
+  const std::vector<double> second_draws = second.sample(10);
+  const std::vector<double> next_draws = first.sample(10);
+
+  EXPECT_EQ(first_draws, second_draws)
+      << "GaussianDistribution.sample not reproducible for the same seed.";
+  EXPECT_NE(first_draws, next_draws)
+      << "GaussianDistribution.sample repeating draws on consecutive calls.";
+}
+/**
+ * @test Tests that GaussianDistribution::sample with an explicit engine draws
+ * from that stream.
+ *
+ */
+TEST(GaussianDistributionTest, sampleEngineTest) {
+  const GaussianDistribution model(0.5, 2.0, 99, 5);
+  PhiloxEngine engine(99, 5);
+  const std::vector<double> own_draws = model.sample(10);
+  const std::vector<double> engine_draws = model.sample(10, engine);
+
+  EXPECT_EQ(own_draws, engine_draws)
+      << "GaussianDistribution.sample not drawing from the provided engine.";
+}
+/**
+ * @test Tests that GaussianDistribution::fill writes the same draws as
+ * GaussianDistribution::sample for the same stream.
+ *
+ */
+TEST(GaussianDistributionTest, fillTest) {
+  const GaussianDistribution filled(0.5, 2.0, 21);
+  const GaussianDistribution sampled(0.5, 2.0, 21);
+  std::vector<double> buffer(1000);
+  filled.fill(buffer);
+  const std::vector<double> draws = sampled.sample(1000);
+
+  EXPECT_EQ(buffer, draws)
+      << "GaussianDistribution.fill not matching GaussianDistribution.sample.";
+}
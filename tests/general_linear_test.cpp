@@ -1,7 +1,10 @@
 #include "stochastic_models/numeric_utils/helpers.h"
 #include "stochastic_models/sde/general_linear.h"
 
+#include <cmath>
 #include <gtest/gtest.h>
+#include <memory>
+#include <vector>
 /**
  * @file
  * @brief Unit tests for the GeneralLinearModel class (mean/variance helpers).
@@ -38,3 +41,50 @@ TEST(GeneralLinearModelTest, GetConditionalVarianceTest) {
       << "GeneralLinearLikelihood getConditionalVariance method returning "
          "invalid value.";
 }
+
+// Tests that the virtual coreEquation adapter applies the stepping kernel.
+TEST(GeneralLinearModelTest, CoreEquationKernelTest) {
+  const double tolerance = 1e-12;
+  const std::unique_ptr<const StochasticModel> model =
+      std::make_unique<const GeneralLinearModel>(-0.1, 0.5);
+  const double expected =
+      2.0 * std::exp(-0.1 * 3) + 0.5 * std::sqrt(3.0) * 0.7;
+  const double actual = model->coreEquation(2.0, 0.7, 3);
+  EXPECT_LE(abs(actual - expected), tolerance)
+      << "GeneralLinearModel coreEquation not applying the stepping kernel.";
+}
+
+// Tests the size and reproducibility of the SimulatePaths method.
+TEST(GeneralLinearModelTest, SimulatePathsTest) {
+  const GeneralLinearModel model(-0.1, 0.5);
+  const std::vector<double> first = model.SimulatePaths(1.0, 300, 5, 0.5, 3);
+  const std::vector<double> second = model.SimulatePaths(1.0, 300, 5, 0.5, 3);
+  ASSERT_EQ(first.size(), 1500U)
+      << "GeneralLinearModel SimulatePaths returning invalid size.";
+  EXPECT_EQ(first[0], 1.0)
+      << "GeneralLinearModel SimulatePaths not starting at start.";
+  EXPECT_EQ(first, second)
+      << "GeneralLinearModel SimulatePaths not reproducible for a seed.";
+}
+
+// Tests that Simulate returns size + 1 values starting at start.
+TEST(GeneralLinearModelTest, SimulateSizeTest) {
+  const GeneralLinearModel model(-0.1, 0.5);
+  const std::vector<double> series = model.Simulate(1.0, 20, 1);
+  ASSERT_EQ(series.size(), 21U)
+      << "GeneralLinearModel Simulate returning invalid size.";
+  EXPECT_EQ(series[0], 1.0)
+      << "GeneralLinearModel Simulate not starting at start.";
+}
+
+// Tests that SimulateStream produces the requested number of values.
+TEST(GeneralLinearModelTest, SimulateStreamTest) {
+  const GeneralLinearModel model(-0.1, 0.5);
+  std::size_t count = 0;
+  for (std::span<const double> chunk :
+       model.SimulateStream(1.0, 1001, 0.5, 100, 3)) {
+    count += chunk.size();
+  }
+  EXPECT_EQ(count, 1001U)
+      << "GeneralLinearModel SimulateStream producing invalid size.";
+}
@@ -3,6 +3,7 @@
 #include "stochastic_models/numeric_utils/helpers.h"
 #include "stochastic_models/numeric_utils/integration.h"
 
+#include <cmath>
 #include <cstdlib>
 #include <gtest/gtest.h>
 /**
@@ -66,3 +67,74 @@ TEST(HittingTimeDensityTest, CatchErrorTest) {
   ) << "hittingTimeDensity function must throw a runtime_error when a void "
        "pointer to the wrong type is provided.";
 }
+/**
+ * @test Tests that the closed-form hitting-time density agrees with the
+ * quadrature across parameter regimes and that the kernel overload selects it.
+ *
+ */
+TEST(HittingTimeDensityTest, ClosedFormAccuracyTest) {
+  struct Regime {
+    double mu, alpha, sigma, x, first, second;
+  };
+  const Regime regimes[] = {
+      {0.998, 0.0045, 0.0038, 1.02, 1.04, 1.0},
+      {0.0, 2.0, 1.0, 0.2, 0.6, -0.3},
+      {0.0, 0.1, 0.2, 0.0, 1.0, -0.5},
+      {0.5, 8.0, 0.3, 0.45, 0.3, 0.7},
+      {0.0, 1.0, 0.1, 0.2, 0.3, 0.1},
+  };
+  for (const Regime& regime : regimes) {
+    HittingTimeOrnsteinUhlenbeck kernel(regime.mu, regime.alpha, regime.sigma);
+    double x = regime.x;
+    double first = regime.first;
+    double second = regime.second;
+    const double quadrature = hittingTimeDensity(
+        x, &integrateHittingTimeDensity, &kernel, first, second
+    );
+    const double closed_form = hittingTimeDensityClosedForm(
+        regime.x, kernel, regime.first, regime.second
+    );
+    EXPECT_LE(abs(closed_form - quadrature), 1e-7 * abs(quadrature))
+        << "The closed-form density disagrees with the quadrature for alpha = "
+        << regime.alpha << ".";
+    EXPECT_EQ(
+        hittingTimeDensity(regime.x, kernel, regime.first, regime.second),
+        closed_form
+    );
+  }
+}
+/**
+ * @test Tests that the closed form stays finite where the integrand of the
+ * quadrature overflows and that the kernel overload falls back to the
+ * quadrature where the closed form does not apply.
+ *
+ */
+TEST(HittingTimeDensityTest, ClosedFormRangeTest) {
+  // alpha / sigma^2 = 5e5, so exp(alpha x^2 / sigma^2) overflows at x = 0.1.
+  const HittingTimeOrnsteinUhlenbeck steep(0.0, 50.0, 0.01);
+  double previous = 0.0;
+  for (const double x : {0.05, 0.09, 0.099, 0.0999, 0.1}) {
+    const double value = hittingTimeDensityClosedForm(x, steep, 0.1, 0.05);
+    ASSERT_TRUE(std::isfinite(value));
+    EXPECT_GE(value, previous)
+        << "The density is not increasing towards the first level.";
+    previous = value;
+  }
+  EXPECT_EQ(hittingTimeDensityClosedForm(0.05, steep, 0.1, 0.05), 0.0);
+  EXPECT_LE(abs(previous - 1.0), 1e-12);
+
+  // A negative alpha has no closed form and is integrated.
+  HittingTimeOrnsteinUhlenbeck diverging(0.0, -0.5, 0.4);
+  EXPECT_TRUE(
+      std::isnan(hittingTimeDensityClosedForm(0.2, diverging, 0.5, -0.1))
+  );
+  double x = 0.2;
+  double first = 0.5;
+  double second = -0.1;
+  EXPECT_EQ(
+      hittingTimeDensity(0.2, diverging, 0.5, -0.1),
+      hittingTimeDensity(
+          x, &integrateHittingTimeDensity, &diverging, first, second
+      )
+  );
+}
@@ -3,6 +3,7 @@
 #include "stochastic_models/sde/ornstein_uhlenbeck.h"
 #include "stochastic_models/trading/optimal_mean_reversion.h"
 
+#include <cmath>
 #include <cstdlib>
 #include <gtest/gtest.h>
 /**
@@ -150,7 +151,7 @@ TEST(OptimalMeanReversionTest, methodDOutputTest) {
   delete hitting_time_kernel;
 
   // Assert that the value is near the expected value.
-  EXPECT_LE(abs(roundToDecimals(value, 8) + 129.094), tolerance)
+  EXPECT_LE(abs(roundToDecimals(value, 8) + 129.096), tolerance)
       << "Value produced by OptimalMeanReversion::d is not equal to the "
          "expected value.";
 }
@@ -182,7 +183,7 @@ TEST(OptimalMeanReversionTest, methodDStopLossOutputTest) {
   delete hitting_time_kernel;
 
   // Assert that the value is near the expected value.
-  EXPECT_LE(abs(roundToDecimals(value, 8) + 129.094), tolerance)
+  EXPECT_LE(abs(roundToDecimals(value, 8) + 129.096), tolerance)
       << "Value produced by OptimalMeanReversion::d is not equal to the "
          "expected value when a stop loss is provided.";
 }
@@ -214,7 +215,7 @@ TEST(OptimalMeanReversionTest, methodAStopLossOutputTest) {
   delete hitting_time_kernel;
 
   // Assert that the value is near the expected value.
-  EXPECT_LE(abs(roundToDecimals(value, 8) + 132.55), tolerance)
+  EXPECT_LE(abs(roundToDecimals(value, 8) + 132.553), tolerance)
       << "Value produced by OptimalMeanReversion::a is not equal to the "
          "expected value when a stop loss is provided.";
 }
@@ -343,3 +344,173 @@ TEST(OptimalMeanReversionTest, methodBelowVStopLossOutputTest) {
       << "Value produced by OptimalMeanReversion::V is not equal to the "
          "expected value when x is below b* and a stop loss is provided.";
 }
+/**
+ * @test Tests that the fixed-order quadrature of F(x;r) and G(x;r) agrees with
+ * the adaptive integration across parameter regimes and starting points up to
+ * six stationary standard deviations from the mean.
+ *
+ */
+TEST(OptimalMeanReversionTest, FixedOrderQuadratureTest) {
+  // Each row holds mu, alpha, sigma and r.
+  const double parameters[][4] = {
+      {0.995, 0.02, 0.003, 0.05},
+      {0.3, 8.0, 0.3, 0.05},
+      {0.5388, 16.6677, 0.1599, 0.05},
+      {0.0, 0.5, 1.0, 0.5},
+      {0.0, 0.01, 0.2, 0.3},
+  };
+  const double tolerance = 1e-6;
+  const OptimalMeanReversion adaptive(TransformQuadrature::Adaptive);
+  const OptimalMeanReversion fixed_order;
+  EXPECT_EQ(fixed_order.getQuadrature(), TransformQuadrature::FixedOrder);
+
+  for (const auto& row : parameters) {
+    const HittingTimeOrnsteinUhlenbeck hitting_time_kernel(
+        row[0], row[1], row[2]
+    );
+    const double r = row[3];
+    const double deviation = row[2] / std::sqrt(2 * row[1]);
+    for (int k{-6}; k <= 6; ++k) {
+      const double x = row[0] + k * deviation;
+      const double f_adaptive = adaptive.F(&hitting_time_kernel, x, r, 0.0);
+      const double g_adaptive = adaptive.G(&hitting_time_kernel, x, r, 0.0);
+      EXPECT_LE(
+          abs(fixed_order.F(&hitting_time_kernel, x, r, 0.0) - f_adaptive),
+          tolerance * f_adaptive
+      ) << "Fixed-order F disagrees with the adaptive integration at mu = "
+        << row[0] << ", alpha = " << row[1] << ", x = " << x << ".";
+      EXPECT_LE(
+          abs(fixed_order.G(&hitting_time_kernel, x, r, 0.0) - g_adaptive),
+          tolerance * g_adaptive
+      ) << "Fixed-order G disagrees with the adaptive integration at mu = "
+        << row[0] << ", alpha = " << row[1] << ", x = " << x << ".";
+    }
+  }
+}
+/**
+ * @test Tests that the fixed-order quadrature falls back to the adaptive
+ * integration far from the mean, where the rule has not been validated.
+ *
+ */
+TEST(OptimalMeanReversionTest, FixedOrderFallbackTest) {
+  const double mu = 0.0;
+  const double alpha = 0.5;
+  const double sigma = 1.0;
+  const double r = 0.5;
+  const HittingTimeOrnsteinUhlenbeck hitting_time_kernel(mu, alpha, sigma);
+  const OptimalMeanReversion adaptive(TransformQuadrature::Adaptive);
+  const OptimalMeanReversion fixed_order(TransformQuadrature::FixedOrder);
+  const OptimalMeanReversion* copy = fixed_order.clone();
+
+  // Ten stationary standard deviations above the mean.
+  const double x = 10.0;
+  EXPECT_EQ(
+      fixed_order.F(&hitting_time_kernel, x, r, 0.0),
+      adaptive.F(&hitting_time_kernel, x, r, 0.0)
+  );
+  EXPECT_EQ(
+      fixed_order.G(&hitting_time_kernel, -x, r, 0.0),
+      adaptive.G(&hitting_time_kernel, -x, r, 0.0)
+  );
+  EXPECT_EQ(copy->getQuadrature(), TransformQuadrature::FixedOrder)
+      << "Cloning does not preserve the quadrature.";
+  delete copy;
+}
+/**
+ * @test Tests that OptimalMeanReversion::transforms matches F(x;r) and G(x;r)
+ * and central differences of them for both quadratures.
+ *
+ */
+TEST(OptimalMeanReversionTest, TransformsTest) {
+  const double alpha = 8;
+  const double mu = 0.3;
+  const double sigma = 0.3;
+  const double r = 0.05;
+  const double h = 1e-5;
+  const double tolerance = 1e-6;
+  const HittingTimeOrnsteinUhlenbeck hitting_time_kernel(mu, alpha, sigma);
+
+  for (const TransformQuadrature quadrature :
+       {TransformQuadrature::Adaptive, TransformQuadrature::FixedOrder}) {
+    const OptimalMeanReversion mean_reversion(quadrature);
+    for (const double x : {0.05, 0.2, 0.3, 0.45}) {
+      const OptimalTradingTransforms transforms =
+          mean_reversion.transforms(&hitting_time_kernel, x, r);
+      const double f_difference =
+          (mean_reversion.F(&hitting_time_kernel, x + h, r, 0.0) -
+           mean_reversion.F(&hitting_time_kernel, x - h, r, 0.0)) /
+          (2 * h);
+      const double g_difference =
+          (mean_reversion.G(&hitting_time_kernel, x + h, r, 0.0) -
+           mean_reversion.G(&hitting_time_kernel, x - h, r, 0.0)) /
+          (2 * h);
+
+      EXPECT_LE(
+          abs(transforms.F - mean_reversion.F(&hitting_time_kernel, x, r, 0.0)),
+          tolerance * transforms.F
+      );
+      EXPECT_LE(
+          abs(transforms.G - mean_reversion.G(&hitting_time_kernel, x, r, 0.0)),
+          tolerance * transforms.G
+      );
+      EXPECT_LE(
+          abs(transforms.F_prime - f_difference),
+          1e-4 * abs(transforms.F_prime)
+      ) << "F' disagrees with the central difference at x = " << x << ".";
+      EXPECT_LE(
+          abs(transforms.G_prime - g_difference),
+          1e-4 * abs(transforms.G_prime)
+      ) << "G' disagrees with the central difference at x = " << x << ".";
+    }
+  }
+}
+/**
+ * @test Tests that the asymptotic transforms agree with the adaptive
+ * integration to first order in r / alpha, consistently between F, G and
+ * transforms, and bypass the transform cache.
+ *
+ */
+TEST(OptimalMeanReversionTest, AsymptoticQuadratureTest) {
+  // Each row holds mu, alpha, sigma and r.
+  const double parameters[][4] = {
+      {0.3, 8.0, 0.3, 0.05},
+      {0.5388, 16.6677, 0.1599, 0.05},
+      {0.0, 1.0, 0.3, 0.01},
+  };
+  const OptimalMeanReversion adaptive(TransformQuadrature::Adaptive);
+  const OptimalMeanReversion asymptotic(TransformQuadrature::Asymptotic);
+
+  for (const auto& row : parameters) {
+    const HittingTimeOrnsteinUhlenbeck hitting_time_kernel(
+        row[0], row[1], row[2]
+    );
+    const double r = row[3];
+    // The relative error of the leading order grows like 2 r / alpha.
+    const double tolerance = 4 * r / row[1];
+    const double deviation = row[2] / std::sqrt(2 * row[1]);
+    for (int k{-4}; k <= 4; ++k) {
+      const double x = row[0] + k * deviation;
+      const OptimalTradingTransforms exact =
+          adaptive.transforms(&hitting_time_kernel, x, r);
+      const OptimalTradingTransforms approximate =
+          asymptotic.transforms(&hitting_time_kernel, x, r);
+      EXPECT_LE(abs(approximate.F - exact.F), tolerance * exact.F)
+          << "Asymptotic F disagrees with the adaptive integration at x = "
+          << x << ".";
+      EXPECT_LE(abs(approximate.G - exact.G), tolerance * exact.G)
+          << "Asymptotic G disagrees with the adaptive integration at x = "
+          << x << ".";
+      EXPECT_LE(
+          abs(approximate.F_prime - exact.F_prime),
+          tolerance * abs(exact.F_prime)
+      );
+      EXPECT_LE(
+          abs(approximate.G_prime - exact.G_prime),
+          tolerance * abs(exact.G_prime)
+      );
+      EXPECT_EQ(approximate.F, asymptotic.F(&hitting_time_kernel, x, r, 0.0));
+      EXPECT_EQ(approximate.G, asymptotic.G(&hitting_time_kernel, x, r, 0.0));
+    }
+  }
+  EXPECT_EQ(asymptotic.getTransformCache()->size(), 0);
+}
@@ -26,7 +26,7 @@ TEST(OptimalTradingLevelsTest, optimalEntryLowerStopLossOutputTest) {
       optimalEntryLevelLower(d_star, b_star, mu, alpha, sigma, stop_loss, r, c);
 
   // Assert that the value is near the expected value.
-  EXPECT_LE(abs(roundToDecimals(value, 8) - 0.118451), tolerance)
+  EXPECT_LE(abs(roundToDecimals(value, 8) - 0.118436), tolerance)
       << "Value produced by optimalEntryLevelLower function "
          "with a stop loss is not equal to the expected value.";
 }
@@ -71,7 +71,7 @@ TEST(OptimalTradingLevelsTest, optimalEntryLevelStopLossOutputTest) {
       optimalEntryLevel(b_star, mu, alpha, sigma, stop_loss, r, c);
 
   // Assert that the value is near the expected value.
-  EXPECT_LE(abs(roundToDecimals(value, 8) - 0.136755), tolerance)
+  EXPECT_LE(abs(roundToDecimals(value, 8) - 0.136269), tolerance)
       << "Value produced by optimalEntryLevel function "
          "with a stop loss is not equal to the expected value.";
 }
@@ -94,7 +94,7 @@ TEST(OptimalTradingLevelsTest, optimalExitLevelStopLossOutputTest) {
   const double value = optimalExitLevel(mu, alpha, sigma, stop_loss, r, c);
 
   // Assert that the value is near the expected value.
-  EXPECT_LE(abs(roundToDecimals(value, 8) - 0.46912012), tolerance)
+  EXPECT_LE(abs(roundToDecimals(value, 8) - 0.45089478), tolerance)
       << "Value produced by optimalExitLevel function "
          "with a stop loss is not equal to the expected value.";
 }
@@ -162,7 +162,7 @@ TEST(OptimalTradingLevelsTest, optimalEntryLevelExponentialOutputTest) {
       optimalEntryLevelExponential(b_star, mu, alpha, sigma, r, c);
 
   // Assert that the value is near the expected value.
-  EXPECT_LE(abs(roundToDecimals(value, 8) - 1.24096), tolerance)
+  EXPECT_LE(abs(roundToDecimals(value, 8) - 1.236887), tolerance)
       << "Value produced by optimalEntryLevelExponential function "
          "is not equal to the expected value.";
 }
@@ -197,7 +197,7 @@ TEST(OptimalTradingLevelsTest, optimalEntryLevelLowerExponentialOutputTest) {
   const double alpha = 5;
   const double mu = 1.3499;
   const double sigma = 0.15;
-  const double d_star = 1.24096;
+  const double d_star = 1.236887;
   const double b_star = 1.4093;
   const double c = 0.02;
   const double r = 0.05;
@@ -208,7 +208,7 @@ TEST(OptimalTradingLevelsTest, optimalEntryLevelLowerExponentialOutputTest) {
       optimalEntryLevelLowerExponential(d_star, b_star, mu, alpha, sigma, r, c);
 
   // Assert that the value is near the expected value.
-  EXPECT_LE(abs(roundToDecimals(value, 8) - 1.16016), tolerance)
+  EXPECT_LE(abs(roundToDecimals(value, 8) - 1.160238), tolerance)
       << "Value produced by optimalEntryLevelLowerExponential function "
          "is not equal to the expected value.";
 }
@@ -231,7 +231,7 @@ TEST(OptimalTradingLevelsTest, optimalEntryLevelOutputTest) {
   const double value = optimalEntryLevel(b_star, mu, alpha, sigma, r, c);
 
   // Assert that the value is near the expected value.
-  EXPECT_LE(abs(roundToDecimals(value, 8) - 0.116948), tolerance)
+  EXPECT_LE(abs(roundToDecimals(value, 8) - 0.115681), tolerance)
       << "Value produced by optimalEntryLevel function "
          "is not equal to the expected value.";
 }
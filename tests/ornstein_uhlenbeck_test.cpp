@@ -2,8 +2,35 @@
 #include "stochastic_models/numeric_utils/helpers.h"
 #include "stochastic_models/sde/ornstein_uhlenbeck.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <gtest/gtest.h>
+#include <memory>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+// Cross-sectional mean of the last step of step-major paths, as returned by
+// OrnsteinUhlenbeckModel::SimulatePaths.
+double lastStepMean(
+    const std::vector<double>& paths, const std::size_t n_paths
+) {
+  return std::accumulate(paths.end() - n_paths, paths.end(), 0.0) /
+         static_cast<double>(n_paths);
+}
+// Cross-sectional sample variance of the last step of step-major paths.
+double lastStepVariance(
+    const std::vector<double>& paths, const std::size_t n_paths
+) {
+  const double mean = lastStepMean(paths, n_paths);
+  double variance = 0.0;
+  for (auto it = paths.end() - n_paths; it != paths.end(); ++it) {
+    variance += (*it - mean) * (*it - mean);
+  }
+  return variance / static_cast<double>(n_paths - 1);
+}
 /**
  * @test Tests the output of the
  * OrnsteinUhlenbeckModel::getUnconditionalVariance method and asserts that it
@@ -39,6 +66,300 @@ TEST(OrnsteinUhlenbeckModelTest, getMeanOutputTest) {
       << "OrnsteinUhlenbeckModel not calculating "
          "correct value for getMean method.";
 }
+/**
+ * @test Tests that OrnsteinUhlenbeckModel::SimulatePaths returns a step-major
+ * buffer of the requested size with every path starting at the start value.
+ *
+ */
+TEST(OrnsteinUhlenbeckModelTest, SimulatePathsLayoutTest) {
+  const OrnsteinUhlenbeckModel model(0.5, 0.02, 0.05);
+  const std::size_t n_paths = 1000;
+  const std::size_t n_steps = 20;
+  const std::vector<double> paths =
+      model.SimulatePaths(0.3, n_paths, n_steps, 1.0, 42);
+
+  ASSERT_EQ(paths.size(), n_paths * n_steps)
+      << "SimulatePaths not returning n_paths * n_steps values.";
+  for (std::size_t p = 0; p < n_paths; ++p) {
+    EXPECT_EQ(paths[p], 0.3) << "SimulatePaths not starting path " << p
+                             << " at the start value.";
+  }
+}
+/**
+ * @test Tests that OrnsteinUhlenbeckModel::SimulatePaths is reproducible for a
+ * fixed seed and produces different paths for different seeds.
+ *
+ */
+TEST(OrnsteinUhlenbeckModelTest, SimulatePathsSeedTest) {
+  const OrnsteinUhlenbeckModel model(0.5, 0.02, 0.05);
+  const std::vector<double> first = model.SimulatePaths(0.3, 600, 10, 1.0, 7);
+  const std::vector<double> second = model.SimulatePaths(0.3, 600, 10, 1.0, 7);
+  const std::vector<double> other = model.SimulatePaths(0.3, 600, 10, 1.0, 8);
+
+  EXPECT_EQ(first, second)
+      << "SimulatePaths not reproducible for the same seed.";
+  EXPECT_NE(first, other)
+      << "SimulatePaths producing identical paths for different seeds.";
+}
+/**
+ * @test Tests that the cross-sectional mean of the final step of
+ * OrnsteinUhlenbeckModel::SimulatePaths is near the conditional mean of the
+ * Ornstein-Uhlenbeck process.
+ *
+ */
+TEST(OrnsteinUhlenbeckModelTest, SimulatePathsMeanTest) {
+  const float tolerance = 1e-2;
+  const double mu = 0.5;
+  const double alpha = 0.2;
+  const double start = 0.1;
+  const std::size_t n_paths = 20000;
+  const std::size_t n_steps = 11;
+  const OrnsteinUhlenbeckModel model(mu, alpha, 0.05);
+  const std::vector<double> paths =
+      model.SimulatePaths(start, n_paths, n_steps, 1.0, 123);
+
+  const double mean = lastStepMean(paths, n_paths);
+  const double expected = mu + (start - mu) * std::exp(-alpha * (n_steps - 1));
+
+  EXPECT_LE(abs(mean - expected), tolerance)
+      << "SimulatePaths final step mean not near the conditional mean.";
+}
+/**
+ * @test Tests that OrnsteinUhlenbeckModel::SimulatePaths throws when the
+ * output buffer is too small.
+ *
+ */
+TEST(OrnsteinUhlenbeckModelTest, SimulatePathsBufferSizeTest) {
+  const OrnsteinUhlenbeckModel model(0.5, 0.02, 0.05);
+  std::vector<double> buffer(10);
+
+  EXPECT_THROW(
+      model.SimulatePaths(buffer, 0.3, 5, 3, 1.0, 1), std::invalid_argument
+  ) << "SimulatePaths not rejecting an undersized buffer.";
+}
+/**
+ * @test Tests that OrnsteinUhlenbeckModel::stepConstants returns the exact
+ * transition constants, including the alpha -> 0 limit.
+ *
+ */
+TEST(OrnsteinUhlenbeckModelTest, stepConstantsExactTest) {
+  const double tolerance = 1e-12;
+  const double dt = 0.5;
+  const OrnsteinUhlenbeckModel model(0.5, 0.2, 0.05);
+  const OrnsteinUhlenbeckStepConstants step =
+      model.stepConstants(dt, DiscretizationScheme::Exact);
+
+  EXPECT_LE(abs(step.delta - std::exp(-0.2 * dt)), tolerance)
+      << "stepConstants not calculating the exact mean factor.";
+  EXPECT_LE(abs(step.drift - 0.5 * (1 - std::exp(-0.2 * dt))), tolerance)
+      << "stepConstants not calculating the exact mean offset.";
+  EXPECT_LE(
+      abs(step.scale -
+          0.05 * std::sqrt((1 - std::exp(-2 * 0.2 * dt)) / (2 * 0.2))),
+      tolerance
+  ) << "stepConstants not calculating the exact standard deviation.";
+
+  const OrnsteinUhlenbeckModel brownian(0.5, 0.0, 0.05);
+  const OrnsteinUhlenbeckStepConstants limit =
+      brownian.stepConstants(dt, DiscretizationScheme::Exact);
+  EXPECT_LE(abs(limit.scale - 0.05 * std::sqrt(dt)), tolerance)
+      << "stepConstants not tending to sigma * sqrt(dt) as alpha -> 0.";
+}
+/**
+ * @test Tests that the exact scheme of OrnsteinUhlenbeckModel::SimulatePaths
+ * reproduces the conditional variance of the process even for a large step.
+ *
+ */
+TEST(OrnsteinUhlenbeckModelTest, SimulatePathsExactVarianceTest) {
+  const double tolerance = 2e-2;
+  const double alpha = 0.2;
+  const double sigma = 0.3;
+  const double dt = 5.0;
+  const std::size_t n_paths = 50000;
+  const OrnsteinUhlenbeckModel model(0.5, alpha, sigma);
+  const std::vector<double> paths = model.SimulatePaths(
+      0.1, n_paths, 2, dt, 17, DiscretizationScheme::Exact
+  );
+
+  const double variance = lastStepVariance(paths, n_paths);
+  const double expected =
+      sigma * sigma * (1 - std::exp(-2 * alpha * dt)) / (2 * alpha);
+
+  EXPECT_LE(abs(variance / expected - 1.0), tolerance)
+      << "Exact scheme not reproducing the conditional variance.";
+}
+/**
+ * @test Tests that one Euler–Maruyama step of a fractional dt has the
+ * conditional variance of the process to first order in dt.
+ *
+ */
+TEST(OrnsteinUhlenbeckModelTest, SimulatePathsEulerMaruyamaVarianceTest) {
+  const double tolerance = 2e-2;
+  const double dt = 0.01;
+  const std::size_t n_paths = 50000;
+  const OrnsteinUhlenbeckModel model(0.5, 0.2, 0.3);
+  const std::vector<double> paths = model.SimulatePaths(
+      0.1, n_paths, 2, dt, 17, DiscretizationScheme::EulerMaruyama
+  );
+
+  const double variance = lastStepVariance(paths, n_paths);
+  const double expected = model.getConditionalVariance(dt);
+
+  EXPECT_LE(abs(variance / expected - 1.0), tolerance)
+      << "Euler–Maruyama step not scaling the noise by sqrt(dt).";
+}
+/**
+ * @test Tests that the exact-scheme OrnsteinUhlenbeckModel::Simulate overload
+ * returns a series of the requested size starting at the start value.
+ *
+ */
+TEST(OrnsteinUhlenbeckModelTest, SimulateExactTest) {
+  const OrnsteinUhlenbeckModel model(0.5, 0.2, 0.05);
+  const std::vector<double> series =
+      model.Simulate(0.3, 50, 0.1, DiscretizationScheme::Exact);
+
+  ASSERT_EQ(series.size(), 50U) << "Simulate not returning size values.";
+  EXPECT_EQ(series.front(), 0.3) << "Simulate not starting at start.";
+}
+/**
+ * @test Tests that the virtual OrnsteinUhlenbeckModel::coreEquation adapter
+ * applies the compile-time stepping kernel and matches the Euler–Maruyama
+ * step.
+ *
+ */
+TEST(OrnsteinUhlenbeckModelTest, coreEquationKernelTest) {
+  static_assert(SteppingKernel<OrnsteinUhlenbeckStepConstants>);
+  const double tolerance = 1e-12;
+  const std::unique_ptr<const StochasticModel> model =
+      std::make_unique<const OrnsteinUhlenbeckModel>(0.5, 0.2, 0.05);
+  const double delta = std::exp(-0.2 * 2);
+  const double expected =
+      0.3 * delta + 0.5 * (1 - delta) + std::sqrt(2.0) * 0.05 * 0.7;
+  const double actual = model->coreEquation(0.3, 0.7, 2);
+
+  EXPECT_LE(abs(actual - expected), tolerance)
+      << "coreEquation not matching the Euler–Maruyama step.";
+}
+/**
+ * @test Tests that OrnsteinUhlenbeckModel::coreEquation accepts a fractional
+ * time step.
+ *
+ */
+TEST(OrnsteinUhlenbeckModelTest, coreEquationFractionalStepTest) {
+  const double tolerance = 1e-12;
+  const OrnsteinUhlenbeckModel model(0.5, 0.2, 0.05);
+  const double delta = std::exp(-0.2 * 0.25);
+  const double expected = 0.3 * delta + 0.5 * (1 - delta) + 0.5 * 0.05 * 0.7;
+
+  EXPECT_LE(abs(model.coreEquation(0.3, 0.7, 0.25) - expected), tolerance)
+      << "coreEquation not applying a fractional time step.";
+}
+/**
+ * @test Tests that OrnsteinUhlenbeckModel::SimulateAdaptive covers the horizon
+ * on a grid of multiples of dt and uses fewer samples than a uniform grid when
+ * the process is far from the levels.
+ *
+ */
+TEST(OrnsteinUhlenbeckModelTest, SimulateAdaptiveCoarseningTest) {
+  const double dt = 0.01;
+  const OrnsteinUhlenbeckModel model(0.5, 0.5, 0.01);
+  const std::vector<double> levels{10.0, -10.0};
+  const TimedSeries series = model.SimulateAdaptive(0.5, 100.0, dt, levels);
+
+  ASSERT_EQ(series.times.size(), series.values.size())
+      << "SimulateAdaptive returning mismatched times and values.";
+  EXPECT_EQ(series.times.front(), 0.0)
+      << "SimulateAdaptive not starting at time zero.";
+  EXPECT_EQ(series.values.front(), 0.5)
+      << "SimulateAdaptive not starting at the start value.";
+  EXPECT_LE(abs(series.times.back() - 100.0), 1e-9)
+      << "SimulateAdaptive not ending at the horizon.";
+  EXPECT_LT(series.times.size(), 10001U / 32)
+      << "SimulateAdaptive not coarsening far from the levels.";
+  for (const double& time : series.times) {
+    EXPECT_LE(abs(time / dt - std::round(time / dt)), 1e-6)
+        << "SimulateAdaptive sample time not a multiple of dt.";
+  }
+}
+/**
+ * @test Tests that OrnsteinUhlenbeckModel::SimulateAdaptive keeps the finest
+ * step while a level is within reach of a coarser step.
+ *
+ */
+TEST(OrnsteinUhlenbeckModelTest, SimulateAdaptiveNearLevelTest) {
+  const double dt = 0.01;
+  const OrnsteinUhlenbeckModel model(0.5, 0.5, 0.01);
+  const std::vector<double> levels{0.5};
+  // A large multiple keeps every coarse step within reach of the level.
+  AdaptiveSimulationOptions options;
+  options.distance_multiple = 1e6;
+  const TimedSeries series =
+      model.SimulateAdaptive(0.5, 0.1, dt, levels, options);
+
+  ASSERT_EQ(series.times.size(), 11U)
+      << "SimulateAdaptive not using the finest step near a level.";
+  EXPECT_THROW(
+      model.SimulateAdaptive(0.5, 1.0, 0.0, levels), std::invalid_argument
+  ) << "SimulateAdaptive not rejecting a non-positive dt.";
+}
+/**
+ * @test Tests that OrnsteinUhlenbeckModel::SimulateStream produces the same
+ * path whatever the chunk size.
+ *
+ */
+TEST(OrnsteinUhlenbeckModelTest, SimulateStreamChunkSizeTest) {
+  static_assert(
+      std::ranges::input_range<PathStream<OrnsteinUhlenbeckStepConstants>>
+  );
+  const OrnsteinUhlenbeckModel model(0.5, 0.2, 0.05);
+  const std::size_t n_steps = 1000;
+  std::vector<double> small_chunks;
+  std::vector<double> large_chunks;
+  for (std::span<const double> chunk :
+       model.SimulateStream(0.3, n_steps, 0.1, 7, 11, 2)) {
+    small_chunks.insert(small_chunks.end(), chunk.begin(), chunk.end());
+  }
+  PathStream<OrnsteinUhlenbeckStepConstants> stream =
+      model.SimulateStream(0.3, n_steps, 0.1, 4096, 11, 2);
+  const std::span<const double> whole = stream.next();
+  large_chunks.assign(whole.begin(), whole.end());
+
+  ASSERT_EQ(small_chunks.size(), n_steps)
+      << "SimulateStream not producing n_steps values.";
+  EXPECT_EQ(small_chunks.front(), 0.3)
+      << "SimulateStream not starting at the start value.";
+  EXPECT_EQ(small_chunks, large_chunks)
+      << "SimulateStream path depending on the chunk size.";
+  EXPECT_TRUE(stream.done()) << "SimulateStream not exhausted.";
+  EXPECT_TRUE(stream.next().empty())
+      << "SimulateStream producing values after exhaustion.";
+}
+/**
+ * @test Tests reducing an OrnsteinUhlenbeckModel::SimulateStream on the fly
+ * to the first step at which a level is crossed.
+ *
+ */
+TEST(OrnsteinUhlenbeckModelTest, SimulateStreamFirstPassageTest) {
+  const OrnsteinUhlenbeckModel model(0.5, 1.0, 0.2);
+  const double level = 0.5;
+  PathStream<OrnsteinUhlenbeckStepConstants> stream =
+      model.SimulateStream(0.0, 100000, 0.01, 64, 5);
+  std::size_t crossing = 0;
+  while (!stream.done()) {
+    const std::size_t offset = stream.position();
+    const std::span<const double> chunk = stream.next();
+    const auto hit = std::ranges::find_if(chunk, [&](const double value) {
+      return value >= level;
+    });
+    if (hit != chunk.end()) {
+      crossing = offset + static_cast<std::size_t>(hit - chunk.begin());
+      break;
+    }
+  }
+
+  EXPECT_GT(crossing, 0U) << "SimulateStream path never crossed the mean.";
+  EXPECT_LT(crossing, 100000U) << "SimulateStream path never crossed the mean.";
+}
 /**
  * @test Tests the output of the
  * HittingTimeOrnsteinUhlenbeck::hittingTimeDensityCore method and asserts that
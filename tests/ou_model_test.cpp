@@ -27,6 +27,19 @@ TEST(OuModelTest, simulateOrnsteinUhlenbeckOutputTest) {
          "simulateOrnsteinUhlenbeck is not equal to the expected size.";
 }
 
+/**
+ * @test Tests that simulateOrnsteinUhlenbeck accepts a fractional time step.
+ */
+TEST(OuModelTest, simulateOrnsteinUhlenbeckFractionalStepTest) {
+  const unsigned int size = 20;
+  const std::vector<double> series =
+      simulateOrnsteinUhlenbeck(0.5, 0.01, 0.0067, 0.0, size, 0.25);
+
+  EXPECT_EQ(series.size(), size)
+      << "The size of the series returned by simulateOrnsteinUhlenbeck with a "
+         "fractional time step is not equal to the expected size.";
+}
+
 /**
  * @test Tests the output of the hittingTimeDensityOrnsteinUhlenbeck function
  * and asserts that it is near the expected value.
@@ -0,0 +1,197 @@
+#include "stochastic_models/distributions/random.h"
+
+#include <cmath>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+/**
+ * @test Tests PhiloxEngine::generateBlock against the Philox4x32-10 known
+ * answer vectors published with the Random123 library.
+ *
+ */
+TEST(PhiloxEngineTest, KnownAnswerTest) {
+  const PhiloxEngine::counter_type zeros =
+      PhiloxEngine::generateBlock({0, 0, 0, 0}, {0, 0});
+  const PhiloxEngine::counter_type ones = PhiloxEngine::generateBlock(
+      {0xFFFFFFFFU, 0xFFFFFFFFU, 0xFFFFFFFFU, 0xFFFFFFFFU},
+      {0xFFFFFFFFU, 0xFFFFFFFFU}
+  );
+  const PhiloxEngine::counter_type digits = PhiloxEngine::generateBlock(
+      {0x243F6A88U, 0x85A308D3U, 0x13198A2EU, 0x03707344U},
+      {0xA4093822U, 0x299F31D0U}
+  );
+
+  EXPECT_EQ(
+      zeros,
+      (PhiloxEngine::counter_type{
+          0x6627E8D5U, 0xE169C58DU, 0xBC57AC4CU, 0x9B00DBD8U
+      })
+  ) << "Philox block for the zero counter does not match the known answer.";
+  EXPECT_EQ(
+      ones,
+      (PhiloxEngine::counter_type{
+          0x408F276DU, 0x41C83B0EU, 0xA20BC7C6U, 0x6D5451FDU
+      })
+  ) << "Philox block for the all-ones counter does not match the known "
+       "answer.";
+  EXPECT_EQ(
+      digits,
+      (PhiloxEngine::counter_type{
+          0xD16CFE09U, 0x94FDCCEBU, 0x5001E420U, 0x24126EA1U
+      })
+  ) << "Philox block for the pi digits counter does not match the known "
+       "answer.";
+}
+/**
+ * @test Tests that engines with the same seed and stream reproduce the same
+ * outputs and that different streams produce different outputs.
+ *
+ */
+TEST(PhiloxEngineTest, StreamReproducibilityTest) {
+  PhiloxEngine first(42, 3);
+  PhiloxEngine second(42, 3);
+  PhiloxEngine other = first.split(4);
+
+  std::vector<std::uint32_t> first_values;
+  std::vector<std::uint32_t> second_values;
+  std::vector<std::uint32_t> other_values;
+  for (unsigned int i{0}; i < 64; ++i) {
+    first_values.push_back(first());
+    second_values.push_back(second());
+    other_values.push_back(other());
+  }
+
+  EXPECT_EQ(first_values, second_values)
+      << "PhiloxEngine not reproducible for the same seed and stream.";
+  EXPECT_NE(first_values, other_values)
+      << "PhiloxEngine producing identical values for different streams.";
+  EXPECT_EQ(other.getSeed(), 42U) << "PhiloxEngine::split not keeping seed.";
+  EXPECT_EQ(other.getStream(), 4U)
+      << "PhiloxEngine::split not setting the stream.";
+}
+/**
+ * @test Tests that PhiloxEngine::discard skips ahead to the same position as
+ * drawing the skipped values one at a time.
+ *
+ */
+TEST(PhiloxEngineTest, DiscardTest) {
+  for (const unsigned long long skip :
+       {0ULL, 1ULL, 3ULL, 4ULL, 5ULL, 1001ULL}) {
+    PhiloxEngine stepped(7);
+    PhiloxEngine skipped(7);
+    // Start part way through a block so partial blocks are exercised.
+    stepped();
+    skipped();
+    for (unsigned long long i{0}; i < skip; ++i) {
+      stepped();
+    }
+    skipped.discard(skip);
+    for (unsigned int i{0}; i < 8; ++i) {
+      EXPECT_EQ(stepped(), skipped())
+          << "PhiloxEngine::discard(" << skip
+          << ") not matching sequential draws.";
+    }
+  }
+}
+/**
+ * @test Tests that PhiloxEngine::normal produces values with approximately
+ * zero mean and unit variance.
+ *
+ */
+TEST(PhiloxEngineTest, NormalMomentsTest) {
+  const double tolerance = 1e-2;
+  const unsigned int size = 200000;
+  PhiloxEngine engine(11);
+  double sum = 0.0;
+  double sum_squares = 0.0;
+  for (unsigned int i{0}; i < size; ++i) {
+    const double value = engine.normal();
+    sum += value;
+    sum_squares += value * value;
+  }
+  const double mean = sum / size;
+  const double variance = sum_squares / size - mean * mean;
+
+  EXPECT_LE(std::abs(mean), tolerance)
+      << "PhiloxEngine::normal mean not near zero.";
+  EXPECT_LE(std::abs(variance - 1.0), tolerance)
+      << "PhiloxEngine::normal variance not near one.";
+}
+/**
+ * @test Tests that the vectorized Box–Muller kernel of
+ * PhiloxEngine::fillNormal agrees with the scalar PhiloxEngine::normal for the
+ * same blocks. The bulk kernel writes the cosine draws of a block of pairs
+ * followed by the sine draws.
+ *
+ */
+TEST(PhiloxEngineTest, FillNormalMatchesScalarTest) {
+  const double tolerance = 1e-12;
+  const std::size_t pairs = 128;
+  PhiloxEngine bulk(5, 2);
+  PhiloxEngine scalar(5, 2);
+  std::vector<double> values(2 * pairs);
+  bulk.fillNormal(values);
+
+  for (std::size_t i{0}; i < pairs; ++i) {
+    const double cosine = scalar.normal();
+    const double sine = scalar.normal();
+    EXPECT_LE(std::abs(values[i] - cosine), tolerance)
+        << "PhiloxEngine::fillNormal cosine draw " << i
+        << " not matching the scalar transform.";
+    EXPECT_LE(std::abs(values[pairs + i] - sine), tolerance)
+        << "PhiloxEngine::fillNormal sine draw " << i
+        << " not matching the scalar transform.";
+  }
+}
+/**
+ * @test Tests that PhiloxEngine::fillNormal transforms a buffer smaller than
+ * a full block of pairs in bulk, as for the 128 values drawn per step by an
+ * antithetic block of simulated paths: the draws are laid out as the cosines
+ * of the pairs followed by their sines, unlike repeated calls to normal.
+ *
+ */
+TEST(PhiloxEngineTest, FillNormalPartialBlockTest) {
+  const double tolerance = 1e-12;
+  const std::size_t pairs = 64;
+  PhiloxEngine bulk(5, 2);
+  PhiloxEngine scalar(5, 2);
+  std::vector<double> values(2 * pairs);
+  bulk.fillNormal(values);
+
+  for (std::size_t i{0}; i < pairs; ++i) {
+    const double cosine = scalar.normal();
+    const double sine = scalar.normal();
+    EXPECT_LE(std::abs(values[i] - cosine), tolerance)
+        << "PhiloxEngine::fillNormal cosine draw " << i
+        << " not taking the bulk path.";
+    EXPECT_LE(std::abs(values[pairs + i] - sine), tolerance)
+        << "PhiloxEngine::fillNormal sine draw " << i
+        << " not taking the bulk path.";
+  }
+}
+/**
+ * @test Tests that PhiloxEngine::fillNormal produces values with
+ * approximately zero mean and unit variance, including a remainder that is
+ * filled by the scalar fallback.
+ *
+ */
+TEST(PhiloxEngineTest, FillNormalMomentsTest) {
+  const double tolerance = 1e-2;
+  PhiloxEngine engine(13);
+  std::vector<double> values(200001);
+  engine.fillNormal(values);
+
+  double sum = 0.0;
+  double sum_squares = 0.0;
+  for (const double& value : values) {
+    sum += value;
+    sum_squares += value * value;
+  }
+  const double mean = sum / values.size();
+  const double variance = sum_squares / values.size() - mean * mean;
+
+  EXPECT_LE(std::abs(mean), tolerance)
+      << "PhiloxEngine::fillNormal mean not near zero.";
+  EXPECT_LE(std::abs(variance - 1.0), tolerance)
+      << "PhiloxEngine::fillNormal variance not near one.";
+}
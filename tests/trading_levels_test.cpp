@@ -1,14 +1,22 @@
+#include "stochastic_models/exceptions/errors.h"
 #include "stochastic_models/numeric_utils/helpers.h"
 #include "stochastic_models/numeric_utils/integration.h"
+#include "stochastic_models/numeric_utils/solvers.h"
 #include "stochastic_models/sde/ornstein_uhlenbeck.h"
 #include "stochastic_models/trading/exponential_mean_reversion.h"
 #include "stochastic_models/trading/optimal_mean_reversion.h"
 #include "stochastic_models/trading/trading_levels.h"
+#include "stochastic_models/trading/trading_levels_batch.h"
 #include "stochastic_models/trading/trading_levels_exponential.h"
 #include "stochastic_models/trading/trading_levels_params.h"
+#include "stochastic_models/trading/trading_levels_tracker.h"
 
+#include <cmath>
+#include <cstddef>
 #include <cstdlib>
 #include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
 /**
  * @test Tests the output of the TradingLevels::optimalExit method with a stop
  * loss provided and asserts that it is near the expected value.
@@ -31,7 +39,7 @@ TEST(TradingLevelsTest, exitLevelStopLossOutputTest) {
   const double value = tradingLevels.optimalExit(stop_loss, r, c);
 
   // Assert that the value is near the expected value.
-  EXPECT_LE(abs(roundToDecimals(value, 8) - 0.46912012), tolerance)
+  EXPECT_LE(abs(roundToDecimals(value, 8) - 0.45089478), tolerance)
       << "Value produced by OrnsteinUhlenbeckTradingLevels::optimalExit "
          "with a stop loss provided is not equal to the expected value.";
 }
@@ -114,7 +122,7 @@ TEST(TradingLevelsTest, entryLevelLowerBoundStopLossOutputTest) {
       tradingLevels.optimalEntryLower(d_star, b_star, stop_loss, r, c);
 
   // Assert that the value is near the expected value.
-  EXPECT_LE(abs(roundToDecimals(value, 8) - 0.118451), tolerance)
+  EXPECT_LE(abs(roundToDecimals(value, 8) - 0.118436), tolerance)
       << "Value produced by "
          "OrnsteinUhlenbeckTradingLevels::optimalEntryLower "
          "is not equal to the expected value when a stop loss is provided.";
@@ -142,7 +150,7 @@ TEST(TradingLevelsTest, entryLevelStopLossOutputTest) {
   const double value = tradingLevels.optimalEntry(b_star, stop_loss, r, c);
 
   // Assert that the value is near the expected value.
-  EXPECT_LE(abs(roundToDecimals(value, 8) - 0.136755), tolerance)
+  EXPECT_LE(abs(roundToDecimals(value, 8) - 0.136269), tolerance)
       << "Value produced by OrnsteinUhlenbeckTradingLevels::optimalEntry "
          "is not equal to the expected value when a stop loss is provided.";
 }
@@ -168,7 +176,7 @@ TEST(TradingLevelsTest, entryLevelOutputTest) {
   const double value = tradingLevels.optimalEntry(b_star, r, c);
 
   // Assert that the value is near the expected value.
-  EXPECT_LE(abs(roundToDecimals(value, 8) - 0.116948), tolerance)
+  EXPECT_LE(abs(roundToDecimals(value, 8) - 0.115681), tolerance)
       << "Value produced by OrnsteinUhlenbeckTradingLevels::optimalEntry "
          "is not equal to the expected value.";
 }
@@ -218,7 +226,7 @@ TEST(TradingLevelsTest, entryLevelExponentialOutputTest) {
   const double value = tradingLevels.optimalEntry(b_star, r, c);
 
   // Assert that the value is near the expected value.
-  EXPECT_LE(abs(roundToDecimals(value, 8) - 1.24096), tolerance)
+  EXPECT_LE(abs(roundToDecimals(value, 8) - 1.236887), tolerance)
       << "Value produced by "
          "OrnsteinUhlenbeckTradingLevelsExponential::optimalEntry "
          "with ExponentialMeanReversion optimizer is not equal to the "
@@ -235,7 +243,7 @@ TEST(TradingLevelsTest, entryLevelLowerExponentialOutputTest) {
   const double alpha = 5;
   const double mu = 1.3499;
   const double sigma = 0.15;
-  const double d_star = 1.24096;
+  const double d_star = 1.236887;
   const double b_star = 1.4093;
   const double c = 0.02;
   const double r = 0.05;
@@ -248,9 +256,322 @@ TEST(TradingLevelsTest, entryLevelLowerExponentialOutputTest) {
   const double value = tradingLevels.optimalEntryLower(d_star, b_star, r, c);
 
   // Assert that the value is near the expected value.
-  EXPECT_LE(abs(roundToDecimals(value, 8) - 1.16016), tolerance)
+  EXPECT_LE(abs(roundToDecimals(value, 8) - 1.160238), tolerance)
       << "Value produced by "
          "OrnsteinUhlenbeckTradingLevelsExponential::optimalEntryLower "
          "with ExponentialMeanReversion optimizer is not equal to the "
          "expected value.";
 }
+/**
+ * @test Tests that solveTradingLevelsBatch reproduces the levels of the
+ * individual solvers and records the failures of invalid or unsolvable sets
+ * without aborting the batch.
+ *
+ */
+TEST(TradingLevelsTest, batchOutputTest) {
+  const std::vector<double> mu = {0.3, 0.3, 0.5388, 0.3};
+  const std::vector<double> alpha = {8, 8, 16.6677, 8};
+  const std::vector<double> sigma = {0.3, 0.0, 0.1599, 0.3};
+  const std::vector<double> r = {0.05, 0.05, 0.05, 0.05};
+  const std::vector<double> c = {0.02, 0.02, 0.05, 10.0};
+  testing::internal::CaptureStdout();
+  const TradingLevelsBatchResult result = solveTradingLevelsBatch(
+      TradingLevelsBatchParams{mu, alpha, sigma, r, c, {}}
+  );
+  EXPECT_EQ(testing::internal::GetCapturedStdout(), "")
+      << "Failed sets must be reported by their status, not on stdout.";
+
+  for (const std::size_t i : {std::size_t{0}, std::size_t{2}}) {
+    const OrnsteinUhlenbeckTradingLevels levels(mu[i], alpha[i], sigma[i]);
+    const double b_star = levels.optimalExit(r[i], c[i]);
+    EXPECT_EQ(result.status[i], TradingLevelsStatus::Solved);
+    EXPECT_EQ(result.b_star[i], b_star);
+    EXPECT_EQ(result.d_star[i], levels.optimalEntry(b_star, r[i], c[i]));
+    EXPECT_TRUE(std::isnan(result.a_star[i]))
+        << "a* must be NaN without a stop loss.";
+  }
+  EXPECT_EQ(result.status[1], TradingLevelsStatus::InvalidArgument);
+  EXPECT_NE(result.status[3], TradingLevelsStatus::Solved);
+  EXPECT_TRUE(std::isnan(result.b_star[3]) && std::isnan(result.d_star[3]))
+      << "Levels of an unsolved set must be NaN.";
+}
+/**
+ * @test Tests that solveTradingLevelsBatch solves a* with a stop loss and
+ * rejects spans of different lengths.
+ *
+ */
+TEST(TradingLevelsTest, batchStopLossOutputTest) {
+  const std::size_t n = 64;
+  std::vector<double> mu(n, 0.3), alpha(n, 8), sigma(n), r(n, 0.05),
+      c(n, 0.02), stop_loss(n, 0.05);
+  for (std::size_t i{0}; i < n; ++i) {
+    sigma[i] = 0.2 + 0.2 * static_cast<double>(i) / n;
+  }
+  const TradingLevelsBatchResult result = solveTradingLevelsBatch(
+      TradingLevelsBatchParams{mu, alpha, sigma, r, c, stop_loss}
+  );
+
+  for (std::size_t i{0}; i < n; i += 9) {
+    const OrnsteinUhlenbeckTradingLevels levels(mu[i], alpha[i], sigma[i]);
+    const double b_star = levels.optimalExit(stop_loss[i], r[i], c[i]);
+    const double d_star = levels.optimalEntry(b_star, stop_loss[i], r[i], c[i]);
+    ASSERT_EQ(result.status[i], TradingLevelsStatus::Solved);
+    EXPECT_EQ(result.b_star[i], b_star);
+    EXPECT_EQ(result.d_star[i], d_star);
+    EXPECT_EQ(
+        result.a_star[i],
+        levels.optimalEntryLower(d_star, b_star, stop_loss[i], r[i], c[i])
+    );
+  }
+  EXPECT_THROW(
+      solveTradingLevelsBatch(TradingLevelsBatchParams{
+          mu, alpha, sigma, r, std::span<const double>(c).first(3), {}
+      }),
+      std::invalid_argument
+  );
+}
+/**
+ * @test Tests that solveTradingLevels finds the same levels as the separate
+ * optimalExit, optimalEntry and optimalEntryLower stages.
+ *
+ */
+TEST(TradingLevelsTest, solveTradingLevelsOutputTest) {
+  const double alpha = 8;
+  const double mu = 0.3;
+  const double sigma = 0.3;
+  const double stop_loss = 0.05;
+  const double r = 0.05;
+  const double c = 0.02;
+  const double tolerance = 1e-12;
+  const OrnsteinUhlenbeckTradingLevels staged(mu, alpha, sigma);
+  const OrnsteinUhlenbeckTradingLevels fused(mu, alpha, sigma);
+
+  const TradingLevelsSolution levels =
+      fused.solveTradingLevels(stop_loss, r, c);
+  const double b_star = staged.optimalExit(stop_loss, r, c);
+  const double d_star = staged.optimalEntry(b_star, stop_loss, r, c);
+  EXPECT_LE(abs(levels.b_star - b_star), tolerance);
+  EXPECT_LE(abs(levels.d_star - d_star), tolerance);
+  EXPECT_LE(
+      abs(levels.a_star -
+          staged.optimalEntryLower(d_star, b_star, stop_loss, r, c)),
+      tolerance
+  ) << "solveTradingLevels disagrees with the separate stages with a stop "
+       "loss.";
+
+  const TradingLevelsSolution no_stop_loss = fused.solveTradingLevels(r, c);
+  const double b_star_no_stop_loss = staged.optimalExit(r, c);
+  EXPECT_LE(abs(no_stop_loss.b_star - b_star_no_stop_loss), tolerance);
+  EXPECT_LE(
+      abs(no_stop_loss.d_star -
+          staged.optimalEntry(b_star_no_stop_loss, r, c)),
+      tolerance
+  ) << "solveTradingLevels disagrees with the separate stages without a stop "
+       "loss.";
+  EXPECT_TRUE(std::isnan(no_stop_loss.a_star));
+}
+/**
+ * @test Tests that solveTradingLevels of the exponential model chains its
+ * separate stages.
+ *
+ */
+TEST(TradingLevelsTest, solveTradingLevelsExponentialOutputTest) {
+  const double alpha = 5;
+  const double mu = 1.3499;
+  const double sigma = 0.15;
+  const double r = 0.05;
+  const double c = 0.02;
+  const OrnsteinUhlenbeckTradingLevelsExponential tradingLevels(
+      mu, alpha, sigma
+  );
+
+  const TradingLevelsSolution levels = tradingLevels.solveTradingLevels(r, c);
+  const double b_star = tradingLevels.optimalExit(r, c);
+  const double d_star = tradingLevels.optimalEntry(b_star, r, c);
+  EXPECT_EQ(levels.b_star, b_star);
+  EXPECT_EQ(levels.d_star, d_star);
+  EXPECT_EQ(
+      levels.a_star, tradingLevels.optimalEntryLower(d_star, b_star, r, c)
+  );
+  EXPECT_TRUE(std::isfinite(levels.a_star))
+      << "The bounded exponential entry region has no lower level.";
+}
+/**
+ * @test Tests that the tracker warm-starts the levels as the parameters drift
+ * and agrees with a full solve to the tolerance of the solvers.
+ *
+ */
+TEST(TradingLevelsTest, trackerOutputTest) {
+  const double stop_loss = 0.05;
+  const double r = 0.05;
+  const double c = 0.02;
+  const double tolerance = 1e-4;
+  OrnsteinUhlenbeckTradingLevelsTracker tracker(stop_loss, r, c);
+  EXPECT_FALSE(tracker.hasLevels());
+
+  for (std::size_t i{0}; i < 20; ++i) {
+    const double mu = 0.3 + 0.001 * i;
+    const double alpha = 8.0 - 0.02 * i;
+    const double sigma = 0.3 + 0.0005 * i;
+    const TradingLevelsSolution tracked = tracker.update(mu, alpha, sigma);
+    const TradingLevelsSolution expected =
+        OrnsteinUhlenbeckTradingLevels(mu, alpha, sigma)
+            .solveTradingLevels(stop_loss, r, c);
+    EXPECT_LE(abs(tracked.b_star - expected.b_star), tolerance);
+    EXPECT_LE(abs(tracked.d_star - expected.d_star), tolerance);
+    EXPECT_LE(abs(tracked.a_star - expected.a_star), tolerance);
+  }
+  EXPECT_EQ(tracker.fullSolves(), 1U);
+  EXPECT_EQ(tracker.warmStarts(), 19U);
+
+  // A jump moving the levels by more than the bracket falls back to a full
+  // solve.
+  tracker.setBracketWidth(0.01);
+  const TradingLevelsSolution jumped = tracker.update(0.3, 2.0, 0.3);
+  EXPECT_EQ(tracker.fullSolves(), 2U);
+  EXPECT_EQ(
+      jumped.b_star,
+      OrnsteinUhlenbeckTradingLevels(0.3, 2.0, 0.3)
+          .solveTradingLevels(stop_loss, r, c)
+          .b_star
+  );
+  EXPECT_THROW(tracker.setBracketWidth(0.0), std::invalid_argument);
+}
+/**
+ * @test Tests the tracker without a stop loss.
+ *
+ */
+TEST(TradingLevelsTest, trackerNoStopLossOutputTest) {
+  const double r = 0.05;
+  const double c = 0.02;
+  const double tolerance = 1e-4;
+  OrnsteinUhlenbeckTradingLevelsTracker tracker(r, c);
+
+  for (std::size_t i{0}; i < 10; ++i) {
+    const double mu = 0.3 - 0.001 * i;
+    const TradingLevelsSolution tracked = tracker.update(mu, 8.0, 0.3);
+    const TradingLevelsSolution expected =
+        OrnsteinUhlenbeckTradingLevels(mu, 8.0, 0.3).solveTradingLevels(r, c);
+    EXPECT_LE(abs(tracked.b_star - expected.b_star), tolerance);
+    EXPECT_LE(abs(tracked.d_star - expected.d_star), tolerance);
+    EXPECT_TRUE(std::isnan(tracked.a_star));
+  }
+  EXPECT_EQ(tracker.fullSolves(), 1U);
+
+  tracker.reset();
+  tracker.update(0.3, 8.0, 0.3);
+  EXPECT_EQ(tracker.fullSolves(), 2U);
+}
+/**
+ * @test Tests that the closed-form solver brackets hold the levels solved
+ * over the full bounds and are a fraction of their width.
+ *
+ */
+TEST(TradingLevelsTest, solverBracketOutputTest) {
+  const double alpha = 8;
+  const double mu = 0.3;
+  const double sigma = 0.3;
+  const double stop_loss = 0.05;
+  const double r = 0.05;
+  const double c = 0.02;
+  const double tolerance = 1e-6;
+  const double deviation = sigma / std::sqrt(2 * alpha);
+  const OrnsteinUhlenbeckTradingLevels tradingLevels(mu, alpha, sigma);
+  const OptimalMeanReversion* optimizer = tradingLevels.getOptimizer();
+  const HittingTimeOrnsteinUhlenbeck* kernel =
+      tradingLevels.getHittingTimeKernel();
+  SolverOptions options;
+  options.epsabs = 1e-10;
+  options.epsrel = 0.0;
+
+  const double b_star =
+      solve(
+          [&](const double x) {
+            return optimizer->b(x, kernel, stop_loss, r, c);
+          },
+          tradingLevels.optimalExitLowerBound(r, c),
+          tradingLevels.optimalExitUpperBound(),
+          options
+      )
+          .root;
+  const RootBracket exit = tradingLevels.optimalExitBracket(stop_loss, r, c);
+  EXPECT_LE(exit.lower, b_star + tolerance);
+  EXPECT_GE(exit.upper, b_star - tolerance);
+  EXPECT_LE(exit.upper - exit.lower, deviation);
+
+  const double d_star =
+      solve(
+          [&](const double x) {
+            return optimizer->d(x, kernel, b_star, stop_loss, r, c);
+          },
+          stop_loss,
+          b_star,
+          options
+      )
+          .root;
+  const RootBracket entry =
+      tradingLevels.optimalEntryBracket(b_star, stop_loss, r, c);
+  EXPECT_LE(entry.lower, d_star + tolerance);
+  EXPECT_GE(entry.upper, d_star - tolerance);
+  EXPECT_LE(entry.upper - entry.lower, deviation);
+
+  const double a_star =
+      solve(
+          [&](const double x) {
+            return optimizer->a(x, kernel, b_star, stop_loss, r, c);
+          },
+          stop_loss,
+          d_star,
+          options
+      )
+          .root;
+  const RootBracket entry_lower =
+      tradingLevels.optimalEntryLowerBracket(d_star, b_star, stop_loss, r, c);
+  EXPECT_LE(entry_lower.lower, a_star + tolerance);
+  EXPECT_GE(entry_lower.upper, a_star - tolerance);
+  EXPECT_LE(entry_lower.upper - entry_lower.lower, deviation);
+
+  const RootBracket exit_no_stop_loss = tradingLevels.optimalExitBracket(r, c);
+  const double b_star_no_stop_loss = tradingLevels.optimalExit(r, c);
+  EXPECT_LE(exit_no_stop_loss.lower, b_star_no_stop_loss);
+  EXPECT_GE(exit_no_stop_loss.upper, b_star_no_stop_loss);
+  const RootBracket entry_no_stop_loss =
+      tradingLevels.optimalEntryBracket(b_star_no_stop_loss, r, c);
+  const double d_star_no_stop_loss =
+      tradingLevels.optimalEntry(b_star_no_stop_loss, r, c);
+  EXPECT_LE(entry_no_stop_loss.lower, d_star_no_stop_loss);
+  EXPECT_GE(entry_no_stop_loss.upper, d_star_no_stop_loss);
+}
+/**
+ * @test Tests that a level whose root function does not change sign within
+ * its bounds throws instead of being solved over an invalid bracket.
+ *
+ */
+TEST(TradingLevelsTest, solverBracketErrorTest) {
+  // With a cost above the upper solver bound the bounds are inverted.
+  const OrnsteinUhlenbeckTradingLevels tradingLevels(0.3, 8.0, 0.3);
+  EXPECT_THROW(
+      tradingLevels.optimalExitBracket(0.05, 10.0), std::invalid_argument
+  );
+
+  // The root function of b* keeps its sign over the exit level bounds of this
+  // slowly reverting spread.
+  const OrnsteinUhlenbeckTradingLevels spread(0.998, 0.0045, 0.0038);
+  EXPECT_THROW(spread.optimalExitBracket(0.99, 0.001, 0.0001), NoSolutionError);
+  EXPECT_THROW(
+      spread.solveTradingLevels(0.99, 0.001, 0.0001), NoSolutionError
+  );
+
+  // The entry region of this stop loss has no lower entry level a*.
+  const double mu = 1.0;
+  const double stop_loss = 0.7;
+  const double r = 0.1;
+  const double c = 0.01;
+  const OrnsteinUhlenbeckTradingLevels wide(mu, 0.5, 0.2);
+  const double b_star = wide.optimalExit(stop_loss, r, c);
+  const double d_star = wide.optimalEntry(b_star, stop_loss, r, c);
+  EXPECT_THROW(
+      wide.optimalEntryLower(d_star, b_star, stop_loss, r, c), NoSolutionError
+  );
+  EXPECT_THROW(wide.solveTradingLevels(stop_loss, r, c), NoSolutionError);
+}
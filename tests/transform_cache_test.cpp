@@ -0,0 +1,152 @@
+#include "stochastic_models/hitting_times/hitting_time_ornstein_uhlenbeck.h"
+#include "stochastic_models/trading/optimal_mean_reversion.h"
+#include "stochastic_models/trading/trading_levels.h"
+#include "stochastic_models/trading/transform_cache.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+/**
+ * @test Tests the hit and miss counters, least recently used eviction and
+ * quantized keys of TransformCache.
+ *
+ */
+TEST(TransformCacheTest, EvictionTest) {
+  const TransformQuadrature adaptive = TransformQuadrature::Adaptive;
+  TransformCache cache(2);
+  OptimalTradingTransforms transforms{};
+  cache.insert({1.0, 2.0, 0.1, adaptive}, {1.0, 1.0, 1.0, 1.0});
+  cache.insert({1.0, 2.0, 0.2, adaptive}, {2.0, 2.0, 2.0, 2.0});
+  EXPECT_TRUE(cache.find({1.0, 2.0, 0.1, adaptive}, transforms));
+  EXPECT_EQ(transforms.F, 1.0);
+  // The entry at 0.2 is now the least recently used and is evicted.
+  cache.insert({1.0, 2.0, 0.3, adaptive}, {3.0, 3.0, 3.0, 3.0});
+  EXPECT_FALSE(cache.find({1.0, 2.0, 0.2, adaptive}, transforms));
+  EXPECT_TRUE(cache.find({1.0, 2.0, 0.3, adaptive}, transforms));
+  EXPECT_FALSE(cache.find({1.5, 2.0, 0.3, adaptive}, transforms))
+      << "Keys with different exponents share an entry.";
+  EXPECT_FALSE(
+      cache.find({1.0, 2.0, 0.3, TransformQuadrature::FixedOrder}, transforms)
+  ) << "Keys with different quadratures share an entry.";
+  EXPECT_EQ(cache.hits(), 2U);
+  EXPECT_EQ(cache.misses(), 3U);
+  EXPECT_EQ(cache.size(), 2U);
+
+  TransformCache quantized(4, 0.01);
+  quantized.insert({1.0, 2.0, 0.1001, adaptive}, {4.0, 4.0, 4.0, 4.0});
+  EXPECT_TRUE(quantized.find({1.0, 2.0, 0.0999, adaptive}, transforms))
+      << "Drifts within the quantum do not share an entry.";
+  // The entry holds the transforms at the drift 0.1 of the cell, which are
+  // extrapolated by -0.0001 / 2 in x.
+  EXPECT_LE(std::abs(transforms.F - (4.0 - 4.0 * 0.00005)), 1e-12)
+      << "Quantized entries not extrapolated from the cell's drift.";
+  EXPECT_FALSE(quantized.find({1.0, 2.0, 0.12, adaptive}, transforms));
+
+  TransformCache disabled(0);
+  disabled.insert({1.0, 2.0, 0.1, adaptive}, {1.0, 1.0, 1.0, 1.0});
+  EXPECT_FALSE(disabled.find({1.0, 2.0, 0.1, adaptive}, transforms));
+  EXPECT_EQ(disabled.size(), 0U);
+  cache.clear();
+  EXPECT_EQ(cache.hits() + cache.misses() + cache.size(), 0U);
+  EXPECT_THROW(TransformCache(2, -1.0), std::invalid_argument);
+}
+/**
+ * @test Tests that caching leaves the root functions unchanged, that copies
+ * of an optimizer share its cache and that the fixed levels of the entry
+ * level solve are answered from it.
+ *
+ */
+TEST(TransformCacheTest, OptimizerTest) {
+  const double alpha = 8;
+  const double mu = 0.3;
+  const double sigma = 0.3;
+  const double b_star = 0.466836;
+  const double stop_loss = 0.0;
+  const double r = 0.05;
+  const double c = 0.02;
+  const HittingTimeOrnsteinUhlenbeck hitting_time_kernel(mu, alpha, sigma);
+  const OptimalMeanReversion cached;
+  OptimalMeanReversion uncached;
+  uncached.setTransformCache(nullptr);
+
+  for (const double x : {0.1, 0.2, 0.1}) {
+    EXPECT_EQ(
+        cached.d(x, &hitting_time_kernel, b_star, stop_loss, r, c),
+        uncached.d(x, &hitting_time_kernel, b_star, stop_loss, r, c)
+    ) << "Caching changed the value of d.";
+  }
+  EXPECT_EQ(uncached.getTransformCache(), nullptr);
+  // Every call looks up x, the stop loss and b*, of which only the first
+  // three lookups and x = 0.2 miss.
+  EXPECT_EQ(cached.getTransformCache()->misses(), 4U);
+  EXPECT_EQ(cached.getTransformCache()->hits(), 5U);
+
+  const std::unique_ptr<const OptimalMeanReversion> copy(cached.clone());
+  EXPECT_EQ(copy->getTransformCache(), cached.getTransformCache())
+      << "A copied optimizer does not share the cache.";
+
+  const OrnsteinUhlenbeckTradingLevels levels(mu, alpha, sigma);
+  levels.optimalEntry(b_star, r, c);
+  const TransformCache* cache = levels.getOptimizer()->getTransformCache();
+  // Every evaluation of d looks up its point and b*, and only the first
+  // lookup of b* misses.
+  EXPECT_GT(cache->hits(), 0U);
+  EXPECT_GE(cache->hits() + 1, cache->misses())
+      << "The entry level solve did not reuse F(b*).";
+}
+/**
+ * @test Tests that optimizers with different quadratures sharing a cache get
+ * their own transforms, and that a quantized cache answers points of a cell
+ * from the cell's drift whatever point was evaluated first.
+ *
+ */
+TEST(TransformCacheTest, SharedCacheTest) {
+  const double alpha = 8;
+  const double mu = 0.3;
+  const double sigma = 0.3;
+  const double r = 0.05;
+  const double x = 0.2;
+  const HittingTimeOrnsteinUhlenbeck hitting_time_kernel(mu, alpha, sigma);
+  const auto shared = std::make_shared<TransformCache>();
+  OptimalMeanReversion adaptive(TransformQuadrature::Adaptive);
+  OptimalMeanReversion fixed_order(TransformQuadrature::FixedOrder);
+  adaptive.setTransformCache(shared);
+  fixed_order.setTransformCache(shared);
+  OptimalMeanReversion uncached(TransformQuadrature::FixedOrder);
+  uncached.setTransformCache(nullptr);
+
+  adaptive.transforms(&hitting_time_kernel, x, r);
+  EXPECT_EQ(
+      fixed_order.transforms(&hitting_time_kernel, x, r).F,
+      uncached.transforms(&hitting_time_kernel, x, r).F
+  ) << "A shared cache answered one quadrature with another's transforms.";
+
+  // Both points lie in the cell of drift 0.7 of a quantum of 0.1.
+  const double scale = hitting_time_kernel.optimalTradingScale();
+  const double first = mu + 0.68 / scale;
+  const double second = mu + 0.73 / scale;
+  OptimalMeanReversion forward;
+  OptimalMeanReversion backward;
+  forward.setTransformCache(std::make_shared<TransformCache>(16, 0.1));
+  backward.setTransformCache(std::make_shared<TransformCache>(16, 0.1));
+  forward.transforms(&hitting_time_kernel, first, r);
+  const OptimalTradingTransforms forward_second =
+      forward.transforms(&hitting_time_kernel, second, r);
+  const OptimalTradingTransforms backward_second =
+      backward.transforms(&hitting_time_kernel, second, r);
+  EXPECT_EQ(forward_second.F, backward_second.F)
+      << "A quantized entry depends on the first point of its cell.";
+  EXPECT_EQ(forward.getTransformCache()->size(), 1U);
+
+  // F increases in x, so its largest second derivative over the cell is at
+  // the cell's upper end.
+  const OptimalTradingTransforms exact =
+      uncached.transforms(&hitting_time_kernel, second, r);
+  const double bound =
+      uncached.F(&hitting_time_kernel, mu + 0.75 / scale, r + 2 * alpha, 0.0) *
+      0.1 * 0.1 / 8;
+  EXPECT_LE(std::abs(forward_second.F - exact.F), bound)
+      << "A quantized entry exceeding the documented error bound.";
+}
@@ -0,0 +1,163 @@
+#include "stochastic_models/exceptions/errors.h"
+#include "stochastic_models/hitting_times/hitting_time_ornstein_uhlenbeck.h"
+#include "stochastic_models/numeric_utils/helpers.h"
+#include "stochastic_models/sde/ornstein_uhlenbeck.h"
+#include "stochastic_models/trading/adapters.h"
+#include "stochastic_models/trading/optimal_mean_reversion.h"
+#include "stochastic_models/trading/transform_table.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+/**
+ * @test Tests that a table over the solver bounds reproduces F, F', G and G'
+ * of the quadrature to its tolerance between its nodes.
+ *
+ */
+TEST(TransformTableTest, AccuracyTest) {
+  const double alpha = 8;
+  const double mu = 0.3;
+  const double sigma = 0.3;
+  const double r = 0.05;
+  const OrnsteinUhlenbeckModel model(mu, alpha, sigma);
+  const HittingTimeOrnsteinUhlenbeck hitting_time_kernel(mu, alpha, sigma);
+  const double lower = lowerSolverBound(&model);
+  const double upper = upperSolverBound(&model);
+  const TransformTable table(&hitting_time_kernel, r, lower, upper, 1e-10);
+  OptimalMeanReversion mean_reversion;
+  mean_reversion.setTransformCache(nullptr);
+
+  for (int i{0}; i <= 100; ++i) {
+    const double x = lower + (upper - lower) * (i + 0.37) / 101.0;
+    const double drift = hitting_time_kernel.optimalTradingDrift(x);
+    ASSERT_TRUE(table.covers(r / alpha, drift));
+    const OptimalTradingTransforms exact =
+        mean_reversion.transforms(&hitting_time_kernel, x, r);
+    const OptimalTradingTransforms tabulated = table.transforms(
+        hitting_time_kernel.optimalTradingScale(), drift
+    );
+    EXPECT_LE(abs(tabulated.F / exact.F - 1.0), 1e-9);
+    EXPECT_LE(abs(tabulated.F_prime / exact.F_prime - 1.0), 1e-9);
+    EXPECT_LE(abs(tabulated.G / exact.G - 1.0), 1e-9);
+    EXPECT_LE(abs(tabulated.G_prime / exact.G_prime - 1.0), 1e-9)
+        << "Tabulated transforms disagree with the quadrature at x = " << x
+        << ".";
+  }
+  EXPECT_FALSE(
+      table.covers(r / alpha, table.getPanels().back().drift_upper + 0.1)
+  );
+  EXPECT_FALSE(table.covers(0.1 / alpha, 0.0));
+  EXPECT_THROW(
+      TransformTable(&hitting_time_kernel, r, upper, lower),
+      std::invalid_argument
+  );
+}
+/**
+ * @test Tests that an optimizer answering from a table finds the same trading
+ * level roots and falls back to the quadrature outside the table.
+ *
+ */
+TEST(TransformTableTest, OptimizerTest) {
+  const double alpha = 8;
+  const double mu = 0.3;
+  const double sigma = 0.3;
+  const double r = 0.05;
+  const double c = 0.02;
+  const double b_star = 0.466836;
+  const double stop_loss = 0.0;
+  const OrnsteinUhlenbeckModel model(mu, alpha, sigma);
+  const HittingTimeOrnsteinUhlenbeck hitting_time_kernel(mu, alpha, sigma);
+  const OptimalMeanReversion integrated;
+  OptimalMeanReversion tabulated;
+  tabulated.setTransformTable(std::make_shared<const TransformTable>(
+      &hitting_time_kernel,
+      r,
+      lowerSolverBound(&model),
+      upperSolverBound(&model)
+  ));
+
+  for (const double x : {0.1, 0.2, 0.4}) {
+    const double expected =
+        integrated.d(x, &hitting_time_kernel, b_star, stop_loss, r, c);
+    EXPECT_LE(
+        abs(tabulated.d(x, &hitting_time_kernel, b_star, stop_loss, r, c) -
+            expected),
+        1e-8 * abs(expected)
+    ) << "Tabulated d disagrees with the quadrature at x = " << x << ".";
+  }
+  // A different discount rate is not covered and is integrated.
+  EXPECT_EQ(
+      tabulated.F(&hitting_time_kernel, 0.2, 0.1, c),
+      integrated.F(&hitting_time_kernel, 0.2, 0.1, c)
+  );
+}
+/**
+ * @test Tests that a table survives a round trip through the JSON adapter and
+ * that malformed JSON is reported.
+ *
+ */
+TEST(TransformTableTest, SerializationTest) {
+  const HittingTimeOrnsteinUhlenbeck hitting_time_kernel(0.3, 8, 0.3);
+  const TransformTable table(&hitting_time_kernel, 0.05, 0.0, 0.6);
+  TransformTableJsonAdapter adapter;
+
+  const TransformTable restored = adapter.deserialize(adapter.serialize(table));
+  EXPECT_EQ(restored.getExponent(), table.getExponent());
+  ASSERT_EQ(restored.getPanels().size(), table.getPanels().size());
+  for (std::size_t i{0}; i < table.getPanels().size(); ++i) {
+    const TransformTablePanel& panel = table.getPanels()[i];
+    EXPECT_EQ(restored.getPanels()[i].drift_lower, panel.drift_lower);
+    EXPECT_EQ(restored.getPanels()[i].log_f, panel.log_f);
+    EXPECT_EQ(restored.getPanels()[i].log_g, panel.log_g);
+    EXPECT_EQ(restored.getPanels()[i].log_g_prime, panel.log_g_prime);
+  }
+  const double scale = hitting_time_kernel.optimalTradingScale();
+  const double drift = hitting_time_kernel.optimalTradingDrift(0.25);
+  EXPECT_EQ(
+      restored.transforms(scale, drift).G_prime,
+      table.transforms(scale, drift).G_prime
+  ) << "The restored table interpolates differently.";
+
+  EXPECT_THROW(
+      adapter.deserialize("{\"exponent\": 1.0}"), TransformTableParseError
+  );
+  EXPECT_THROW(adapter.deserialize("not json"), TransformTableParseError);
+
+  // Replace the exponent or tolerance of the serialized table.
+  const std::string state = adapter.serialize(table);
+  auto withField = [&](const std::string& field, const std::string& value) {
+    const std::string name = "\"" + field + "\":";
+    const std::size_t begin = state.find(name) + name.size();
+    const std::size_t end = state.find_first_of(",}", begin);
+    return state.substr(0, begin) + value + state.substr(end);
+  };
+  for (const std::string value : {"0.0", "-1.0"}) {
+    EXPECT_THROW(
+        adapter.deserialize(withField("exponent", value)),
+        std::invalid_argument
+    ) << "deserialize accepted the exponent " << value << ".";
+    EXPECT_THROW(
+        adapter.deserialize(withField("tolerance", value)),
+        std::invalid_argument
+    ) << "deserialize accepted the tolerance " << value << ".";
+  }
+  // JSON cannot hold non-finite numbers, so restore from the panels directly.
+  const double infinity = std::numeric_limits<double>::infinity();
+  EXPECT_THROW(
+      TransformTable(infinity, table.getTolerance(), table.getPanels()),
+      std::invalid_argument
+  );
+  EXPECT_THROW(
+      TransformTable(
+          table.getExponent(),
+          std::numeric_limits<double>::quiet_NaN(),
+          table.getPanels()
+      ),
+      std::invalid_argument
+  );
+}
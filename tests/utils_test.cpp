@@ -3,16 +3,26 @@
  * @brief Unit tests for the numeric_utils module.
  *
  */
+#include "stochastic_models/exceptions/errors.h"
 #include "stochastic_models/hitting_times/hitting_time_density.h"
 #include "stochastic_models/numeric_utils/differentiation.h"
 #include "stochastic_models/numeric_utils/helpers.h"
 #include "stochastic_models/numeric_utils/integration.h"
+#include "stochastic_models/numeric_utils/integration_batch.h"
+#include "stochastic_models/numeric_utils/parallel.h"
 #include "stochastic_models/numeric_utils/solvers.h"
 #include "stochastic_models/sde/ornstein_uhlenbeck.h"
 #include "stochastic_models/trading/optimal_mean_reversion.h"
 
+#include <atomic>
 #include <cmath>
+#include <cstddef>
 #include <gtest/gtest.h>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 /**
  * @brief Test that the check_function_status function executes without throwing
@@ -148,6 +158,86 @@ TEST(SemiInfiniteIntegrationFunctionTest, OutputTest) {
       << "Value produced by semiInfiniteIntegrationUpper is not equal to "
          "the expected value.";
 }
+/**
+ * @brief Test that repeated integrations with one pool reuse a single
+ * workspace and give identical results.
+ *
+ */
+TEST(IntegrationWorkspacePoolTest, ReuseTest) {
+  HittingTimeOrnsteinUhlenbeck hitting_time_kernel(0.996, 5.1, 1.1);
+  ModelFunc fn = &integrateHittingTimeDensity;
+  IntegrationWorkspacePool pool;
+  double lower = 0.8;
+  double upper = 1.05;
+
+  const double first =
+      adaptiveIntegration(fn, &hitting_time_kernel, lower, upper, pool);
+  for (int i{0}; i < 10; ++i) {
+    EXPECT_EQ(
+        adaptiveIntegration(fn, &hitting_time_kernel, lower, upper, pool),
+        first
+    ) << "Reusing a workspace changed the integral.";
+  }
+  EXPECT_EQ(pool.allocated(), 1U)
+      << "Repeated integrations allocated more than one workspace.";
+}
+/**
+ * @brief Test that nested leases receive distinct workspaces and that
+ * released workspaces are reused.
+ *
+ */
+TEST(IntegrationWorkspacePoolTest, NestedLeaseTest) {
+  IntegrationWorkspacePool pool;
+  {
+    const IntegrationWorkspacePool::Lease outer = pool.acquire();
+    const IntegrationWorkspacePool::Lease inner = pool.acquire();
+    EXPECT_NE(outer.get(), inner.get())
+        << "Nested leases share a workspace.";
+  }
+  {
+    const IntegrationWorkspacePool::Lease outer = pool.acquire();
+    const IntegrationWorkspacePool::Lease inner = pool.acquire();
+  }
+  EXPECT_EQ(pool.allocated(), 2U)
+      << "Released workspaces were not reused.";
+}
+/**
+ * @brief Test that concurrent integrations on several threads use their own
+ * pools and agree with the serial result.
+ *
+ */
+TEST(IntegrationWorkspacePoolTest, ThreadLocalTest) {
+  HittingTimeOrnsteinUhlenbeck hitting_time_kernel(0.996, 5.1, 1.1);
+  ModelFunc fn = &integrateHittingTimeDensity;
+  double lower = 0.8;
+  double upper = 1.05;
+  const double expected =
+      adaptiveIntegration(fn, &hitting_time_kernel, lower, upper);
+
+  std::vector<double> values(4);
+  std::vector<IntegrationWorkspacePool*> pools(4);
+  {
+    std::vector<std::jthread> threads;
+    for (std::size_t i{0}; i < values.size(); ++i) {
+      threads.emplace_back([&, i]() {
+        double thread_lower = 0.8;
+        double thread_upper = 1.05;
+        for (int j{0}; j < 50; ++j) {
+          values[i] = adaptiveIntegration(
+              fn, &hitting_time_kernel, thread_lower, thread_upper
+          );
+        }
+        pools[i] = &threadIntegrationWorkspacePool();
+      });
+    }
+  }
+  for (std::size_t i{0}; i < values.size(); ++i) {
+    EXPECT_EQ(values[i], expected)
+        << "Concurrent integration disagrees with the serial result.";
+    EXPECT_NE(pools[i], &threadIntegrationWorkspacePool())
+        << "A worker thread shares the main thread's pool.";
+  }
+}
 /**
  * @brief Test that the adaptiveCentralDifferentiation function produces the
  * correct output.
@@ -195,6 +285,369 @@ TEST(BrentSolverFunctionTest, OutputTest) {
       << "Value produced by brentSolver is not equal to "
          "the expected value.";
 }
+/**
+ * @brief Test that a failed brentSolver iteration is reported as an
+ * exception rather than ignored or aborting the process.
+ *
+ */
+TEST(BrentSolverFunctionTest, NonFiniteIterateTest) {
+  double upper = 5;
+  double lower = 0;
+  ModelFunc fn = [](double x, void*) -> double {
+    return (x > 0.5 && x < 4.5) ? std::nan("") : x - 2.5;
+  };
+
+  EXPECT_THROW(brentSolver(fn, nullptr, lower, upper), NoSolutionError);
+}
+/**
+ * @brief Test that brentSolver honours the given tolerance and reports a
+ * root not found within the iteration budget as an exception.
+ *
+ */
+TEST(BrentSolverFunctionTest, OptionsTest) {
+  QuadraticParams params{1.0, 0.0, -5.0};
+  ModelFunc fn = [](double x, void* params) -> double {
+    return quadratic(x, params);
+  };
+
+  SolverOptions options;
+  options.epsabs = 1e-12;
+  options.epsrel = 0.0;
+  double lower = 0;
+  double upper = 5;
+  const double value = brentSolver(fn, &params, lower, upper, options);
+  EXPECT_NEAR(value, std::sqrt(5.0), 1e-12)
+      << "Value produced by brentSolver does not meet the given tolerance.";
+  EXPECT_LE(upper - lower, 1e-12)
+      << "brentSolver does not return the final bracket.";
+
+  options.max_iterations = 1;
+  lower = 0;
+  upper = 5;
+  EXPECT_THROW(
+      brentSolver(fn, &params, lower, upper, options), NoSolutionError
+  );
+}
+/**
+ * @brief Test that brentSolver can run concurrently from several threads now
+ * that the GSL error handler is no longer swapped around each call.
+ *
+ */
+TEST(BrentSolverFunctionTest, ConcurrentTest) {
+  QuadraticParams params{1.0, 0.0, -5.0};
+  ModelFunc fn = [](double x, void* params) -> double {
+    return quadratic(x, params);
+  };
+  double serial_lower = 0;
+  double serial_upper = 5;
+  const double expected =
+      brentSolver(fn, &params, serial_lower, serial_upper);
+
+  std::vector<double> values(4);
+  {
+    std::vector<std::jthread> threads;
+    for (std::size_t i{0}; i < values.size(); ++i) {
+      threads.emplace_back([&, i]() {
+        for (int j{0}; j < 100; ++j) {
+          double lower = 0;
+          double upper = 5;
+          values[i] = brentSolver(fn, &params, lower, upper);
+        }
+      });
+    }
+  }
+  for (const double& value : values) {
+    EXPECT_EQ(value, expected)
+        << "Concurrent brentSolver disagrees with the serial result.";
+  }
+}
+// Cubic x^3 - 2x - 5 and its derivative used by the solveRoot tests.
+void cubicFdf(double x, void*, double* f, double* df) {
+  *f = (x * x - 2.0) * x - 5.0;
+  *df = 3.0 * x * x - 2.0;
+}
+/**
+ * @brief Test that every solveRoot method finds the root of a cubic to the
+ * requested tolerance and that Newton needs fewer iterations than bisection.
+ *
+ */
+TEST(SolveRootFunctionTest, MethodsTest) {
+  const double expected = 2.0945514815423265;
+  SolverOptions options;
+  options.epsabs = 1e-12;
+  options.epsrel = 0.0;
+  int bisection_iterations{0}, newton_iterations{0};
+  for (const RootMethod method :
+       {RootMethod::Brent,
+        RootMethod::Bisection,
+        RootMethod::Newton,
+        RootMethod::Steffenson}) {
+    options.method = method;
+    const SolverResult result = solveRoot(cubicFdf, nullptr, 0.0, 5.0, options);
+    EXPECT_TRUE(result.converged) << "solveRoot did not converge.";
+    EXPECT_LE(abs(result.root - expected), 1e-10)
+        << "Root produced by solveRoot is not equal to the expected value.";
+    EXPECT_LE(result.lower, result.upper);
+    if (method == RootMethod::Bisection) {
+      bisection_iterations = result.iterations;
+    } else if (method == RootMethod::Newton) {
+      newton_iterations = result.iterations;
+    }
+  }
+  EXPECT_LT(newton_iterations, bisection_iterations)
+      << "Newton needed more iterations than bisection.";
+
+  ModelFunc fn = [](double x, void*) -> double {
+    return (x * x - 2.0) * x - 5.0;
+  };
+  options.method = RootMethod::Brent;
+  EXPECT_LE(
+      abs(solveRoot(fn, nullptr, 0.0, 5.0, options).root - expected), 1e-10
+  ) << "Root produced by solveRoot is not equal to the expected value.";
+}
+/**
+ * @brief Test that solveRoot honours the iteration budget and tolerance.
+ *
+ */
+TEST(SolveRootFunctionTest, ToleranceTest) {
+  SolverOptions options;
+  options.method = RootMethod::Bisection;
+  options.max_iterations = 3;
+  const SolverResult capped = solveRoot(cubicFdf, nullptr, 0.0, 5.0, options);
+  EXPECT_EQ(capped.iterations, 3);
+  EXPECT_FALSE(capped.converged) << "Three bisections met the tolerance.";
+
+  options.max_iterations = 100;
+  options.epsabs = 1e-2;
+  options.epsrel = 0.0;
+  const SolverResult loose = solveRoot(cubicFdf, nullptr, 0.0, 5.0, options);
+  EXPECT_TRUE(loose.converged);
+  EXPECT_LE(loose.upper - loose.lower, 1e-2)
+      << "Final bracket is wider than the tolerance.";
+}
+/**
+ * @brief Test that Newton steps leaving the bracket fall back to bisection
+ * on a function whose derivative vanishes inside the bracket.
+ *
+ */
+TEST(SolveRootFunctionTest, SafeguardTest) {
+  // atan(x - 1) sends plain Newton from x = 3 off to infinity.
+  auto fdf = [](double x, void*, double* f, double* df) {
+    *f = std::atan(x - 1.0);
+    *df = 1.0 / (1.0 + (x - 1.0) * (x - 1.0));
+  };
+  SolverOptions options;
+  options.epsabs = 1e-12;
+  options.epsrel = 0.0;
+  for (const RootMethod method : {RootMethod::Newton, RootMethod::Steffenson}) {
+    options.method = method;
+    const SolverResult result = solveRoot(fdf, nullptr, -1.0, 7.0, options);
+    EXPECT_TRUE(result.converged);
+    EXPECT_LE(abs(result.root - 1.0), 1e-10)
+        << "Safeguarded Newton did not find the root.";
+  }
+}
+/**
+ * @brief Test that solveRoot rejects invalid brackets and methods.
+ *
+ */
+TEST(SolveRootFunctionTest, InvalidTest) {
+  SolverOptions options;
+  EXPECT_THROW(solveRoot(cubicFdf, nullptr, 5.0, 0.0), std::invalid_argument);
+  EXPECT_THROW(solveRoot(cubicFdf, nullptr, 3.0, 5.0), NoSolutionError);
+  options.method = RootMethod::Newton;
+  EXPECT_THROW(
+      solveRoot(cubicFdf, nullptr, 3.0, 5.0, options), NoSolutionError
+  );
+  ModelFunc fn = [](double x, void*) -> double { return x - 1.0; };
+  EXPECT_THROW(
+      solveRoot(fn, nullptr, 0.0, 5.0, options), std::invalid_argument
+  );
+}
+/**
+ * @brief Test that expandBracket returns the first interval when it holds the
+ * root and otherwise extends towards the root, returning only the last
+ * extension.
+ *
+ */
+TEST(ExpandBracketFunctionTest, OutputTest) {
+  int evaluations{0};
+  auto fn = [&](const double x) {
+    ++evaluations;
+    return x * x * x - 8.0;
+  };
+
+  const RootBracket near = expandBracket(fn, 1.95, 0.1, 0.0, 10.0);
+  EXPECT_DOUBLE_EQ(near.lower, 1.85);
+  EXPECT_DOUBLE_EQ(near.upper, 2.05);
+  EXPECT_EQ(evaluations, 2);
+
+  // Extensions of 0.2, 0.4 and 0.8 above 0.6 reach past the root.
+  evaluations = 0;
+  const RootBracket far = expandBracket(fn, 0.5, 0.1, 0.0, 10.0);
+  EXPECT_LE(far.lower, 2.0);
+  EXPECT_GE(far.upper, 2.0);
+  EXPECT_DOUBLE_EQ(far.lower, 1.2);
+  EXPECT_DOUBLE_EQ(far.upper, 2.0);
+  EXPECT_EQ(evaluations, 5);
+
+  // The first interval is clipped to the limits and the root is at a limit.
+  const RootBracket clipped = expandBracket(fn, 3.0, 0.5, 0.0, 2.0);
+  EXPECT_EQ(clipped.upper, 2.0);
+  EXPECT_LT(clipped.lower, clipped.upper);
+  const SolverResult result = solve(fn, clipped.lower, clipped.upper);
+  EXPECT_LE(abs(result.root - 2.0), 1e-3);
+}
+/**
+ * @brief Test that expandBracket rejects invalid limits and throws when the
+ * function does not change sign within them.
+ *
+ */
+TEST(ExpandBracketFunctionTest, InvalidTest) {
+  auto fn = [](const double x) { return x * x + 1.0; };
+  EXPECT_THROW(expandBracket(fn, 0.0, 0.1, -1.0, 1.0), NoSolutionError);
+  EXPECT_THROW(
+      expandBracket(fn, 0.0, 0.1, 1.0, -1.0), std::invalid_argument
+  );
+  EXPECT_THROW(expandBracket(fn, 0.0, 0.0, -1.0, 1.0), std::invalid_argument);
+  EXPECT_THROW(
+      expandBracket(fn, 0.0, 0.1, -1.0, 1.0, 1.0), std::invalid_argument
+  );
+  // The search reaches x < 0, where the logarithm is not finite.
+  EXPECT_THROW(
+      expandBracket(
+          [](const double x) { return std::log(x) - 1.0; }, 0.5, 0.1, -1.0, 1.0
+      ),
+      NoSolutionError
+  );
+}
+/**
+ * @brief Test that the callable entry points integrate, differentiate and
+ * solve capturing lambdas like the ModelFunc routines they wrap.
+ *
+ */
+TEST(CallableInterfaceTest, OutputTest) {
+  const double scale = 3.0;
+  auto cubic = [&](const double x) { return scale * x * x * x; };
+
+  EXPECT_LE(abs(integrate(cubic, 0.0, 2.0) - 12.0), 1e-9)
+      << "Integral produced by integrate is not equal to the expected value.";
+  EXPECT_LE(
+      abs(integrateUpper([&](const double x) { return scale * exp(-x); }, 1.0) -
+          scale * exp(-1.0)),
+      1e-9
+  ) << "Integral produced by integrateUpper is not equal to the expected "
+       "value.";
+  EXPECT_LE(abs(differentiate(cubic, 2.0) - 36.0), 1e-6)
+      << "Derivative produced by differentiate is not equal to the expected "
+         "value.";
+
+  const double target = 24.0;
+  const SolverResult brent =
+      solve([&](const double x) { return cubic(x) - target; }, 0.0, 5.0);
+  SolverOptions options;
+  options.method = RootMethod::Newton;
+  options.epsabs = 1e-12;
+  const SolverResult newton = solve(
+      [&](const double x, double& f, double& df) {
+        f = cubic(x) - target;
+        df = 3.0 * scale * x * x;
+      },
+      0.0,
+      5.0,
+      options
+  );
+  EXPECT_LE(abs(brent.root - 2.0), 1e-3)
+      << "Root produced by solve is not equal to the expected value.";
+  EXPECT_LE(abs(newton.root - 2.0), 1e-10)
+      << "Root produced by solve is not equal to the expected value.";
+}
+/**
+ * @test Tests that integrateBatch matches integrating every parameter value
+ * separately, across thread blocks and with a singular Gauss-Jacobi weight.
+ *
+ */
+TEST(IntegrateBatchFunctionTest, OutputTest) {
+  std::vector<double> xs(1000);
+  for (std::size_t i{0}; i < xs.size(); ++i) {
+    xs[i] = 0.01 * static_cast<double>(i);
+  }
+  std::vector<double> out(xs.size());
+  const GaussJacobiRule legendre(32, 0.0);
+  auto integrand = [](const double x, const double u) {
+    return exp(-x * u * u) * cos(u);
+  };
+  integrateBatch(integrand, xs, out, legendre, -1.0, 2.0);
+  for (std::size_t i{0}; i < xs.size(); i += 37) {
+    const double expected = integrate(
+        [&](const double u) { return integrand(xs[i], u); }, -1.0, 2.0
+    );
+    EXPECT_LE(abs(out[i] - expected), 1e-9)
+        << "Batch integral is not equal to the expected value at x = " << xs[i]
+        << ".";
+  }
+
+  // The integral of u^(-1/2) exp(-x u) over [0, 1] is sqrt(pi / x) erf(sqrt x).
+  const GaussJacobiRule jacobi(32, -0.5);
+  integrateBatch(
+      [](const double x, const double u) { return exp(-x * u); },
+      std::span<const double>(xs).subspan(1, 10),
+      std::span<double>(out).subspan(1, 10),
+      jacobi,
+      0.0,
+      1.0
+  );
+  for (std::size_t i{1}; i <= 10; ++i) {
+    const double expected = sqrt(std::numbers::pi / xs[i]) * erf(sqrt(xs[i]));
+    EXPECT_LE(abs(out[i] - expected), 1e-12)
+        << "Batch integral with a Jacobi weight is not equal to the expected "
+           "value.";
+  }
+  EXPECT_THROW(
+      integrateBatch(
+          integrand,
+          xs,
+          std::span<double>(out).first(10),
+          legendre,
+          0.0,
+          1.0
+      ),
+      std::invalid_argument
+  );
+}
+/**
+ * @test Tests that WorkStealingRanges hands out every index once, stealing
+ * from another worker once a worker's own range is exhausted, and that
+ * parallelForStealing visits every index.
+ *
+ */
+TEST(WorkStealingTest, OutputTest) {
+  WorkStealingRanges ranges(10, 2);
+  std::vector<int> claimed(10, 0);
+  std::size_t index{0};
+  // Worker 1 owns [5, 10) and then steals [2, 5) from worker 0.
+  for (int i{0}; i < 6; ++i) {
+    ASSERT_TRUE(ranges.next(1, index));
+    ++claimed[index];
+  }
+  EXPECT_EQ(index, 2U) << "The thief did not take the back half of a range.";
+  while (ranges.next(0, index)) {
+    ++claimed[index];
+  }
+  EXPECT_FALSE(ranges.next(1, index));
+  for (const int count : claimed) {
+    EXPECT_EQ(count, 1) << "An index was not handed out exactly once.";
+  }
+
+  std::vector<std::atomic<int>> visits(1000);
+  parallelForStealing(visits.size(), [&](const std::size_t i) {
+    visits[i].fetch_add(1);
+  });
+  for (const std::atomic<int>& count : visits) {
+    EXPECT_EQ(count.load(), 1);
+  }
+  EXPECT_THROW(WorkStealingRanges(10, 0), std::invalid_argument);
+}
 /**
  * @test Tests the output of the upperSolverBound function is near the expected
  * value.
@@ -0,0 +1,289 @@
+#include "stochastic_models/distributions/quasi_random.h"
+#include "stochastic_models/sde/ornstein_uhlenbeck.h"
+#include "stochastic_models/sde/variance_reduction.h"
+
+#include <cmath>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <vector>
+/**
+ * @test Tests the first points of the unshifted Sobol sequence against the
+ * values of the standard construction.
+ *
+ */
+TEST(SobolSequenceTest, FirstPointsTest) {
+  const SobolSequence sobol(2);
+  std::vector<double> point(2);
+  const double half_cell = 0.5 / 4294967296.0;
+  const double expected[4][2] = {
+      {0.0, 0.0}, {0.5, 0.5}, {0.75, 0.25}, {0.25, 0.75}
+  };
+
+  for (std::size_t index{0}; index < 4; ++index) {
+    sobol.uniforms(index, point);
+    for (std::size_t dim{0}; dim < 2; ++dim) {
+      EXPECT_LE(abs(point[dim] - expected[index][dim] - half_cell), 1e-15)
+          << "Sobol point " << index << " differs in dimension " << dim
+          << ".";
+    }
+  }
+}
+/**
+ * @test Tests that the first 2^k points of every dimension of a shifted
+ * Sobol sequence are equidistributed over the 2^k cells of the unit interval.
+ *
+ */
+TEST(SobolSequenceTest, StratificationTest) {
+  const std::size_t dimensions = SobolSequence::max_dimensions;
+  const std::size_t points = 1024;
+  const SobolSequence sobol(dimensions, 7);
+  std::vector<std::vector<unsigned int>> counts(
+      dimensions, std::vector<unsigned int>(points, 0)
+  );
+  std::vector<double> point(dimensions);
+
+  for (std::size_t index{0}; index < points; ++index) {
+    sobol.uniforms(index, point);
+    for (std::size_t dim{0}; dim < dimensions; ++dim) {
+      ++counts[dim][static_cast<std::size_t>(point[dim] * points)];
+    }
+  }
+  for (std::size_t dim{0}; dim < dimensions; ++dim) {
+    for (std::size_t cell{0}; cell < points; ++cell) {
+      EXPECT_EQ(counts[dim][cell], 1U)
+          << "Dimension " << dim << " does not place one point in cell "
+          << cell << ".";
+    }
+  }
+}
+/**
+ * @test Tests that invalid dimension counts are rejected.
+ *
+ */
+TEST(SobolSequenceTest, DimensionsTest) {
+  EXPECT_THROW(SobolSequence(0), std::invalid_argument);
+  EXPECT_THROW(
+      SobolSequence(SobolSequence::max_dimensions + 1), std::invalid_argument
+  );
+}
+/**
+ * @test Tests the inverse normal distribution function against known
+ * quantiles and its round trip through the distribution function.
+ *
+ */
+TEST(InverseStandardNormalCdfTest, QuantileTest) {
+  EXPECT_LE(abs(inverseStandardNormalCdf(0.5)), 1e-15)
+      << "Median of the standard normal is not zero.";
+  EXPECT_LE(abs(inverseStandardNormalCdf(0.975) - 1.959963984540054), 1e-13)
+      << "97.5% quantile of the standard normal is wrong.";
+  for (const double u : {1e-12, 1e-6, 0.01, 0.3, 0.7, 0.99, 1.0 - 1e-9}) {
+    const double x = inverseStandardNormalCdf(u);
+    const double roundtrip = 0.5 * std::erfc(-x / std::sqrt(2.0));
+    EXPECT_LE(abs(roundtrip - u) / std::min(u, 1.0 - u), 1e-9)
+        << "Quantile of " << u << " does not invert the distribution "
+        << "function.";
+  }
+}
+/**
+ * @test Tests that the Brownian bridge maps orthonormal inputs to orthonormal
+ * increments, so independent standard normals give independent standard
+ * normal increments.
+ *
+ */
+TEST(BrownianBridgeTest, IncrementCovarianceTest) {
+  for (const std::size_t steps : {1U, 2U, 5U, 8U, 13U, 64U}) {
+    const BrownianBridge bridge(steps);
+    // Column i holds the increments produced by the i-th unit input.
+    std::vector<std::vector<double>> columns(steps);
+    for (std::size_t i{0}; i < steps; ++i) {
+      std::vector<double> normals(steps, 0.0);
+      normals[i] = 1.0;
+      columns[i].resize(steps);
+      bridge.transform(normals, columns[i]);
+    }
+    for (std::size_t a{0}; a < steps; ++a) {
+      for (std::size_t b{0}; b < steps; ++b) {
+        double covariance{0.0};
+        for (std::size_t i{0}; i < steps; ++i) {
+          covariance += columns[i][a] * columns[i][b];
+        }
+        EXPECT_LE(abs(covariance - (a == b ? 1.0 : 0.0)), 1e-12)
+            << "Increment covariance (" << a << ", " << b
+            << ") is wrong for " << steps << " steps.";
+      }
+    }
+  }
+}
+/**
+ * @test Tests that the first bridge input fixes the terminal value of the
+ * path.
+ *
+ */
+TEST(BrownianBridgeTest, TerminalValueTest) {
+  const BrownianBridge bridge(16);
+  std::vector<double> normals(16, 0.0);
+  normals[0] = 0.25;
+  std::vector<double> increments(16);
+  bridge.transform(normals, increments);
+
+  double terminal{0.0};
+  for (const double& increment : increments) {
+    EXPECT_LE(abs(increment - 0.25 * 4.0 / 16.0), 1e-15)
+        << "Increments of the terminal value are not evenly spread.";
+    terminal += increment;
+  }
+  EXPECT_LE(abs(terminal - 1.0), 1e-14)
+      << "Terminal value is not sqrt(n) times the first input.";
+}
+/**
+ * @test Tests the control variate estimate for samples that are an exact
+ * linear function of the controls, whose mean is then recovered exactly.
+ *
+ */
+TEST(ControlVariateTest, LinearSamplesTest) {
+  const std::vector<double> controls = {0.3, -1.2, 0.8, 2.1, -0.4, 0.0};
+  std::vector<double> samples;
+  for (const double& control : controls) {
+    samples.push_back(2.0 + 3.0 * control);
+  }
+  const ControlVariateEstimate estimate =
+      controlVariateEstimate(samples, controls, 0.0);
+
+  EXPECT_LE(abs(estimate.beta - 3.0), 1e-12)
+      << "Control coefficient is not the slope of the samples.";
+  EXPECT_LE(abs(estimate.value - 2.0), 1e-12)
+      << "Estimate does not remove the control error.";
+  EXPECT_LE(estimate.standard_error, 1e-12)
+      << "Standard error of an exact fit is not zero.";
+  EXPECT_THROW(
+      controlVariateEstimate(samples, std::vector<double>(2), 0.0),
+      std::invalid_argument
+  );
+}
+/**
+ * @test Tests that antithetic paths of a linear model average exactly to the
+ * conditional mean at every step.
+ *
+ */
+TEST(OrnsteinUhlenbeckVarianceReductionTest, AntitheticMeanTest) {
+  const OrnsteinUhlenbeckModel model(0.5, 2.0, 0.3);
+  const std::size_t n_paths = 512;
+  const std::size_t n_steps = 20;
+  const double dt = 0.05;
+  const std::vector<double> paths = model.SimulatePaths(
+      1.0,
+      n_paths,
+      n_steps,
+      dt,
+      11,
+      DiscretizationScheme::Exact,
+      VarianceReduction::Antithetic
+  );
+
+  for (std::size_t step{0}; step < n_steps; ++step) {
+    double mean{0.0};
+    for (std::size_t p{0}; p < n_paths; ++p) {
+      mean += paths[step * n_paths + p];
+    }
+    mean /= n_paths;
+    EXPECT_LE(abs(mean - model.getConditionalMean(1.0, step * dt)), 1e-12)
+        << "Antithetic mean differs from the conditional mean at step "
+        << step << ".";
+  }
+}
+/**
+ * @test Tests that quasi-Monte Carlo paths have the exact terminal
+ * distribution and that their terminal mean estimate has a much smaller error
+ * across seeds than the pseudo-random estimate.
+ *
+ */
+TEST(OrnsteinUhlenbeckVarianceReductionTest, QuasiMonteCarloErrorTest) {
+  const OrnsteinUhlenbeckModel model(0.0, 1.0, 0.5);
+  const std::size_t n_paths = 1024;
+  const std::size_t n_steps = 33;
+  const double dt = 0.03125;
+  const double horizon = (n_steps - 1) * dt;
+  const double expected_mean = model.getConditionalMean(1.0, horizon);
+  const double expected_variance = model.getConditionalVariance(horizon);
+
+  double quasi_error{0.0};
+  double pseudo_error{0.0};
+  double quasi_variance{0.0};
+  const unsigned int seeds = 8;
+  for (unsigned int seed{0}; seed < seeds; ++seed) {
+    const std::vector<double> quasi = model.SimulatePaths(
+        1.0,
+        n_paths,
+        n_steps,
+        dt,
+        seed,
+        DiscretizationScheme::Exact,
+        VarianceReduction::QuasiMonteCarlo
+    );
+    const std::vector<double> pseudo = model.SimulatePaths(
+        1.0, n_paths, n_steps, dt, seed, DiscretizationScheme::Exact
+    );
+    double quasi_mean{0.0};
+    double pseudo_mean{0.0};
+    double quasi_square{0.0};
+    for (std::size_t p{0}; p < n_paths; ++p) {
+      const double quasi_value = quasi[(n_steps - 1) * n_paths + p];
+      quasi_mean += quasi_value;
+      quasi_square += (quasi_value - expected_mean) *
+                      (quasi_value - expected_mean);
+      pseudo_mean += pseudo[(n_steps - 1) * n_paths + p];
+    }
+    quasi_error += std::pow(quasi_mean / n_paths - expected_mean, 2);
+    pseudo_error += std::pow(pseudo_mean / n_paths - expected_mean, 2);
+    quasi_variance += quasi_square / n_paths;
+  }
+
+  EXPECT_LE(abs(quasi_variance / seeds - expected_variance), 0.01)
+      << "Quasi-Monte Carlo terminal variance is wrong.";
+  EXPECT_LE(quasi_error, pseudo_error / 10.0)
+      << "Quasi-Monte Carlo does not reduce the error of the terminal mean.";
+}
+/**
+ * @test Tests that the terminal value is an effective control variate for
+ * the running average of the path.
+ *
+ */
+TEST(OrnsteinUhlenbeckVarianceReductionTest, ControlVariateTest) {
+  const OrnsteinUhlenbeckModel model(0.0, 1.0, 0.5);
+  const std::size_t n_paths = 4096;
+  const std::size_t n_steps = 11;
+  const double dt = 0.1;
+  const std::vector<double> paths =
+      model.SimulatePaths(1.0, n_paths, n_steps, dt, 5);
+
+  std::vector<double> averages(n_paths, 0.0);
+  std::vector<double> terminals(n_paths);
+  double exact_average{0.0};
+  for (std::size_t step{1}; step < n_steps; ++step) {
+    exact_average += model.getConditionalMean(1.0, step * dt);
+    for (std::size_t p{0}; p < n_paths; ++p) {
+      averages[p] += paths[step * n_paths + p];
+    }
+  }
+  exact_average /= n_steps - 1;
+  double variance{0.0};
+  double mean{0.0};
+  for (std::size_t p{0}; p < n_paths; ++p) {
+    averages[p] /= n_steps - 1;
+    terminals[p] = paths[(n_steps - 1) * n_paths + p];
+    mean += averages[p];
+  }
+  mean /= n_paths;
+  for (const double& average : averages) {
+    variance += (average - mean) * (average - mean);
+  }
+  const double plain_error = std::sqrt(variance / (n_paths - 1) / n_paths);
+  const ControlVariateEstimate estimate = controlVariateEstimate(
+      averages, terminals, model.getConditionalMean(1.0, (n_steps - 1) * dt)
+  );
+
+  EXPECT_LE(estimate.standard_error, 0.75 * plain_error)
+      << "Control variate does not reduce the standard error.";
+  EXPECT_LE(abs(estimate.value - exact_average), 4 * estimate.standard_error)
+      << "Control variate estimate is inconsistent with the exact mean.";
+}